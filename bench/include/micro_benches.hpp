@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string_view>
+
+namespace sf {
+
+// runs every micro benchmark whose "micro/<name>" contains 'filter', empty runs all of them
+void run_micro_benches(std::string_view filter);
+
+} // sf
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <sf_allocators/general_purpose_allocator.hpp>
+#include <sf_containers/dynamic_array.hpp>
+#include <sf_core/defines.hpp>
+#include <string_view>
+
+namespace sf {
+
+enum struct TraceOpKind : u8 {
+    ALLOC,
+    FREE,
+    REALLOC
+};
+
+struct TraceOp {
+    u32         slot;
+    u32         size;
+    u16         alignment;
+    TraceOpKind kind;
+};
+
+// Recorded sequence of allocator calls, replayed against every allocator.
+// Slot is an index of a live block, so traces don't depend on returned addresses.
+struct Trace {
+    std::string_view                                        name;
+    DynamicArray<TraceOp, GeneralPurposeAllocator, false>   ops;
+    u32                                                     slot_count;
+    // bytes requested over the whole trace, sizes allocators which don't reuse freed memory
+    usize                                                   total_bytes;
+    usize                                                   peak_live_bytes;
+
+    explicit Trace(GeneralPurposeAllocator& gpa) noexcept
+        : ops(1024, &gpa)
+        , slot_count{ 0 }
+        , total_bytes{ 0 }
+        , peak_live_bytes{ 0 }
+    {}
+};
+
+// blocks of mixed sizes freed in reverse order, scratch memory pattern
+void make_lifo_trace(Trace& out_trace, u64 seed);
+// alloc/free of random slots, general heap pattern
+void make_random_free_trace(Trace& out_trace, u64 seed);
+// growing and occasionally shrinking buffers, dynamic array pattern
+void make_grow_shrink_trace(Trace& out_trace, u64 seed);
+// random slots with log-distributed sizes and alignments up to 256
+void make_mixed_trace(Trace& out_trace, u64 seed);
+
+} // sf
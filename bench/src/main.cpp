@@ -0,0 +1,275 @@
+#include "micro_benches.hpp"
+#include "traces.hpp"
+#include <sf_allocators/arena_allocator.hpp>
+#include <sf_allocators/frame_allocator.hpp>
+#include <sf_allocators/free_list_allocator.hpp>
+#include <sf_allocators/general_purpose_allocator.hpp>
+#include <sf_allocators/linear_allocator.hpp>
+#include <sf_allocators/stack_allocator.hpp>
+#include <sf_allocators/thread_cache_allocator.hpp>
+#include <sf_allocators/tlsf_allocator.hpp>
+#include <sf_containers/traits.hpp>
+#include <sf_core/clock.hpp>
+#include <sf_core/logger.hpp>
+#include <sf_core/memory_sf.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// Replays the same allocation traces against every AllocatorTrait implementation, then runs the micro benchmarks.
+// Usage: sf-alloc-bench [--reps N] [--warmup N] [--filter name] [--json path]
+namespace sf {
+
+struct BenchConfig {
+    u32              warmup_count{ 2 };
+    u32              repetition_count{ 10 };
+    // substring of "allocator/trace" or "micro/name", empty runs everything
+    std::string_view filter;
+    std::string_view json_path;
+};
+
+struct BenchResult {
+    std::string_view allocator_name;
+    std::string_view trace_name;
+    u32              op_count;
+    u32              failed_count;
+    // seconds per trace replay
+    f64              min;
+    f64              p50;
+    f64              p90;
+    f64              p99;
+    f64              max;
+    f64              mean;
+};
+
+struct BenchState {
+    BenchConfig                                                 config;
+    GeneralPurposeAllocator                                     gpa;
+    DynamicArray<BenchResult, GeneralPurposeAllocator, false>   results;
+    // live blocks of the replayed trace
+    void*                                                       slots[4096];
+    u32                                                         slot_sizes[4096];
+};
+
+template<AllocatorTrait Allocator>
+static u32 replay_trace(Allocator& alloc, const Trace& trace, BenchState& state) {
+    u32 failed_count{0};
+
+    for (const TraceOp& op : trace.ops) {
+        void*& block = state.slots[op.slot];
+        switch (op.kind) {
+            case TraceOpKind::ALLOC: {
+                block = alloc.allocate(op.size, op.alignment);
+                state.slot_sizes[op.slot] = op.size;
+                failed_count += block == nullptr;
+            } break;
+            case TraceOpKind::FREE: {
+                if (block) {
+                    alloc.free(block);
+                    block = nullptr;
+                }
+            } break;
+            case TraceOpKind::REALLOC: {
+                if (!block) {
+                    block = alloc.allocate(op.size, op.alignment);
+                    state.slot_sizes[op.slot] = op.size;
+                    failed_count += block == nullptr;
+                    break;
+                }
+                ReallocReturn realloc_res = alloc.reallocate(block, op.size, op.alignment);
+                if (!realloc_res.ptr) {
+                    ++failed_count;
+                    break;
+                }
+                // same as DynamicArray::grow, container copies the old content itself
+                if (realloc_res.should_mem_copy) {
+                    sf_mem_copy(realloc_res.ptr, block, std::min(state.slot_sizes[op.slot], op.size));
+                }
+                block = realloc_res.ptr;
+                state.slot_sizes[op.slot] = op.size;
+            } break;
+        }
+    }
+
+    return failed_count;
+}
+
+// nearest rank on sorted samples
+static f64 percentile(const DynamicArray<f64, GeneralPurposeAllocator, false>& sorted_samples, f64 percent) {
+    const u32 rank = static_cast<u32>(std::ceil(percent / 100.0 * sorted_samples.count()));
+    return sorted_samples[std::max(rank, 1u) - 1];
+}
+
+// 'with_allocator' creates fresh allocator for the trace and passes it to the replay callback
+template<typename WithAllocator>
+static void bench_allocator(std::string_view allocator_name, const Trace& trace, BenchState& state, WithAllocator&& with_allocator) {
+    const std::string full_name = std::format("{}/{}", allocator_name, trace.name);
+    if (!state.config.filter.empty() && full_name.find(state.config.filter) == std::string::npos) {
+        return;
+    }
+
+    DynamicArray<f64, GeneralPurposeAllocator, false> samples(state.config.repetition_count, &state.gpa);
+    Clock clock;
+    u32 failed_count{0};
+
+    for (u32 rep{0}; rep < state.config.warmup_count + state.config.repetition_count; ++rep) {
+        std::fill_n(state.slots, trace.slot_count, nullptr);
+        f64 elapsed{0.0};
+
+        with_allocator([&]<AllocatorTrait Allocator>(Allocator& alloc) {
+            clock.restart();
+            failed_count = replay_trace(alloc, trace, state);
+            elapsed = clock.update_and_get_delta();
+        });
+
+        if (rep >= state.config.warmup_count) {
+            samples.append(elapsed);
+        }
+    }
+
+    std::sort(samples.data(), samples.data() + samples.count());
+    f64 sum{0.0};
+    for (f64 sample : samples) {
+        sum += sample;
+    }
+
+    BenchResult result{
+        .allocator_name = allocator_name,
+        .trace_name = trace.name,
+        .op_count = trace.ops.count(),
+        .failed_count = failed_count,
+        .min = samples[0],
+        .p50 = percentile(samples, 50.0),
+        .p90 = percentile(samples, 90.0),
+        .p99 = percentile(samples, 99.0),
+        .max = samples[samples.count() - 1],
+        .mean = sum / samples.count(),
+    };
+    state.results.append(result);
+
+    LOG_TEST("{:<22} {:<12} p50 {:>10.3f} us  p90 {:>10.3f} us  p99 {:>10.3f} us  {:>8.2f} ns/op  failed {}",
+        allocator_name, trace.name, result.p50 * 1e6, result.p90 * 1e6, result.p99 * 1e6, result.p50 * 1e9 / result.op_count, failed_count);
+}
+
+static void bench_trace(const Trace& trace, BenchState& state) {
+    // allocators without own growth get capacity for the trace up front,
+    // resizable FreeList moves its buffer on growth, so it's only usable with handles and isn't measured
+    const usize fixed_capacity = trace.peak_live_bytes * 2 + trace.slot_count * 512;
+
+    bench_allocator("gpa", trace, state, [&](auto&& replay) {
+        GeneralPurposeAllocator alloc;
+        replay(alloc);
+    });
+    bench_allocator("arena", trace, state, [&](auto&& replay) {
+        ArenaAllocator alloc;
+        replay(alloc);
+    });
+    bench_allocator("arena_virtual", trace, state, [&](auto&& replay) {
+        ArenaAllocator alloc(trace.total_bytes * 2);
+        replay(alloc);
+    });
+    bench_allocator("stack", trace, state, [&](auto&& replay) {
+        StackAllocator alloc(64 * 1024);
+        replay(alloc);
+    });
+    bench_allocator("linear", trace, state, [&](auto&& replay) {
+        LinearAllocator alloc(64 * 1024);
+        replay(alloc);
+    });
+    bench_allocator("free_list", trace, state, [&](auto&& replay) {
+        FreeList<false> alloc(fixed_capacity);
+        replay(alloc);
+    });
+    bench_allocator("tlsf", trace, state, [&](auto&& replay) {
+        TLSFAllocator alloc(64 * 1024, true);
+        replay(alloc);
+    });
+    bench_allocator("frame", trace, state, [&](auto&& replay) {
+        FrameAllocator alloc(trace.total_bytes * 2);
+        replay(alloc);
+    });
+    bench_allocator("thread_cache", trace, state, [&](auto&& replay) {
+        ThreadCacheAllocator alloc;
+        replay(alloc);
+    });
+}
+
+static bool write_json(const BenchState& state) {
+    std::ofstream file(state.config.json_path.data(), std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << std::format("{{\n  \"warmup\": {},\n  \"repetitions\": {},\n  \"results\": [\n", state.config.warmup_count, state.config.repetition_count);
+    for (u32 i{0}; i < state.results.count(); ++i) {
+        const BenchResult& r = state.results[i];
+        file << std::format(
+            "    {{ \"allocator\": \"{}\", \"trace\": \"{}\", \"ops\": {}, \"failed\": {}, "
+            "\"seconds\": {{ \"min\": {:.9f}, \"p50\": {:.9f}, \"p90\": {:.9f}, \"p99\": {:.9f}, \"max\": {:.9f}, \"mean\": {:.9f} }}, "
+            "\"ns_per_op_p50\": {:.3f} }}{}\n",
+            r.allocator_name, r.trace_name, r.op_count, r.failed_count,
+            r.min, r.p50, r.p90, r.p99, r.max, r.mean,
+            r.p50 * 1e9 / r.op_count, i + 1 < state.results.count() ? "," : "");
+    }
+    file << "  ]\n}\n";
+    return true;
+}
+
+static bool parse_args(i32 argc, char** argv, BenchConfig& out_config) {
+    for (i32 i{1}; i < argc; ++i) {
+        const std::string_view arg{ argv[i] };
+        if (i + 1 >= argc) {
+            LOG_FATAL("Missing value for argument '{}'", arg);
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--reps") {
+            out_config.repetition_count = std::max(std::atoi(value), 1);
+        } else if (arg == "--warmup") {
+            out_config.warmup_count = std::max(std::atoi(value), 0);
+        } else if (arg == "--filter") {
+            out_config.filter = value;
+        } else if (arg == "--json") {
+            out_config.json_path = value;
+        } else {
+            LOG_FATAL("Unknown argument '{}'", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // sf
+
+int main(int argc, char** argv) {
+    using namespace sf;
+    constexpr u64 TRACE_SEED{ 0x5EED'1337'CAFE'F00D };
+
+    static BenchState state{};
+    state.results.set_allocator(&state.gpa);
+    state.results.reserve(64);
+    if (!parse_args(argc, argv, state.config)) {
+        return 1;
+    }
+
+    void (*const trace_makers[])(Trace&, u64) = {
+        make_lifo_trace, make_random_free_trace, make_grow_shrink_trace, make_mixed_trace
+    };
+    for (auto make_trace : trace_makers) {
+        Trace trace(state.gpa);
+        make_trace(trace, TRACE_SEED);
+        bench_trace(trace, state);
+    }
+    run_micro_benches(state.config.filter);
+
+    if (!state.config.json_path.empty() && !write_json(state)) {
+        LOG_FATAL("Failed to write results to '{}'", state.config.json_path);
+        return 1;
+    }
+    return 0;
+}
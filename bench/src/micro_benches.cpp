@@ -0,0 +1,346 @@
+#include "micro_benches.hpp"
+#include <sf_allocators/arena_allocator.hpp>
+#include <sf_allocators/free_list_allocator.hpp>
+#include <sf_allocators/general_purpose_allocator.hpp>
+#include <sf_allocators/tlsf_allocator.hpp>
+#include <sf_containers/dynamic_array.hpp>
+#include <sf_containers/fixed_array.hpp>
+#include <sf_containers/mpmc_queue.hpp>
+#include <sf_containers/spsc_queue.hpp>
+#include <sf_core/clock.hpp>
+#include <sf_core/hash.hpp>
+#include <sf_core/job_system.hpp>
+#include <sf_core/logger.hpp>
+#include <sf_core/memory_sf.hpp>
+#include <sf_core/parallel.hpp>
+#include <sf_core/utility.hpp>
+#include <sf_platform/platform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+// Timing-only runs of engine subsystems, they print numbers and don't check anything.
+namespace sf {
+
+// replays the same random allocate/free trace on TLSF and FreeList
+static void tlsf_vs_freelist_bench() {
+    constexpr u32 OPERATION_COUNT = 200'000;
+    constexpr u32 LIVE_SLOT_COUNT = 1024;
+    constexpr usize ARENA_SIZE = 64 * 1024 * 1024;
+
+    struct Op {
+        u32 slot;
+        u32 size;
+    };
+
+    GeneralPurposeAllocator gpa;
+    DynamicArray<Op, GeneralPurposeAllocator, false> trace(OPERATION_COUNT, &gpa);
+    srand(1337);
+    for (u32 i{0}; i < OPERATION_COUNT; ++i) {
+        // mostly small sizes with occasional big blocks, like a real frame
+        u32 size = (rand() % 8 == 0) ? 1024 + rand() % 16384 : 16 + rand() % 240;
+        trace.append({ static_cast<u32>(rand()) % LIVE_SLOT_COUNT, size });
+    }
+
+    Clock clock;
+
+    auto run = [&trace]<typename Allocator>(Allocator& alloc) -> u32 {
+        FixedArray<void*, LIVE_SLOT_COUNT> live(LIVE_SLOT_COUNT);
+        live.fill(nullptr);
+        u32 failed_count = 0;
+
+        for (const Op& op : trace) {
+            if (live[op.slot]) {
+                alloc.free(live[op.slot]);
+                live[op.slot] = nullptr;
+            } else {
+                live[op.slot] = alloc.allocate(op.size, 8);
+                failed_count += live[op.slot] == nullptr;
+            }
+        }
+        for (void* ptr : live) {
+            if (ptr) {
+                alloc.free(ptr);
+            }
+        }
+        return failed_count;
+    };
+
+    {
+        TLSFAllocator alloc(ARENA_SIZE, false);
+        clock.restart();
+        u32 failed_count = run(alloc);
+        auto time = clock.update_and_get_delta();
+        LOG_TEST("tlsf: {} ops in {}, failed allocations: {}", OPERATION_COUNT, time, failed_count);
+    }
+
+    {
+        FreeList<false> alloc(ARENA_SIZE);
+        clock.restart();
+        u32 failed_count = run(alloc);
+        auto time = clock.update_and_get_delta();
+        LOG_TEST("free list: {} ops in {}, failed allocations: {}", OPERATION_COUNT, time, failed_count);
+    }
+}
+
+// random reads over a buffer much bigger than TLB reach, huge pages need 512x fewer entries
+static void huge_page_bench() {
+    constexpr usize BUFFER_SIZE = 256 * 1024 * 1024;
+    constexpr u32 READ_COUNT = 4'000'000;
+
+    auto run = [](ArenaAllocator& alloc) -> u64 {
+        u64* data = static_cast<u64*>(alloc.allocate(BUFFER_SIZE, 64));
+        const usize element_count = BUFFER_SIZE / sizeof(u64);
+        for (usize i{0}; i < element_count; ++i) {
+            data[i] = i;
+        }
+
+        // dependent loads, so every access pays the full miss
+        u64 index = 0;
+        u64 sum = 0;
+        for (u32 i{0}; i < READ_COUNT; ++i) {
+            index = (data[index] * 6364136223846793005ULL + 1442695040888963407ULL) % element_count;
+            sum += index;
+        }
+        return sum;
+    };
+
+    Clock clock;
+    {
+        ArenaAllocator alloc(BUFFER_SIZE + get_mem_page_size() * ArenaAllocator::VIRTUAL_COMMIT_PAGES);
+        clock.restart();
+        u64 sum = run(alloc);
+        auto time = clock.update_and_get_delta();
+        LOG_TEST("regular pages: {} random reads in {} (checksum {})", READ_COUNT, time, sum);
+    }
+
+    {
+        ArenaAllocator alloc(BUFFER_SIZE + platform_get_huge_page_size(), true);
+        clock.restart();
+        u64 sum = run(alloc);
+        auto time = clock.update_and_get_delta();
+        LOG_TEST("huge pages: {} random reads in {} (checksum {})", READ_COUNT, time, sum);
+    }
+}
+
+static u64 hash_fnv1a(const char* data, usize len) {
+    u64 hash = 14695981039346656037ull;
+    for (usize i{0}; i < len; ++i) {
+        hash ^= static_cast<u8>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static void hash_bench() {
+    constexpr u32 KEY_COUNT = 1'000'000;
+    constexpr usize PATH_LEN = 48;
+    constexpr usize BLOCK_SIZE = 64 * 1024;
+
+    GeneralPurposeAllocator gpa;
+    char* block = static_cast<char*>(gpa.allocate(BLOCK_SIZE, 16));
+    for (usize i{0}; i < BLOCK_SIZE; ++i) {
+        block[i] = static_cast<char>(i * 31 + 7);
+    }
+
+    Clock clock;
+    // checksum keeps the loops from being optimized out
+    u64 sum{0};
+
+    auto report = [&](std::string_view name, usize byte_count) {
+        const f64 time = clock.update_and_get_delta();
+        LOG_TEST("{}: {} GB/s (checksum {})", name, byte_count / time / 1e9, sum);
+        sum = 0;
+        clock.restart();
+    };
+
+    clock.restart();
+    for (u64 i{0}; i < KEY_COUNT; ++i) {
+        sum += hash_fnv1a(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+    report("fnv1a u64 keys", KEY_COUNT * sizeof(u64));
+    for (u64 i{0}; i < KEY_COUNT; ++i) {
+        sum += hash_u64(i);
+    }
+    report("hash_u64 u64 keys", KEY_COUNT * sizeof(u64));
+
+    // asset path sized strings
+    for (u32 i{0}; i < KEY_COUNT; ++i) {
+        sum += hash_fnv1a(block + (i * 97) % (BLOCK_SIZE - PATH_LEN), PATH_LEN);
+    }
+    report("fnv1a 48 byte strings", KEY_COUNT * PATH_LEN);
+    for (u32 i{0}; i < KEY_COUNT; ++i) {
+        sum += hash_bytes(block + (i * 97) % (BLOCK_SIZE - PATH_LEN), PATH_LEN);
+    }
+    report("hash_bytes 48 byte strings", KEY_COUNT * PATH_LEN);
+
+    constexpr u32 BLOCK_REPEAT = 1000;
+    for (u32 i{0}; i < BLOCK_REPEAT; ++i) {
+        sum += hash_fnv1a(block, BLOCK_SIZE - i);
+    }
+    report("fnv1a 64 KiB blocks", BLOCK_REPEAT * BLOCK_SIZE);
+    for (u32 i{0}; i < BLOCK_REPEAT; ++i) {
+        sum += hash_bytes(block, BLOCK_SIZE - i);
+    }
+    report("hash_bytes 64 KiB blocks", BLOCK_REPEAT * BLOCK_SIZE);
+
+    gpa.free(block);
+}
+
+static void queue_bench() {
+    constexpr u64 ITEM_COUNT{ 4'000'000 };
+    constexpr u32 BATCH_SIZE{ 32 };
+    GeneralPurposeAllocator gpa;
+    Clock clock;
+
+    auto report = [&clock](std::string_view name, u32 producer_count, u32 consumer_count) {
+        const f64 time = clock.update_and_get_delta();
+        LOG_TEST("{} {}P/{}C: {} M items/s", name, producer_count, consumer_count, ITEM_COUNT / time / 1e6);
+    };
+
+    {
+        SpscQueue<u64, GeneralPurposeAllocator> queue(4096, &gpa);
+        clock.restart();
+        std::thread consumer([&queue] {
+            u64 batch[BATCH_SIZE];
+            u64 received{0};
+            while (received < ITEM_COUNT) {
+                const u32 popped = queue.pop_batch(batch);
+                received += popped;
+                if (popped == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        u64 batch[BATCH_SIZE]{};
+        for (u64 sent{0}; sent < ITEM_COUNT;) {
+            const u32 pushed = queue.push_batch({ batch, static_cast<usize>(std::min<u64>(BATCH_SIZE, ITEM_COUNT - sent)) });
+            sent += pushed;
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+        }
+        consumer.join();
+        report("SpscQueue batch", 1, 1);
+    }
+
+    constexpr u32 THREAD_COUNTS[]{ 1, 2, 4 };
+    // producer and consumer per count
+    std::thread threads[8];
+    for (u32 thread_count : THREAD_COUNTS) {
+        for (u32 batch_size : { 1u, BATCH_SIZE }) {
+            MpmcQueue<u64, GeneralPurposeAllocator> queue(4096, &gpa);
+            const u64 items_per_producer = ITEM_COUNT / thread_count;
+            std::atomic<u64> received{0};
+
+            clock.restart();
+            for (u32 t{0}; t < thread_count; ++t) {
+                threads[t * 2] = std::thread([&queue, items_per_producer, batch_size] {
+                    u64 batch[BATCH_SIZE]{};
+                    for (u64 sent{0}; sent < items_per_producer;) {
+                        const u32 pushed = queue.push_batch({ batch, static_cast<usize>(std::min<u64>(batch_size, items_per_producer - sent)) });
+                        sent += pushed;
+                        if (pushed == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+                threads[t * 2 + 1] = std::thread([&queue, &received, items_per_producer, thread_count, batch_size] {
+                    u64 batch[BATCH_SIZE];
+                    while (received.load(std::memory_order_relaxed) < items_per_producer * thread_count) {
+                        const u32 popped = queue.pop_batch({ batch, batch_size });
+                        received.fetch_add(popped, std::memory_order_relaxed);
+                        if (popped == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+            for (u32 t{0}; t < thread_count * 2; ++t) {
+                threads[t].join();
+            }
+            report(batch_size == 1 ? "MpmcQueue single" : "MpmcQueue batch", thread_count, thread_count);
+        }
+    }
+}
+
+// every algorithm with 1 worker, then doubled up to one worker per core
+static void parallel_bench() {
+    constexpr u32 COUNT{ 4'000'000 };
+    GeneralPurposeAllocator gpa;
+    DynamicArray<u64, GeneralPurposeAllocator, false> source(COUNT, &gpa);
+    DynamicArray<u64, GeneralPurposeAllocator, false> items(COUNT, &gpa);
+    DynamicArray<u64, GeneralPurposeAllocator, false> scratch(COUNT, &gpa);
+    source.resize(COUNT);
+    items.resize(COUNT);
+    scratch.resize(COUNT);
+    u64 seed{ 0x9E3779B97F4A7C15ULL };
+    for (u64& value : source) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        value = seed;
+    }
+
+    const u32 core_count = std::max(std::thread::hardware_concurrency(), 1u);
+    Clock clock;
+    for (u32 worker_count{1};; worker_count = std::min(worker_count * 2, core_count)) {
+        JobSystem system;
+        JobSystem::create(gpa, worker_count, system);
+
+        clock.restart();
+        parallel_for(system, COUNT, [&](u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) {
+                items[i] = source[i] * 31 + (source[i] >> 7);
+            }
+        });
+        const f64 for_time = clock.update_and_get_delta();
+
+        const u64 sum = parallel_reduce(system, items.to_span(), 0ULL, [](u64 item) { return item & 0xFFFF; }, [](u64 lhs, u64 rhs) { return lhs + rhs; });
+        const f64 reduce_time = clock.update_and_get_delta();
+
+        parallel_inclusive_scan<u64>(system, items.to_span(), items.to_span());
+        const f64 scan_time = clock.update_and_get_delta();
+
+        sf_mem_copy(items.data(), source.data(), COUNT * sizeof(u64));
+        clock.restart();
+        parallel_radix_sort(system, items.to_span(), scratch.to_span());
+        const f64 radix_time = clock.update_and_get_delta();
+
+        sf_mem_copy(items.data(), source.data(), COUNT * sizeof(u64));
+        clock.restart();
+        parallel_merge_sort(system, items.to_span(), scratch.to_span());
+        const f64 merge_time = clock.update_and_get_delta();
+
+        LOG_TEST("parallel {} workers, {} items: for {}, reduce {} (checksum {}), scan {}, radix sort {}, merge sort {}",
+            worker_count, COUNT, for_time, reduce_time, sum, scan_time, radix_time, merge_time);
+        if (worker_count == core_count) {
+            break;
+        }
+    }
+}
+
+void run_micro_benches(std::string_view filter) {
+    struct MicroBench {
+        std::string_view name;
+        void           (*fn)();
+    };
+    constexpr MicroBench benches[]{
+        { "micro/tlsf_vs_freelist", tlsf_vs_freelist_bench },
+        { "micro/huge_pages", huge_page_bench },
+        { "micro/hash", hash_bench },
+        { "micro/queue", queue_bench },
+        { "micro/parallel", parallel_bench },
+    };
+
+    for (const MicroBench& bench : benches) {
+        if (!filter.empty() && bench.name.find(filter) == std::string_view::npos) {
+            continue;
+        }
+        LOG_TEST("{}", bench.name);
+        bench.fn();
+    }
+}
+
+} // sf
@@ -0,0 +1,168 @@
+#include "traces.hpp"
+#include <sf_containers/fixed_array.hpp>
+#include <algorithm>
+
+namespace sf {
+
+static constexpr u32 MAX_SLOT_COUNT{ 4096 };
+
+// xorshift, traces must be the same on every platform and run
+struct BenchRandom {
+    u64 state;
+
+    u64 next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // [min, max]
+    u32 range(u32 min, u32 max) {
+        return min + static_cast<u32>(next() % (static_cast<u64>(max) - min + 1));
+    }
+};
+
+// keeps live sizes of slots, so trace totals are known without replaying it
+struct TraceBuilder {
+    Trace&                          trace;
+    FixedArray<u32, MAX_SLOT_COUNT> slot_sizes;
+    usize                           live_bytes;
+
+    TraceBuilder(Trace& trace_in, u32 slot_count)
+        : trace{ trace_in }
+        , slot_sizes(slot_count)
+        , live_bytes{ 0 }
+    {
+        trace.slot_count = slot_count;
+        slot_sizes.fill(0);
+    }
+
+    bool is_live(u32 slot) const {
+        return slot_sizes[slot] != 0;
+    }
+
+    void alloc(u32 slot, u32 size, u16 alignment) {
+        trace.ops.append({ slot, size, alignment, TraceOpKind::ALLOC });
+        slot_sizes[slot] = size;
+        on_new_bytes(size, alignment);
+    }
+
+    void realloc(u32 slot, u32 size, u16 alignment) {
+        trace.ops.append({ slot, size, alignment, TraceOpKind::REALLOC });
+        live_bytes -= slot_sizes[slot];
+        slot_sizes[slot] = size;
+        on_new_bytes(size, alignment);
+    }
+
+    void free(u32 slot) {
+        trace.ops.append({ slot, 0, 0, TraceOpKind::FREE });
+        live_bytes -= slot_sizes[slot];
+        slot_sizes[slot] = 0;
+    }
+
+    void free_all() {
+        for (u32 slot{0}; slot < slot_sizes.count(); ++slot) {
+            if (is_live(slot)) {
+                free(slot);
+            }
+        }
+    }
+
+private:
+    void on_new_bytes(u32 size, u16 alignment) {
+        trace.total_bytes += size + alignment;
+        live_bytes += size;
+        trace.peak_live_bytes = std::max(trace.peak_live_bytes, live_bytes);
+    }
+};
+
+void make_lifo_trace(Trace& out_trace, u64 seed) {
+    constexpr u32 ROUND_COUNT{ 256 };
+    constexpr u32 DEPTH{ 256 };
+
+    out_trace.name = "lifo";
+    BenchRandom random{ seed };
+    TraceBuilder builder(out_trace, DEPTH);
+
+    for (u32 round{0}; round < ROUND_COUNT; ++round) {
+        const u32 depth = random.range(DEPTH / 4, DEPTH);
+        for (u32 slot{0}; slot < depth; ++slot) {
+            builder.alloc(slot, random.range(16, 1024), 8);
+        }
+        for (u32 slot = depth; slot > 0; --slot) {
+            builder.free(slot - 1);
+        }
+    }
+}
+
+void make_random_free_trace(Trace& out_trace, u64 seed) {
+    constexpr u32 OPERATION_COUNT{ 100'000 };
+    constexpr u32 SLOT_COUNT{ 1024 };
+
+    out_trace.name = "random_free";
+    BenchRandom random{ seed };
+    TraceBuilder builder(out_trace, SLOT_COUNT);
+
+    for (u32 i{0}; i < OPERATION_COUNT; ++i) {
+        const u32 slot = random.range(0, SLOT_COUNT - 1);
+        if (builder.is_live(slot)) {
+            builder.free(slot);
+        } else {
+            // mostly small sizes with occasional big blocks
+            const u32 size = random.range(0, 7) == 0 ? random.range(1024, 16 * 1024) : random.range(16, 256);
+            builder.alloc(slot, size, 8);
+        }
+    }
+    builder.free_all();
+}
+
+void make_grow_shrink_trace(Trace& out_trace, u64 seed) {
+    constexpr u32 OPERATION_COUNT{ 2000 };
+    constexpr u32 SLOT_COUNT{ 16 };
+    constexpr u32 MIN_SIZE{ 64 };
+    constexpr u32 MAX_SIZE{ 64 * 1024 };
+
+    out_trace.name = "grow_shrink";
+    BenchRandom random{ seed };
+    TraceBuilder builder(out_trace, SLOT_COUNT);
+
+    for (u32 i{0}; i < OPERATION_COUNT; ++i) {
+        const u32 slot = random.range(0, SLOT_COUNT - 1);
+        const u32 size = builder.slot_sizes[slot];
+        if (size == 0) {
+            builder.alloc(slot, MIN_SIZE, 8);
+        } else if (size >= MAX_SIZE) {
+            builder.free(slot);
+        } else if (random.range(0, 7) == 0) {
+            builder.realloc(slot, std::max(size / 2, MIN_SIZE), 8);
+        } else {
+            builder.realloc(slot, std::min(size * 2, MAX_SIZE), 8);
+        }
+    }
+    builder.free_all();
+}
+
+void make_mixed_trace(Trace& out_trace, u64 seed) {
+    constexpr u32 OPERATION_COUNT{ 50'000 };
+    constexpr u32 SLOT_COUNT{ 512 };
+
+    out_trace.name = "mixed";
+    BenchRandom random{ seed };
+    TraceBuilder builder(out_trace, SLOT_COUNT);
+
+    for (u32 i{0}; i < OPERATION_COUNT; ++i) {
+        const u32 slot = random.range(0, SLOT_COUNT - 1);
+        if (builder.is_live(slot)) {
+            builder.free(slot);
+        } else {
+            const u32 exponent = random.range(3, 15);
+            const u32 size = (1u << exponent) + random.range(0, (1u << exponent) - 1);
+            const u16 alignment = static_cast<u16>(8u << random.range(0, 5));
+            builder.alloc(slot, size, alignment);
+        }
+    }
+    builder.free_all();
+}
+
+} // sf
@@ -59,6 +59,14 @@ for arg in "$@"; do
     echo "Building tests..."
     CMAKE_OPTS+=" -DSF_BUILD_TESTS=1"
     ;;
+  -b | --bench)
+    echo "Building allocator benchmarks..."
+    CMAKE_OPTS+=" -DSF_BUILD_BENCH=1"
+    ;;
+  -mt | --mem_tracking)
+    echo "Memory tracking enabled"
+    CMAKE_OPTS+=" -DSF_BUILD_MEMORY_TRACKING=1"
+    ;;
   --gcc)
     echo "Using gcc compiler"
     COMPILER="g++"
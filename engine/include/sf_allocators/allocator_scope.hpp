@@ -0,0 +1,29 @@
+#pragma once
+
+namespace sf {
+
+// RAII marker: remembers allocator state on construction and rewinds to it on destruction,
+// so everything allocated inside of the scope is freed in bulk.
+// Works with allocators which provide 'make_snapshot' and 'rewind' (Stack, Linear, Arena).
+template<typename Allocator>
+struct AllocatorScope {
+private:
+    Allocator&                      _allocator;
+    typename Allocator::Snapshot    _snapshot;
+
+public:
+    explicit AllocatorScope(Allocator& allocator) noexcept
+        : _allocator{ allocator }
+        , _snapshot{ allocator.make_snapshot() }
+    {}
+
+    AllocatorScope(const AllocatorScope& rhs) = delete;
+    AllocatorScope& operator=(const AllocatorScope& rhs) = delete;
+
+    ~AllocatorScope() noexcept
+    {
+        _allocator.rewind(_snapshot);
+    }
+};
+
+} // sf
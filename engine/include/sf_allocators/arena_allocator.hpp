@@ -3,6 +3,7 @@
 #include "sf_allocators/general_purpose_allocator.hpp"
 #include "sf_containers/traits.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
 #include "sf_containers/dynamic_array.hpp"
 
 namespace sf {
@@ -17,6 +18,7 @@ public:
     static constexpr u32 DEFAULT_ALIGNMENT{sizeof(usize)};
     static constexpr u32 DEFAULT_REGIONS_INIT_CAPACITY{10};
     static constexpr u32 DEFAULT_REGION_CAPACITY_PAGES{4};
+    static constexpr u32 VIRTUAL_COMMIT_PAGES{16};
 
     struct Snapshot {
         u32 region_offset;
@@ -31,8 +33,17 @@ public:
     };
 private:
     DynamicArray<Region, GeneralPurposeAllocator, false> regions;
+    // virtual backend: regions[0] covers reserved address range, pages are committed on demand
+    u8*   virtual_base;
+    usize virtual_committed;
+    MemoryTag tag;
+    // reserved range and heap regions are backed by huge pages
+    bool      huge_pages;
 public:
     ArenaAllocator();
+    // reserves 'reserve_size' bytes of address space up front, all allocations inside it are pointer bumps
+    // 'use_huge_pages' suits big randomly accessed pools, commit granularity becomes the huge page size
+    explicit ArenaAllocator(usize reserve_size, bool use_huge_pages = false);
     ~ArenaAllocator();
     void* allocate(usize size, u16 alignment);
     usize allocate_handle(usize size, u16 alignment);
@@ -46,6 +57,13 @@ public:
     void  clear();
     void  rewind(Snapshot snapshot);
     Snapshot make_snapshot() const;
+    constexpr bool is_virtual() const { return virtual_base != nullptr; }
+    constexpr bool uses_huge_pages() const { return huge_pages; }
+    constexpr usize committed_size() const { return virtual_committed; }
+    // bytes in use summed over all regions, including padding and headers
+    usize used_size() const;
+    constexpr MemoryTag memory_tag() const { return tag; }
+    void set_memory_tag(MemoryTag tag) { this->tag = tag; }
 private:
     struct FindSufficcientRegionReturn {
         Region* region;
@@ -55,6 +73,13 @@ private:
     Region* find_region_for_addr(void* addr);
     void init_new_region(Region* region, usize alloc_size);
     void free_inside_region(void* addr, Region* region);
+    usize commit_granularity() const;
+    usize align_to_commit_granularity(usize size) const;
+    // rounds 'inout_size' up to the size actually allocated
+    u8*  alloc_region_memory(usize& inout_size);
+    void free_region_memory(u8* data, usize size);
+    bool virtual_commit(usize end_offset);
+    void virtual_decommit(usize keep_offset);
 };
 
 } // sf
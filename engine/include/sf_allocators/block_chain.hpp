@@ -0,0 +1,52 @@
+#pragma once
+
+#include "sf_core/defines.hpp"
+
+namespace sf {
+
+// Chain of memory blocks which grows without moving memory.
+// Block i has capacity 'first_capacity << i', all blocks together form one contiguous logical range,
+// so logical offset -> block lookup is O(1) and blocks are allocated only when an allocation lands in them.
+// Used by Stack and Linear allocators, their counts and handles are logical offsets.
+// Blocks are kept until destruction, so the chain is reused after clear.
+struct BlockChain {
+public:
+    static constexpr u32 MAX_BLOCK_COUNT{ 40 };
+
+    struct Placement {
+        // logical offset where the allocation starts, it's bigger than requested one if allocation jumped to the next block
+        usize offset;
+        usize padding;
+    };
+private:
+    u8*   _blocks[MAX_BLOCK_COUNT];
+    usize _first_capacity;
+    // bytes in allocated blocks
+    usize _capacity;
+
+public:
+    explicit BlockChain(usize first_capacity) noexcept;
+    BlockChain(BlockChain&& rhs) noexcept;
+    BlockChain& operator=(BlockChain&& rhs) noexcept;
+    ~BlockChain() noexcept;
+
+    // finds first offset starting from 'offset', where 'size' bytes with padding and header fit into one block
+    // returns offset == INVALID_ALLOC_HANDLE when chain is exhausted
+    Placement place(usize offset, usize size, u16 alignment, u16 header_size) noexcept;
+    u8* offset_to_ptr(usize offset) const noexcept;
+    // returns INVALID_ALLOC_HANDLE for pointers outside of the chain
+    usize ptr_to_offset(const void* ptr) const noexcept;
+    bool owns(const void* ptr) const noexcept;
+
+    constexpr usize capacity() const noexcept { return _capacity; }
+    constexpr usize first_capacity() const noexcept { return _first_capacity; }
+    constexpr usize block_start(u32 index) const noexcept { return _first_capacity * ((static_cast<usize>(1) << index) - 1); }
+    constexpr usize block_capacity(u32 index) const noexcept { return _first_capacity << index; }
+    u32 block_index(usize offset) const noexcept;
+    u32 block_count() const noexcept;
+
+private:
+    void release() noexcept;
+};
+
+} // sf
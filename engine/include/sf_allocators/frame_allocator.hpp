@@ -0,0 +1,73 @@
+#pragma once
+
+#include "sf_containers/traits.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
+
+namespace sf {
+
+// Per-frame scratch memory: one linear region for every frame in flight.
+// Allocation is a pointer bump inside of the current region, 'end_frame' switches to the next region and resets it,
+// so data allocated during the frame stays valid until the same region comes around again.
+// Regions are carved from a single reserved address range and never move,
+// handle is the offset from the beginning of that range, so it's valid for every region.
+struct FrameAllocator {
+public:
+    static constexpr u32 FRAME_COUNT{ 2 };
+    static constexpr usize DEFAULT_FRAME_CAPACITY{ 64 * 1024 * 1024 };
+    static constexpr u16 DEFAULT_ALIGNMENT{ sizeof(usize) };
+    static constexpr u32 COMMIT_PAGES{ 16 };
+
+    struct Region {
+        u8*   data;
+        usize offset;
+        usize committed;
+        // highest offset reached since creation
+        usize peak_offset;
+        // offset of the last allocation, it can be resized in place
+        usize last_offset;
+    };
+private:
+    u8*       _base;
+    usize     _frame_capacity;
+    Region    _regions[FRAME_COUNT];
+    u32       _curr_frame;
+    bool      _is_virtual;
+    MemoryTag _tag;
+
+public:
+    FrameAllocator() noexcept;
+    // 'frame_capacity' is the upper bound for one frame, only touched pages are committed
+    explicit FrameAllocator(usize frame_capacity) noexcept;
+    FrameAllocator(FrameAllocator&& rhs) noexcept = delete;
+    FrameAllocator& operator=(FrameAllocator&& rhs) noexcept = delete;
+    ~FrameAllocator() noexcept;
+
+    void* allocate(usize size, u16 alignment) noexcept;
+    usize allocate_handle(usize size, u16 alignment) noexcept;
+    ReallocReturn reallocate(void* addr, usize new_size, u16 alignment) noexcept;
+    ReallocReturnHandle reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept;
+    void* handle_to_ptr(usize handle) const noexcept;
+    usize ptr_to_handle(void* ptr) const noexcept;
+    // memory is given back in bulk by 'end_frame'
+    void free(void* addr) noexcept {}
+    void free_handle(usize handle) noexcept {}
+    // resets only the current region
+    void clear() noexcept;
+
+    // switches to the region of the next frame and resets it
+    void end_frame() noexcept;
+
+    constexpr u32 frame_index() const noexcept { return _curr_frame; }
+    constexpr usize frame_capacity() const noexcept { return _frame_capacity; }
+    constexpr usize count() const noexcept { return _regions[_curr_frame].offset; }
+    constexpr usize peak_count() const noexcept { return _regions[_curr_frame].peak_offset; }
+    constexpr bool is_virtual() const noexcept { return _is_virtual; }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
+
+private:
+    bool commit(Region& region, usize end_offset) noexcept;
+};
+
+} // sf
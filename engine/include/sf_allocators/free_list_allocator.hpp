@@ -4,6 +4,7 @@
 #include "sf_core/constants.hpp"
 #include "sf_core/logger.hpp"
 #include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
 
 namespace sf {
 
@@ -24,6 +25,9 @@ private:
     u8*           _buffer;
     FreeListNode* _head;
     usize         _capacity;
+    // bytes handed out, including padding and headers
+    usize         _used;
+    MemoryTag     _tag;
 
 public:
     static constexpr usize MIN_ALLOC_SIZE = sizeof(FreeListNode);
@@ -47,6 +51,9 @@ public:
     void resize(usize new_capacity) noexcept;
     constexpr u8* begin() noexcept { return _buffer; }
     constexpr usize total_size() noexcept { return _capacity; };
+    constexpr usize used_size() const noexcept { return _used; }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
 };
 
 template<bool RESIZABLE>
@@ -55,6 +62,8 @@ FreeList<RESIZABLE>
     : _buffer{ static_cast<u8*>(sf_mem_alloc(capacity)) }
     , _head{ reinterpret_cast<FreeListNode*>(_buffer) }
     , _capacity{ capacity }
+    , _used{ 0 }
+    , _tag{ MemoryTag::UNKNOWN }
 {
     clear();
 }
@@ -77,6 +86,8 @@ void* FreeList<RESIZABLE>::allocate(usize size, u16 alignment) noexcept {
     if (alignment < sizeof(usize)) {
         alignment = sizeof(usize);
     }
+    // keeps the node placed after the block aligned
+    size = (size + sizeof(usize) - 1) & ~(sizeof(usize) - 1);
 
     FreeListNode* curr = _head;
     FreeListNode* prev = nullptr;
@@ -119,6 +130,8 @@ void* FreeList<RESIZABLE>::allocate(usize size, u16 alignment) noexcept {
     FreeListAllocHeader* alloc_header = reinterpret_cast<FreeListAllocHeader*>(ptr_step_bytes_forward(curr, padding_to_alloc_header));
     alloc_header->size = size;
     alloc_header->padding = padding;
+    _used += required_space;
+    memory_track_alloc(_tag, required_space);
 
     return alloc_header + 1;
 }
@@ -135,10 +148,13 @@ ReallocReturn FreeList<RESIZABLE>::reallocate(void* addr, usize new_size, u16 al
         return {nullptr, false};
     }
 
+    // allocate can resize the buffer, old block is found again by its offset
+    const u32 old_handle = turn_ptr_into_handle(addr, _buffer);
     void* res = allocate(new_size, alignment);
+    addr = turn_handle_into_ptr(old_handle, _buffer);
     FreeListAllocHeader* header_ptr = static_cast<FreeListAllocHeader*>(ptr_step_bytes_backward(addr, sizeof(FreeListAllocHeader)));
     // copy old memory to the new chunk
-    sf_mem_copy(res, addr, header_ptr->size);
+    sf_mem_copy(res, addr, header_ptr->size < new_size ? header_ptr->size : new_size);
     free(addr);
     return {res, false};
 }
@@ -165,6 +181,8 @@ void FreeList<RESIZABLE>::free(void* block) noexcept {
 
     free_node->size = header_ptr->padding + header_ptr->size;
     free_node->next = nullptr;
+    _used -= free_node->size;
+    memory_track_free(_tag, free_node->size);
 
     FreeListNode* curr = _head;
     FreeListNode* prev = nullptr;
@@ -179,6 +197,11 @@ void FreeList<RESIZABLE>::free(void* block) noexcept {
         curr = curr->next;
     }
 
+    // block is past every free node
+    if (!curr) {
+        insert_node(prev, free_node);
+    }
+
     coallescense_nodes(prev, free_node);
 }
 
@@ -190,6 +213,9 @@ void FreeList<RESIZABLE>::free_handle(usize handle) noexcept {
 
 template<bool RESIZABLE>
 void FreeList<RESIZABLE>::clear() noexcept {
+    memory_track_free(_tag, _used);
+    _used = 0;
+
     FreeListNode* first_node = reinterpret_cast<FreeListNode*>(_buffer);
     first_node->size = _capacity;
     first_node->next = 0;
@@ -198,53 +224,47 @@ void FreeList<RESIZABLE>::clear() noexcept {
 
 template<bool RESIZABLE>
 void FreeList<RESIZABLE>::resize(usize new_capacity) noexcept {
-    u8* new_buffer = static_cast<u8*>(sf_mem_realloc(_buffer, new_capacity));
+    // old buffer is walked while relinking, so it's freed only at the end
+    u8* new_buffer = static_cast<u8*>(sf_mem_alloc(new_capacity));
+    sf_mem_copy(new_buffer, _buffer, _capacity);
 
     // append node at the back
     FreeListNode* free_node = reinterpret_cast<FreeListNode*>(new_buffer + _capacity);
     free_node->size = new_capacity - _capacity;
     free_node->next = nullptr;
 
-    FreeListNode* last_node;
+    FreeListNode* last_node = nullptr;
     FreeListNode* prev = nullptr;
+    FreeListNode* old_head = _head;
 
-    if (new_buffer != _buffer) {
-        FreeListNode* old_head = _head;
+    if (old_head) {
+        _head = rebase_ptr<FreeListNode*>(old_head, _buffer, new_buffer);
+    }
 
-        if (old_head) {
-            _head = rebase_ptr<FreeListNode*>(old_head, _buffer, new_buffer);
-        }
+    // 1) revalidate pointers
+    // 2) find last available node, which is closer to the back
+    FreeListNode* old_curr = old_head;
+    FreeListNode* new_curr = _head;
 
-        // 1) revalidate pointers
-        // 2) find last available node, which is closer to the back
-        FreeListNode* old_curr = old_head;
-        FreeListNode* new_curr = _head;
-
-        while (old_curr && new_curr) {
-            if (old_curr->next) {
-                FreeListNode* new_next_ptr = rebase_ptr<FreeListNode*>(old_curr->next, _buffer, new_buffer);
-                new_curr->next = new_next_ptr;
-            } else {
-                // last available node
-                last_node = new_curr;
-                break;
-            }
-
-            old_curr = old_curr->next;
-            prev = new_curr;
-            new_curr = new_curr->next;
-        }
-    } else {
-        last_node = _head;
-        while (last_node && last_node->next) {
-            prev = last_node;
-            last_node = last_node->next;
+    while (old_curr && new_curr) {
+        if (old_curr->next) {
+            FreeListNode* new_next_ptr = rebase_ptr<FreeListNode*>(old_curr->next, _buffer, new_buffer);
+            new_curr->next = new_next_ptr;
+        } else {
+            // last available node
+            last_node = new_curr;
+            break;
         }
+
+        old_curr = old_curr->next;
+        prev = new_curr;
+        new_curr = new_curr->next;
     }
 
     insert_node(last_node, free_node);
     coallescense_nodes(prev, last_node);
 
+    sf_mem_free(_buffer);
     _buffer = new_buffer;
     _capacity = new_capacity;
 }
@@ -2,10 +2,18 @@
 
 #include "sf_containers/traits.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
 
 namespace sf {
 
+// Heap allocator, blocks carry a small header with their size and alignment.
+// Blocks from LARGE_BLOCK_SIZE up get their own page mapping, growing them moves pages instead of copying bytes.
 struct GeneralPurposeAllocator { 
+public:
+    static constexpr usize LARGE_BLOCK_SIZE{ 256 * 1024 };
+private:
+    MemoryTag _tag{ MemoryTag::GENERAL };
+public:
     void* allocate(u32 size, u16 alignment) noexcept;
     usize allocate_handle(u32 size, u16 alignment) noexcept;
     void* handle_to_ptr(usize handle) const noexcept;
@@ -15,6 +23,8 @@ struct GeneralPurposeAllocator {
     void free(void* addr) noexcept;
     void free_handle(usize handle) noexcept;
     void clear() noexcept {}
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
 };
 
 } // sf
@@ -1,24 +1,32 @@
 #pragma once
 
+#include "sf_allocators/block_chain.hpp"
 #include "sf_containers/traits.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
 
 namespace sf {
 
+// Bump allocator on top of BlockChain: growing chains a new block, so handed out pointers stay valid.
+// Count and handles are logical offsets inside of the chain.
 struct LinearAllocator {
 public:
 static constexpr usize DEFAULT_INIT_CAPACITY{1024};
+
+    struct Snapshot {
+        usize count;
+    };
 private:
-    usize _capacity;
-    usize _count;
-    u8*   _buffer;
+    BlockChain _chain;
+    usize      _count;
+    MemoryTag  _tag;
 
 public:
     LinearAllocator() noexcept;
     LinearAllocator(usize capacity) noexcept;
     LinearAllocator(LinearAllocator&& rhs) noexcept;
     LinearAllocator& operator=(LinearAllocator&& rhs) noexcept;
-    ~LinearAllocator() noexcept;
+    ~LinearAllocator() noexcept = default;
 
     void* allocate(usize size, u16 alignment) noexcept;
     usize allocate_handle(usize size, u16 alignment) noexcept;
@@ -29,19 +37,14 @@ public:
     void clear() noexcept;
     void free(void* addr) noexcept {}
     void free_handle(usize handle) noexcept {}
+    // frees everything allocated after the snapshot was made
+    void rewind(Snapshot snapshot) noexcept;
+    Snapshot make_snapshot() const noexcept;
 
-    constexpr u8* begin() noexcept { return _buffer; }
-    constexpr u8* data() noexcept { return _buffer; }
-    constexpr u8* end() noexcept { return _buffer + _count; }
     constexpr usize count() const noexcept { return _count; }
-    constexpr usize capacity() const noexcept { return _capacity; }
-    // const counterparts
-    const u8* begin() const noexcept { return _buffer; }
-    const u8* data() const noexcept { return _buffer; }
-    const u8* end() const noexcept { return _buffer + _count; }
-
-private:
-    void resize(usize new_capacity) noexcept;
+    constexpr usize capacity() const noexcept { return _chain.capacity(); }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
 };
 
 } // sf
@@ -0,0 +1,345 @@
+#pragma once
+
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include "sf_core/utility.hpp"
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+// Typed pool of fixed-size slots.
+// Free slots form an intrusive stack of indices, so acquire/release are O(1).
+// Address range for MAX_SLOT_COUNT slots is reserved on first growth and committed chunk by chunk,
+// slots never move, so pointers stay valid and a pointer maps to its index with one subtraction.
+// Handle is the slot index.
+template<typename T, u32 CHUNK_CAPACITY = 256, u32 MAX_CHUNK_COUNT = 256>
+struct PoolAllocator {
+public:
+    static_assert(CHUNK_CAPACITY % 64 == 0, "Chunk capacity should be a multiple of 64");
+    static constexpr u32 MAX_SLOT_COUNT{ CHUNK_CAPACITY * MAX_CHUNK_COUNT };
+    static constexpr u32 OCCUPANCY_WORD_COUNT{ CHUNK_CAPACITY / 64 };
+
+    union Slot {
+        alignas(T) u8 storage[sizeof(T)];
+        // valid only while slot is free
+        u32 next_free;
+    };
+private:
+    // occupancy bits of all slots are at the start of the range, slots follow them
+    static constexpr usize SLOTS_OFFSET{ (MAX_SLOT_COUNT / 8 + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot) };
+    static constexpr usize RANGE_SIZE{ SLOTS_OFFSET + static_cast<usize>(MAX_SLOT_COUNT) * sizeof(Slot) };
+
+    u8*         _base;
+    Slot*       _slots;
+    usize       _reserved_size;
+    usize       _committed_size;
+    u32         _chunk_count;
+    u32         _free_head;
+    u32         _count;
+    MemoryTag   _tag;
+    bool        _is_virtual;
+
+public:
+    PoolAllocator() noexcept
+        : _base{ nullptr }
+        , _slots{ nullptr }
+        , _reserved_size{ 0 }
+        , _committed_size{ 0 }
+        , _chunk_count{ 0 }
+        , _free_head{ INVALID_ID }
+        , _count{ 0 }
+        , _tag{ MemoryTag::UNKNOWN }
+        , _is_virtual{ false }
+    {}
+
+    PoolAllocator(const PoolAllocator& rhs) = delete;
+    PoolAllocator& operator=(const PoolAllocator& rhs) = delete;
+
+    ~PoolAllocator() noexcept
+    {
+        destroy_all();
+        if (!_base) {
+            return;
+        }
+        if (_is_virtual) {
+            platform_mem_release(_base, _reserved_size);
+        } else {
+            sf_mem_free(_base, alignof(Slot));
+        }
+    }
+
+    // makes sure that 'slot_count' slots are available without further commits
+    void reserve(u32 slot_count) noexcept {
+        const u32 first_new_chunk = _chunk_count;
+        while (capacity() < slot_count && commit_chunk()) {}
+
+        // link in reverse, so slots with lower indices are acquired first
+        for (u32 chunk_index = _chunk_count; chunk_index > first_new_chunk; --chunk_index) {
+            link_chunk_slots(chunk_index - 1);
+        }
+    }
+
+    // returns index of uninitialized slot
+    u32 acquire_slot() noexcept {
+        if (_free_head == INVALID_ID) {
+            if (!grow()) {
+                return INVALID_ID;
+            }
+        }
+
+        u32 index = _free_head;
+        Slot& slot = _slots[index];
+        _free_head = slot.next_free;
+        set_occupied(index, true);
+        ++_count;
+        memory_track_alloc(_tag, sizeof(T));
+        return index;
+    }
+
+    void release_slot(u32 index) noexcept {
+        SF_ASSERT_MSG(is_occupied(index), "Releasing slot which is not occupied");
+        Slot& slot = _slots[index];
+        slot.next_free = _free_head;
+        _free_head = index;
+        set_occupied(index, false);
+        --_count;
+        memory_track_free(_tag, sizeof(T));
+    }
+
+    template<typename ...Args>
+    T* construct(Args&&... args) noexcept {
+        u32 index = acquire_slot();
+        if (index == INVALID_ID) {
+            return nullptr;
+        }
+        return sf_mem_place(reinterpret_cast<T*>(_slots[index].storage), std::forward<Args>(args)...);
+    }
+
+    void destroy(T* item) noexcept {
+        u32 index = static_cast<u32>(ptr_to_handle(item));
+        if (index == INVALID_ID) {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            item->~T();
+        }
+        release_slot(index);
+    }
+
+    // calls destructors of all live items and returns every slot into free stack
+    void destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for_each([](T& item, u32) { item.~T(); });
+        }
+        clear();
+    }
+
+    // iterates only over occupied slots, fn(T& item, u32 index)
+    template<typename Fn>
+    void for_each(Fn&& fn) noexcept {
+        const u32 word_count = _chunk_count * OCCUPANCY_WORD_COUNT;
+        for (u32 word_index{0}; word_index < word_count; ++word_index) {
+            u64 word = occupancy()[word_index];
+            while (word) {
+                u32 bit = static_cast<u32>(std::countr_zero(word));
+                word &= word - 1;
+                u32 index = word_index * 64 + bit;
+                fn(*reinterpret_cast<T*>(_slots[index].storage), index);
+            }
+        }
+    }
+
+    T& operator[](u32 index) noexcept {
+        SF_ASSERT_MSG(is_occupied(index), "Accessing slot which is not occupied");
+        return *reinterpret_cast<T*>(_slots[index].storage);
+    }
+
+    const T& operator[](u32 index) const noexcept {
+        SF_ASSERT_MSG(is_occupied(index), "Accessing slot which is not occupied");
+        return *reinterpret_cast<const T*>(_slots[index].storage);
+    }
+
+    bool is_occupied(u32 index) const noexcept {
+        if (index >= capacity()) {
+            return false;
+        }
+        return occupancy()[index / 64] & (1ULL << (index % 64));
+    }
+
+    constexpr u32 count() const noexcept { return _count; }
+    constexpr u32 capacity() const noexcept { return _chunk_count * CHUNK_CAPACITY; }
+    constexpr u32 chunk_count() const noexcept { return _chunk_count; }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
+
+    // AllocatorTrait
+
+    void* allocate(usize size, u16 alignment) noexcept {
+        SF_ASSERT_MSG(size <= sizeof(T) && alignment <= alignof(T), "PoolAllocator can't serve allocations bigger than slot");
+        u32 index = acquire_slot();
+        if (index == INVALID_ID) {
+            return nullptr;
+        }
+        return _slots[index].storage;
+    }
+
+    usize allocate_handle(usize size, u16 alignment) noexcept {
+        SF_ASSERT_MSG(size <= sizeof(T) && alignment <= alignof(T), "PoolAllocator can't serve allocations bigger than slot");
+        u32 index = acquire_slot();
+        return index == INVALID_ID ? INVALID_ALLOC_HANDLE : index;
+    }
+
+    void* handle_to_ptr(usize handle) const noexcept {
+        if (handle >= capacity()) {
+            return nullptr;
+        }
+        return _slots[handle].storage;
+    }
+
+    // no bounds check, doesn't read anything growth changes, so it can run while another thread acquires slots,
+    // caller should know that the slot was committed before
+    void* slot_ptr_unchecked(u32 index) const noexcept {
+        return _slots[index].storage;
+    }
+
+    // INVALID_ID for pointers outside of committed slots, pointer into the middle of a slot maps to that slot
+    usize ptr_to_handle(void* ptr) const noexcept {
+        // pointers below the range wrap around and fail the range check too
+        const usize offset = reinterpret_cast<usize>(ptr) - reinterpret_cast<usize>(_slots);
+        if (!_slots || offset >= static_cast<usize>(capacity()) * sizeof(Slot)) {
+            return INVALID_ID;
+        }
+        return offset / sizeof(Slot);
+    }
+
+    // slots have fixed size, so reallocation only succeeds in place
+    ReallocReturn reallocate(void* addr, usize new_size, u16 alignment) noexcept {
+        if (!addr) {
+            return {allocate(new_size, alignment), false};
+        }
+        if (new_size > sizeof(T)) {
+            return {nullptr, false};
+        }
+        return {addr, false};
+    }
+
+    ReallocReturnHandle reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept {
+        if (handle == INVALID_ALLOC_HANDLE) {
+            return {allocate_handle(new_size, alignment), false};
+        }
+        if (new_size > sizeof(T)) {
+            return {INVALID_ALLOC_HANDLE, false};
+        }
+        return {handle, false};
+    }
+
+    void free(void* addr) noexcept {
+        usize index = ptr_to_handle(addr);
+        if (index == INVALID_ID) {
+            return;
+        }
+        release_slot(static_cast<u32>(index));
+    }
+
+    void free_handle(usize handle) noexcept {
+        if (handle == INVALID_ALLOC_HANDLE || handle >= capacity()) {
+            return;
+        }
+        release_slot(static_cast<u32>(handle));
+    }
+
+    // marks every slot as free without calling destructors, committed chunks are kept
+    void clear() noexcept {
+        memory_track_free(_tag, static_cast<usize>(_count) * sizeof(T));
+        _free_head = INVALID_ID;
+        _count = 0;
+        for (u32 chunk_index = _chunk_count; chunk_index > 0; --chunk_index) {
+            link_chunk_slots(chunk_index - 1);
+        }
+    }
+
+private:
+    u64* occupancy() const noexcept {
+        return reinterpret_cast<u64*>(_base);
+    }
+
+    void set_occupied(u32 index, bool occupied) noexcept {
+        u64 mask = 1ULL << (index % 64);
+        if (occupied) {
+            occupancy()[index / 64] |= mask;
+        } else {
+            occupancy()[index / 64] &= ~mask;
+        }
+    }
+
+    // pushes all slots of the chunk on top of free stack, lowest index ends up on top
+    void link_chunk_slots(u32 chunk_index) noexcept {
+        const u32 base = chunk_index * CHUNK_CAPACITY;
+        for (u32 i = CHUNK_CAPACITY; i > 0; --i) {
+            _slots[base + i - 1].next_free = _free_head;
+            _free_head = base + i - 1;
+        }
+        sf_mem_zero(occupancy() + chunk_index * OCCUPANCY_WORD_COUNT, OCCUPANCY_WORD_COUNT * sizeof(u64));
+    }
+
+    bool grow() noexcept {
+        if (!commit_chunk()) {
+            return false;
+        }
+        link_chunk_slots(_chunk_count - 1);
+        return true;
+    }
+
+    // whole range is reserved once, heap block of the same size is used when the os refuses
+    bool reserve_range() noexcept {
+        const usize page_size = get_mem_page_size();
+        _reserved_size = (RANGE_SIZE + page_size - 1) / page_size * page_size;
+        _base = static_cast<u8*>(platform_mem_reserve(_reserved_size));
+        _is_virtual = _base != nullptr;
+
+        if (!_is_virtual) {
+            LOG_WARN("PoolAllocator: failed to reserve virtual memory, falling back to heap");
+            _base = static_cast<u8*>(sf_mem_alloc(_reserved_size, alignof(Slot)));
+            if (!_base) {
+                return false;
+            }
+            sf_mem_zero(_base, SLOTS_OFFSET);
+            _committed_size = _reserved_size;
+        }
+        _slots = reinterpret_cast<Slot*>(_base + SLOTS_OFFSET);
+        return true;
+    }
+
+    bool commit_chunk() noexcept {
+        if (_chunk_count == MAX_CHUNK_COUNT) {
+            LOG_ERROR("PoolAllocator: max slot count {} is reached", MAX_SLOT_COUNT);
+            return false;
+        }
+        if (!_base && !reserve_range()) {
+            return false;
+        }
+
+        const usize chunk_end = SLOTS_OFFSET + static_cast<usize>(_chunk_count + 1) * CHUNK_CAPACITY * sizeof(Slot);
+        if (chunk_end > _committed_size) {
+            const usize page_size = get_mem_page_size();
+            const usize new_committed = std::min((chunk_end + page_size - 1) / page_size * page_size, _reserved_size);
+            if (!platform_mem_commit(_base + _committed_size, new_committed - _committed_size)) {
+                LOG_ERROR("PoolAllocator: failed to commit {} bytes", new_committed - _committed_size);
+                return false;
+            }
+            _committed_size = new_committed;
+        }
+        ++_chunk_count;
+        return true;
+    }
+};
+
+} // sf
@@ -1,31 +1,40 @@
 #pragma once
 
+#include "sf_allocators/block_chain.hpp"
 #include "sf_containers/traits.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
 
 namespace sf {
 
 struct StackAllocatorHeader {
     // offset - prev_offset at the moment of allocation
-    u16 diff;
-    u16 padding;
+    usize diff;
+    u32   padding;
 };
 
+// LIFO allocator on top of BlockChain: growing chains a new block, so handed out pointers stay valid.
+// Count and handles are logical offsets inside of the chain.
 struct StackAllocator {
 public:
 static constexpr usize DEFAULT_INIT_CAPACITY{1024};
+
+    struct Snapshot {
+        usize count;
+        usize prev_count;
+    };
 private:
-    u8*   _buffer;
-    usize _capacity;
-    usize _count;
-    usize _prev_count;
+    BlockChain _chain;
+    usize      _count;
+    usize      _prev_count;
+    MemoryTag  _tag;
 public:
     StackAllocator() noexcept;
     StackAllocator(usize capacity) noexcept;
     StackAllocator(StackAllocator&& rhs) noexcept;
     StackAllocator& operator=(StackAllocator&& rhs) noexcept;
-    ~StackAllocator() noexcept;
-    
+    ~StackAllocator() noexcept = default;
+
     void* allocate(usize size, u16 alignment) noexcept;
     usize allocate_handle(usize size, u16 alignment) noexcept;
     ReallocReturn reallocate(void* addr, usize new_size, u16 alignment) noexcept;
@@ -35,21 +44,14 @@ public:
     void free_handle(usize handle) noexcept;
     void* handle_to_ptr(usize handle) const noexcept;
     usize ptr_to_handle(void* ptr) const noexcept;
+    // frees everything allocated after the snapshot was made
+    void rewind(Snapshot snapshot) noexcept;
+    Snapshot make_snapshot() const noexcept;
 
-    constexpr u8* begin() noexcept { return _buffer; }
-    constexpr u8* data() noexcept { return _buffer; }
-    constexpr u8* end() noexcept { return _buffer + _count; }
     constexpr usize count() const noexcept { return _count; }
-    constexpr usize capacity() const noexcept { return _capacity; }
-    // const counterparts
-    const u8* begin() const noexcept { return _buffer; }
-    const u8* data() const noexcept { return _buffer; }
-    const u8* end() const noexcept { return _buffer + _count; }
-
-private:
-    void resize(usize new_capacity) noexcept;
-    void free_last_alloc(void* addr) noexcept;
-    void free_last_alloc_handle(usize handle) noexcept;
+    constexpr usize capacity() const noexcept { return _chain.capacity(); }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
 };
 
 } // sf
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "sf_allocators/stack_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
+
+namespace sf {
+
+// Allocator for code which runs on worker threads.
+// Every thread owns a cache of free lists, one per size class, so allocate/free are lock free on the fast path.
+// Empty list is refilled by a batch from the shared central list of the size class,
+// list which grew too long gives a batch back, both take the lock of that size class only.
+// Memory comes from 32 KiB chunks aligned to their size, chunk header stores the size class,
+// so free finds it by masking the pointer and memory can be freed from any thread.
+// Bigger requests bypass caches and get their own chunk.
+// Stateless facade, every instance shares the same caches.
+struct ThreadCacheAllocator {
+public:
+    static constexpr usize CHUNK_SIZE{ 32 * 1024 };
+    static constexpr usize CHUNK_HEADER_SIZE{ 64 };
+    // bigger alignment is served by the large path
+    static constexpr usize MIN_ALIGNMENT{ 16 };
+    static constexpr usize MAX_SMALL_SIZE{ 8 * 1024 };
+    // 8 classes with step 16 up to 128 bytes, then 4 classes per power of two
+    static constexpr u32 SIZE_CLASS_COUNT{ 32 };
+
+    void* allocate(usize size, u16 alignment) noexcept;
+    usize allocate_handle(usize size, u16 alignment) noexcept;
+    ReallocReturn reallocate(void* addr, usize new_size, u16 alignment) noexcept;
+    ReallocReturnHandle reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept;
+    void* handle_to_ptr(usize handle) const noexcept;
+    usize ptr_to_handle(void* ptr) const noexcept;
+    void free(void* addr) noexcept;
+    void free_handle(usize handle) noexcept;
+    void clear() noexcept {}
+
+    // usable size of the block, at least the requested one
+    static usize block_size(void* addr) noexcept;
+    // gives every cached block of the calling thread back to central lists, called automatically at thread exit
+    static void flush_thread_cache() noexcept;
+    // bytes sitting in the calling thread's cache
+    static usize thread_cache_size() noexcept;
+};
+
+// Scratch stack of the calling thread, no locks, memory of the allocator is freed at thread exit.
+// Use AllocatorScope to rewind it after a job.
+StackAllocator& thread_scratch_allocator() noexcept;
+
+} // sf
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "sf_containers/fixed_array.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/memory_tracker.hpp"
+
+namespace sf {
+
+// header of every physical block, payload starts right after it
+struct TLSFBlockHeader {
+    // physically previous block, nullptr for the first block in the pool
+    TLSFBlockHeader* prev_phys;
+    // payload size in bytes, lower bits are used for flags
+    usize            size_and_flags;
+};
+
+// free blocks reuse beginning of the payload for the segregated list links
+struct TLSFFreeLinks {
+    TLSFBlockHeader* next_free;
+    TLSFBlockHeader* prev_free;
+};
+
+// Two-Level Segregated Fit allocator:
+// first level splits sizes by power of two, second level splits every power of two range linearly,
+// both levels are indexed with bitmaps, so allocate and free are O(1)
+struct TLSFAllocator {
+public:
+    static constexpr usize DEFAULT_INIT_CAPACITY{ 1024 * 1024 };
+    static constexpr u32 MAX_POOL_COUNT{ 32 };
+
+    static constexpr u32 ALIGN_SIZE_LOG2{ 3 };
+    static constexpr u32 ALIGN_SIZE{ 1 << ALIGN_SIZE_LOG2 };
+    static constexpr u32 SL_INDEX_COUNT_LOG2{ 5 };
+    static constexpr u32 SL_INDEX_COUNT{ 1 << SL_INDEX_COUNT_LOG2 };
+    static constexpr u32 FL_INDEX_SHIFT{ SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2 };
+    static constexpr u32 FL_INDEX_MAX{ 32 };
+    static constexpr u32 FL_INDEX_COUNT{ FL_INDEX_MAX - FL_INDEX_SHIFT + 1 };
+    static constexpr usize SMALL_BLOCK_SIZE{ 1 << FL_INDEX_SHIFT };
+    static constexpr usize HEADER_SIZE{ sizeof(TLSFBlockHeader) };
+    static constexpr usize BLOCK_SIZE_MIN{ sizeof(TLSFFreeLinks) };
+    static constexpr usize BLOCK_SIZE_MAX{ static_cast<usize>(1) << FL_INDEX_MAX };
+
+    struct Pool {
+        u8*   data;
+        usize capacity;
+    };
+private:
+    u32                                 _fl_bitmap;
+    u32                                 _sl_bitmap[FL_INDEX_COUNT];
+    TLSFBlockHeader*                    _free_blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+    FixedArray<Pool, MAX_POOL_COUNT>    _pools;
+    usize                               _capacity;
+    // payload bytes of used blocks
+    usize                               _used;
+    MemoryTag                           _tag;
+    bool                                _resizable;
+
+public:
+    TLSFAllocator() noexcept;
+    TLSFAllocator(usize capacity, bool resizable = true) noexcept;
+    TLSFAllocator(TLSFAllocator&& rhs) noexcept = delete;
+    TLSFAllocator& operator=(TLSFAllocator&& rhs) noexcept = delete;
+    ~TLSFAllocator() noexcept;
+
+    void* allocate(usize size, u16 alignment) noexcept;
+    usize allocate_handle(usize size, u16 alignment) noexcept;
+    ReallocReturn reallocate(void* addr, usize new_size, u16 alignment) noexcept;
+    ReallocReturnHandle reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept;
+    void* handle_to_ptr(usize handle) const noexcept;
+    usize ptr_to_handle(void* ptr) const noexcept;
+    void free(void* addr) noexcept;
+    void free_handle(usize handle) noexcept;
+    void clear() noexcept;
+
+    usize get_remain_space() const noexcept;
+    usize get_largest_free_block() const noexcept;
+    constexpr usize total_size() const noexcept { return _capacity; }
+    constexpr u32 pool_count() const noexcept { return _pools.count(); }
+    constexpr usize used_size() const noexcept { return _used; }
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+    void set_memory_tag(MemoryTag tag) noexcept { _tag = tag; }
+
+private:
+    bool add_pool(usize capacity) noexcept;
+    void init_pool(Pool& pool) noexcept;
+    bool owns(void* addr) const noexcept;
+    void insert_free_block(TLSFBlockHeader* block) noexcept;
+    void remove_free_block(TLSFBlockHeader* block) noexcept;
+    TLSFBlockHeader* locate_free_block(usize size) noexcept;
+    TLSFBlockHeader* split_block(TLSFBlockHeader* block, usize size) noexcept;
+    TLSFBlockHeader* merge_with_prev(TLSFBlockHeader* block) noexcept;
+    TLSFBlockHeader* merge_with_next(TLSFBlockHeader* block) noexcept;
+    void trim_free_tail(TLSFBlockHeader* block, usize size) noexcept;
+    void trim_used_tail(TLSFBlockHeader* block, usize size) noexcept;
+};
+
+} // sf
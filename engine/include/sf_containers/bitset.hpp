@@ -1,13 +1,102 @@
 #pragma once
 
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/dynamic_array.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
 #include "sf_core/defines.hpp"
 #include "sf_core/memory_sf.hpp"
+#include <bit>
 #include <cmath>
+#include <span>
 
 namespace sf {
 
 inline constexpr u16 bitset_get_bit_size(u16 max_bit) { return static_cast<u16>(std::ceil(max_bit / 64.0f)); }
 
+inline constexpr u32 bitset_word_count(u32 bit_count) { return (bit_count + 63) >> 6; }
+
+// Word level scanning shared by fixed and dynamic bitsets, 64 bits are checked per step.
+// Bits past 'bit_count' in the last word are expected to be unset.
+
+// INVALID_ID if there is no set bit at or after 'from'
+inline u32 bitset_find_first_set(std::span<const u64> words, u32 from) {
+    u32 word_index = from >> 6;
+    if (word_index >= words.size()) {
+        return INVALID_ID;
+    }
+    u64 word = words[word_index] & (~0ULL << (from & 63));
+    while (word == 0) {
+        if (++word_index == words.size()) {
+            return INVALID_ID;
+        }
+        word = words[word_index];
+    }
+    return (word_index << 6) + static_cast<u32>(std::countr_zero(word));
+}
+
+// INVALID_ID if every bit in [from, bit_count) is set
+inline u32 bitset_find_first_unset(std::span<const u64> words, u32 from, u32 bit_count) {
+    u32 word_index = from >> 6;
+    if (from >= bit_count) {
+        return INVALID_ID;
+    }
+    u64 word = ~words[word_index] & (~0ULL << (from & 63));
+    while (word == 0) {
+        if (++word_index == words.size()) {
+            return INVALID_ID;
+        }
+        word = ~words[word_index];
+    }
+    const u32 bit = (word_index << 6) + static_cast<u32>(std::countr_zero(word));
+    return bit < bit_count ? bit : INVALID_ID;
+}
+
+inline u32 bitset_count(std::span<const u64> words) {
+    u32 count{0};
+    for (u64 word : words) {
+        count += static_cast<u32>(std::popcount(word));
+    }
+    return count;
+}
+
+// bits [first, first + count), whole words in between are written at once
+inline void bitset_write_range(std::span<u64> words, u32 first, u32 count, bool value) {
+    if (count == 0) {
+        return;
+    }
+    const u32 last = first + count - 1;
+    const u32 first_word = first >> 6;
+    const u32 last_word = last >> 6;
+    const u64 first_mask = ~0ULL << (first & 63);
+    const u64 last_mask = ~0ULL >> (63 - (last & 63));
+
+    if (first_word == last_word) {
+        const u64 mask = first_mask & last_mask;
+        words[first_word] = value ? (words[first_word] | mask) : (words[first_word] & ~mask);
+        return;
+    }
+
+    words[first_word] = value ? (words[first_word] | first_mask) : (words[first_word] & ~first_mask);
+    for (u32 i = first_word + 1; i < last_word; ++i) {
+        words[i] = value ? ~0ULL : 0ULL;
+    }
+    words[last_word] = value ? (words[last_word] | last_mask) : (words[last_word] & ~last_mask);
+}
+
+// fn(u32 bit) for every set bit in ascending order, empty words cost one compare
+template<typename Fn>
+void bitset_for_each_set(std::span<const u64> words, Fn&& fn) {
+    for (u32 word_index{0}; word_index < words.size(); ++word_index) {
+        u64 word = words[word_index];
+        while (word != 0) {
+            fn((word_index << 6) + static_cast<u32>(std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+}
+
 template<u16 BIT_SIZE>
 struct BitSet {
     static_assert(BIT_SIZE % 64 == 0, "Should be divisible by 64");
@@ -25,22 +114,188 @@ struct BitSet {
     }
 
     void unset_bit(u16 bit) {
-        data[bit >> 6] &= (0ULL << (bit & 63));
+        data[bit >> 6] &= ~(1ULL << (bit & 63));
     }
 
     void toggle_bit(u16 bit) {
         data[bit >> 6] ^= (1ULL << (bit & 63));
     }
-    
-    bool is_bit(u16 bit) {
+
+    bool is_bit(u16 bit) const {
         return data[bit >> 6] & (1ULL << (bit & 63));
     }
 
+    // INVALID_ID if there is none
+    u32 find_first_set(u16 from = 0) const {
+        return bitset_find_first_set(data, from);
+    }
+
+    // INVALID_ID if there is none
+    u32 find_first_unset(u16 from = 0) const {
+        return bitset_find_first_unset(data, from, BIT_SIZE);
+    }
+
+    u32 count() const {
+        return bitset_count(data);
+    }
+
+    // fn(u32 bit)
+    template<typename Fn>
+    void for_each_set(Fn&& fn) const {
+        bitset_for_each_set(data, std::forward<Fn>(fn));
+    }
+
     void reset() {
         sf_mem_zero(data, BIT_BUCKETS * sizeof(u64));
     }
 };
 
-} // sf
+// Bitset sized at runtime, used for occupancy and visibility masks.
+// Binary operations go word by word over plain arrays, compiler vectorizes them for large sets.
+template<AllocatorTrait Allocator = GeneralPurposeAllocator>
+struct DynamicBitSet {
+private:
+    DynamicArray<u64, Allocator, false> _words;
+    u32                                 _bit_count;
+
+public:
+    DynamicBitSet() noexcept
+        : _bit_count{ 0 }
+    {}
+
+    explicit DynamicBitSet(Allocator* allocator) noexcept
+        : _words(allocator)
+        , _bit_count{ 0 }
+    {}
+
+    explicit DynamicBitSet(u32 bit_count, Allocator* allocator) noexcept
+        : _words(allocator)
+        , _bit_count{ 0 }
+    {
+        resize(bit_count);
+    }
+
+    void set_allocator(Allocator* allocator) noexcept {
+        _words.set_allocator(allocator);
+    }
+
+    // new bits are unset
+    void resize(u32 bit_count) noexcept {
+        const u32 old_word_count = _words.count();
+        const u32 new_word_count = bitset_word_count(bit_count);
 
+        if (new_word_count > old_word_count) {
+            _words.resize(new_word_count);
+            sf_mem_zero(_words.data() + old_word_count, (new_word_count - old_word_count) * sizeof(u64));
+        } else if (new_word_count < old_word_count) {
+            _words.pop_range(old_word_count - new_word_count);
+        }
+        if (bit_count < _bit_count) {
+            clear_tail(bit_count);
+        }
+        _bit_count = bit_count;
+    }
+
+    void set_bit(u32 bit) noexcept {
+        SF_ASSERT_MSG(bit < _bit_count, "Out of bounds");
+        _words[bit >> 6] |= (1ULL << (bit & 63));
+    }
+
+    void unset_bit(u32 bit) noexcept {
+        SF_ASSERT_MSG(bit < _bit_count, "Out of bounds");
+        _words[bit >> 6] &= ~(1ULL << (bit & 63));
+    }
+
+    void toggle_bit(u32 bit) noexcept {
+        SF_ASSERT_MSG(bit < _bit_count, "Out of bounds");
+        _words[bit >> 6] ^= (1ULL << (bit & 63));
+    }
+
+    bool is_bit(u32 bit) const noexcept {
+        SF_ASSERT_MSG(bit < _bit_count, "Out of bounds");
+        return _words[bit >> 6] & (1ULL << (bit & 63));
+    }
+
+    void set_range(u32 first, u32 count) noexcept {
+        SF_ASSERT_MSG(first + count <= _bit_count, "Out of bounds");
+        bitset_write_range(_words.to_span(), first, count, true);
+    }
+
+    void unset_range(u32 first, u32 count) noexcept {
+        SF_ASSERT_MSG(first + count <= _bit_count, "Out of bounds");
+        bitset_write_range(_words.to_span(), first, count, false);
+    }
+
+    void set_all() noexcept {
+        set_range(0, _bit_count);
+    }
+
+    void reset() noexcept {
+        if (!_words.is_empty()) {
+            sf_mem_zero(_words.data(), _words.count() * sizeof(u64));
+        }
+    }
+
+    // INVALID_ID if there is none
+    u32 find_first_set(u32 from = 0) const noexcept {
+        return bitset_find_first_set(_words.to_span(), from);
+    }
+
+    // INVALID_ID if there is none
+    u32 find_first_unset(u32 from = 0) const noexcept {
+        return bitset_find_first_unset(_words.to_span(), from, _bit_count);
+    }
+
+    // number of set bits
+    u32 count() const noexcept {
+        return bitset_count(_words.to_span());
+    }
+
+    // fn(u32 bit)
+    template<typename Fn>
+    void for_each_set(Fn&& fn) const noexcept {
+        bitset_for_each_set(_words.to_span(), std::forward<Fn>(fn));
+    }
+
+    // binary operations expect sets of the same size
+    void and_with(const DynamicBitSet& rhs) noexcept {
+        SF_ASSERT_MSG(_bit_count == rhs._bit_count, "Bitsets should be of the same size");
+        u64* dst = _words.data();
+        const u64* src = rhs._words.data();
+        for (u32 i{0}; i < _words.count(); ++i) {
+            dst[i] &= src[i];
+        }
+    }
 
+    void or_with(const DynamicBitSet& rhs) noexcept {
+        SF_ASSERT_MSG(_bit_count == rhs._bit_count, "Bitsets should be of the same size");
+        u64* dst = _words.data();
+        const u64* src = rhs._words.data();
+        for (u32 i{0}; i < _words.count(); ++i) {
+            dst[i] |= src[i];
+        }
+    }
+
+    void and_not_with(const DynamicBitSet& rhs) noexcept {
+        SF_ASSERT_MSG(_bit_count == rhs._bit_count, "Bitsets should be of the same size");
+        u64* dst = _words.data();
+        const u64* src = rhs._words.data();
+        for (u32 i{0}; i < _words.count(); ++i) {
+            dst[i] &= ~src[i];
+        }
+    }
+
+    std::span<const u64> words() const noexcept { return _words.to_span(); }
+    constexpr u32 bit_count() const noexcept { return _bit_count; }
+    constexpr bool is_empty() const noexcept { return _bit_count == 0; }
+
+private:
+    // keeps bits past the end unset, scans rely on it
+    void clear_tail(u32 bit_count) noexcept {
+        if ((bit_count & 63) != 0) {
+            _words[bit_count >> 6] &= ~(~0ULL << (bit_count & 63));
+        }
+    }
+};
+
+} // sf
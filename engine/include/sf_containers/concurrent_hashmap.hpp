@@ -0,0 +1,297 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/hashmap.hpp"
+#include "sf_containers/optional.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+template<typename V>
+struct ConcurrentPutResult {
+    V*   value;
+    // false if the key was already there, 'value' points to the existing one then
+    bool inserted;
+};
+
+// Open addressing map for small keys, lookups never lock.
+// Writers lock a stripe picked by the key hash, so inserts of the same key are serialized and inserts of
+// different keys only race for free slots, which are claimed by CAS.
+// Full map doesn't rehash: a table twice as big is chained after the last one and lookups probe the tables
+// oldest first, so values never move and readers never see a table being rebuilt.
+// Key word of a slot is published with release after the value is constructed, removal leaves a tombstone
+// which later inserts claim again, so a pointer returned by 'get' stays valid until its key is removed.
+// Value of a removed key can be rebuilt for another key, removal is for entries nobody else points to anymore.
+// Fields of the value changed after insert should be atomics.
+// Growth allocates on the inserting thread, so the allocator should be thread safe (GeneralPurposeAllocator is).
+template<typename K, typename V, AllocatorTrait Allocator = GeneralPurposeAllocator, u32 STRIPE_COUNT = 64>
+struct ConcurrentHashMap {
+    static_assert(std::is_trivially_copyable_v<K> && sizeof(K) <= sizeof(u32), "ConcurrentHashMap keys should fit into 32 bits");
+    static_assert(std::is_trivially_destructible_v<V>, "ConcurrentHashMap values are never destroyed, should be trivially destructible");
+    static_assert(std::has_single_bit(STRIPE_COUNT), "Stripe count should be a power of 2");
+public:
+    using KeyType = K;
+    using ValueType = V;
+    // every table doubles the capacity, 16 tables are 65536 times the first one
+    static constexpr u32 MAX_TABLE_COUNT{ 16 };
+private:
+    static constexpr u64 EMPTY{ 0 };
+    // claimed by a writer, value is not constructed yet
+    static constexpr u64 BUSY{ 1 };
+    static constexpr u64 TOMBSTONE{ 2 };
+    static constexpr u64 KEY_OFFSET{ 3 };
+
+    struct Slot {
+        std::atomic<u64>    key_word;
+        V                   value;
+    };
+
+    struct Table {
+        Slot*               slots{ nullptr };
+        u32                 mask{ 0 };
+        // live keys plus tombstones, slots past 7/8 of capacity are not handed out
+        std::atomic<u32>    used_count{ 0 };
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Stripe {
+        std::mutex mutex;
+    };
+
+    Allocator*          _allocator;
+    // tables below '_table_count' are published and never freed before destruction
+    Table               _tables[MAX_TABLE_COUNT];
+    std::atomic<u32>    _table_count;
+    std::atomic<u32>    _count;
+    std::mutex          _grow_mutex;
+    Stripe              _stripes[STRIPE_COUNT];
+
+public:
+    ConcurrentHashMap() noexcept
+        : _allocator{ nullptr }
+        , _table_count{ 0 }
+        , _count{ 0 }
+    {}
+
+    explicit ConcurrentHashMap(u32 initial_count, Allocator* allocator) noexcept
+        : ConcurrentHashMap()
+    {
+        create(initial_count, allocator);
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap& rhs) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap& rhs) = delete;
+
+    ~ConcurrentHashMap() noexcept
+    {
+        const u32 table_count = _table_count.load(std::memory_order_relaxed);
+        for (u32 i{0}; i < table_count; ++i) {
+            _allocator->free(_tables[i].slots);
+        }
+    }
+
+    // not thread safe, first table holds 'initial_count' keys, tombstones count towards it until an insert reuses them
+    void create(u32 initial_count, Allocator* allocator) noexcept {
+        SF_ASSERT_MSG(allocator && _table_count.load(std::memory_order_relaxed) == 0, "ConcurrentHashMap: should be created once with valid allocator");
+        _allocator = allocator;
+        if (!create_table(_tables[0], slot_count(initial_count))) {
+            LOG_ERROR("ConcurrentHashMap: failed to allocate {} slots", slot_count(initial_count));
+            return;
+        }
+        _table_count.store(1, std::memory_order_release);
+    }
+
+    // first table only, later ones are allocated as the map grows
+    static constexpr usize memory_requirement(u32 initial_count) {
+        return slot_count(initial_count) * sizeof(Slot) + alignof(Slot);
+    }
+
+    // lock-free
+    Option<V*> get(const K& key) noexcept {
+        Slot* slot = find(key);
+        if (!slot) {
+            return None::VALUE;
+        }
+        return &slot->value;
+    }
+
+    // value is constructed from 'args' only if the key is not there yet
+    template<typename ...Args>
+    ConcurrentPutResult<V> get_or_emplace(const K& key, Args&&... args) noexcept {
+        if (Slot* existing = find(key)) {
+            return { &existing->value, false };
+        }
+
+        const u64 hash = hashfn_default<K>(key);
+        std::lock_guard lock{ _stripes[hash & (STRIPE_COUNT - 1)].mutex };
+        // same key could be inserted while we were waiting for the stripe
+        if (Slot* existing = find(key)) {
+            return { &existing->value, false };
+        }
+
+        // older tables first, their tombstones are reused before the map grows
+        while (true) {
+            const u32 table_count = _table_count.load(std::memory_order_acquire);
+            for (u32 i{0}; i < table_count; ++i) {
+                if (V* value = try_insert(_tables[i], hash, key, std::forward<Args>(args)...)) {
+                    return { value, true };
+                }
+            }
+            if (!grow(table_count)) {
+                LOG_ERROR("ConcurrentHashMap: can't grow past {} slots", capacity());
+                return { nullptr, false };
+            }
+        }
+    }
+
+    // slot becomes a tombstone, which the next insert on its probe path reuses
+    bool remove(const K& key) noexcept {
+        const u64 hash = hashfn_default<K>(key);
+        std::lock_guard lock{ _stripes[hash & (STRIPE_COUNT - 1)].mutex };
+        Slot* slot = find(key);
+        if (!slot) {
+            return false;
+        }
+        slot->key_word.store(TOMBSTONE, std::memory_order_release);
+        _count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // not thread safe, invalidates all value pointers, grown tables are kept
+    void clear() noexcept {
+        const u32 table_count = _table_count.load(std::memory_order_relaxed);
+        for (u32 t{0}; t < table_count; ++t) {
+            Table& table = _tables[t];
+            for (u32 i{0}; i <= table.mask; ++i) {
+                table.slots[i].key_word.store(EMPTY, std::memory_order_relaxed);
+            }
+            table.used_count.store(0, std::memory_order_relaxed);
+        }
+        _count.store(0, std::memory_order_relaxed);
+    }
+
+    u32 count() const noexcept { return _count.load(std::memory_order_relaxed); }
+    bool is_empty() const noexcept { return count() == 0; }
+
+    u32 capacity() const noexcept {
+        const u32 table_count = _table_count.load(std::memory_order_acquire);
+        u32 total{0};
+        for (u32 i{0}; i < table_count; ++i) {
+            total += _tables[i].mask + 1;
+        }
+        return total;
+    }
+
+    u32 table_count() const noexcept { return _table_count.load(std::memory_order_acquire); }
+
+private:
+    static constexpr u32 slot_count(u32 max_count) {
+        return std::bit_ceil(std::max<u32>(max_count + max_count / 7 + 1, 16));
+    }
+
+    static u32 max_used_count(const Table& table) noexcept {
+        return (table.mask + 1) - (table.mask + 1) / 8;
+    }
+
+    bool create_table(Table& table, u32 capacity) noexcept {
+        table.slots = static_cast<Slot*>(_allocator->allocate(capacity * sizeof(Slot), alignof(Slot)));
+        if (!table.slots) {
+            return false;
+        }
+        for (u32 i{0}; i < capacity; ++i) {
+            sf_mem_place(&table.slots[i].key_word, EMPTY);
+        }
+        table.mask = capacity - 1;
+        table.used_count.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // chains a table twice as big as the last one, unless another writer already did since 'seen_table_count' was read
+    bool grow(u32 seen_table_count) noexcept {
+        std::lock_guard lock{ _grow_mutex };
+        const u32 table_count = _table_count.load(std::memory_order_relaxed);
+        if (table_count != seen_table_count) {
+            return true;
+        }
+        if (table_count == 0 || table_count == MAX_TABLE_COUNT) {
+            return false;
+        }
+        if (!create_table(_tables[table_count], (_tables[table_count - 1].mask + 1) * 2)) {
+            return false;
+        }
+        _table_count.store(table_count + 1, std::memory_order_release);
+        return true;
+    }
+
+    // first tombstone or empty slot on the probe path, slots before it never become empty again, so readers reach it.
+    // Tombstone is already counted as used, only an empty slot takes a new one. Nullptr if the table is full.
+    template<typename ...Args>
+    V* try_insert(Table& table, u64 hash, const K& key, Args&&... args) noexcept {
+        for (u32 i = hash & table.mask;; i = (i + 1) & table.mask) {
+            Slot& slot = table.slots[i];
+            u64 word = slot.key_word.load(std::memory_order_relaxed);
+            if (word == TOMBSTONE) {
+                if (slot.key_word.compare_exchange_strong(word, BUSY, std::memory_order_acquire)) {
+                    return publish(slot, key, std::forward<Args>(args)...);
+                }
+            } else if (word == EMPTY) {
+                if (table.used_count.fetch_add(1, std::memory_order_relaxed) >= max_used_count(table)) {
+                    table.used_count.fetch_sub(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                if (slot.key_word.compare_exchange_strong(word, BUSY, std::memory_order_acquire)) {
+                    return publish(slot, key, std::forward<Args>(args)...);
+                }
+                // another key took it first
+                table.used_count.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<typename ...Args>
+    V* publish(Slot& slot, const K& key, Args&&... args) noexcept {
+        sf_mem_place(&slot.value, std::forward<Args>(args)...);
+        slot.key_word.store(encode_key(key), std::memory_order_release);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        return &slot.value;
+    }
+
+    static u64 encode_key(const K& key) noexcept {
+        u32 bits{0};
+        sf_mem_copy(&bits, &key, sizeof(K));
+        return static_cast<u64>(bits) + KEY_OFFSET;
+    }
+
+    Slot* find(const K& key) noexcept {
+        const u64 key_word = encode_key(key);
+        const u64 hash = hashfn_default<K>(key);
+        const u32 table_count = _table_count.load(std::memory_order_acquire);
+        for (u32 t{0}; t < table_count; ++t) {
+            const Table& table = _tables[t];
+            u32 i = hash & table.mask;
+            // at least 1/8 of slots stays empty, so probing always ends
+            while (true) {
+                const u64 word = table.slots[i].key_word.load(std::memory_order_acquire);
+                if (word == key_word) {
+                    return &table.slots[i];
+                }
+                if (word == EMPTY) {
+                    break;
+                }
+                i = (i + 1) & table.mask;
+            }
+        }
+        return nullptr;
+    }
+}; // ConcurrentHashMap
+
+} // sf
@@ -568,13 +568,13 @@ protected:
         if constexpr (USE_HANDLE) {
             ReallocReturnHandle realloc_res = _allocator->reallocate_handle(_data.handle, _capacity * sizeof(T), alignof(T));
             if (realloc_res.should_mem_copy && old_capacity > 0) {
-                sf_mem_copy((void*)(_allocator->handle_to_ptr(realloc_res.handle)), (void*)(_allocator->handle_to_ptr(_data.handle)), old_capacity);
+                sf_mem_copy((void*)(_allocator->handle_to_ptr(realloc_res.handle)), (void*)(_allocator->handle_to_ptr(_data.handle)), _count * sizeof(T));
             }
             _data.handle = realloc_res.handle;
         } else {
             ReallocReturn realloc_res = _allocator->reallocate(_data.ptr, _capacity * sizeof(T), alignof(T));
             if (realloc_res.should_mem_copy && old_capacity > 0) {
-                sf_mem_copy((void*)realloc_res.ptr, (void*)_data.ptr, old_capacity);
+                sf_mem_copy((void*)realloc_res.ptr, (void*)_data.ptr, _count * sizeof(T));
             }
             _data.ptr = static_cast<T*>(realloc_res.ptr);
         }         
@@ -584,7 +584,7 @@ protected:
     {
         u32 free_capacity = _capacity - _count;
         if (free_capacity < alloc_count) {
-            grow(_capacity * GROW_FACTOR);
+            grow(_count + alloc_count);
         }
         T* return_memory = access_data() + _count;
         _count += alloc_count;
@@ -595,7 +595,7 @@ protected:
     {
         u32 free_capacity = _capacity - _count;
         if (free_capacity < alloc_count) {
-            grow(_capacity * GROW_FACTOR);
+            grow(_count + alloc_count);
         }
         _count += alloc_count;
     }
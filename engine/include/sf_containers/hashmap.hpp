@@ -5,6 +5,7 @@
 #include "sf_core/asserts_sf.hpp"
 #include "sf_core/constants.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/hash.hpp"
 #include "sf_core/logger.hpp"
 #include "sf_core/memory_sf.hpp"
 #include "sf_core/utility.hpp"
@@ -12,6 +13,7 @@
 #include "sf_containers/optional.hpp"
 #include <cstring>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace sf {
@@ -47,49 +49,27 @@ inline bool equal_fn_default<const char*>(ConstLRefOrValType<const char*> first,
     return sf_mem_cmp((void*)first, (void*)second, first_len);
 };
 
-// fnv1a hash function
-static constexpr u64 PRIME = 1099511628211ull;
-static constexpr u64 OFFSET_BASIS = 14695981039346656037ull;
-
+// integer-like keys go through a single multiply mixer, everything else is hashed by bytes (see sf_core/hash.hpp)
 template<typename K>
 u64 hashfn_default(ConstLRefOrValType<K> key) noexcept {
-    u64 hash = OFFSET_BASIS;
-
-    u8 bytes[sizeof(K)];
-    sf_mem_copy(bytes, &key, sizeof(K));
-
-    for (u32 i{0}; i < sizeof(K); ++i) {
-        hash ^= bytes[i];
-        hash *= PRIME;
+    if constexpr (std::is_integral_v<K> || std::is_enum_v<K>) {
+        return hash_u64(static_cast<u64>(key));
+    } else if constexpr (std::is_pointer_v<K>) {
+        return hash_u64(reinterpret_cast<usize>(key));
+    } else {
+        static_assert(std::has_unique_object_representations_v<K>, "Key has padding or floats, provide custom hash function");
+        return hash_bytes(reinterpret_cast<const char*>(&key), sizeof(K));
     }
-
-    return hash;
 }
 
 template<>
 inline u64 hashfn_default<std::string_view>(ConstLRefOrValType<std::string_view> key) noexcept {
-    u64 hash = OFFSET_BASIS;
-
-    for (u32 i{0}; i < key.size(); ++i) {
-        hash ^= key[i];
-        hash *= PRIME;
-    }
-
-    return hash;
+    return hash_str(key);
 }
 
 template<>
 inline u64 hashfn_default<const char*>(ConstLRefOrValType<const char*> key) noexcept {
-    u64 hash = OFFSET_BASIS;
-
-    u32 s_len{ static_cast<u32>(strlen(key)) };
-
-    for (u32 i{0}; i < s_len; ++i) {
-        hash ^= key[i];
-        hash *= PRIME;
-    }
-
-    return hash;
+    return hash_bytes(key, strlen(key));
 }
 
 template<typename K>
@@ -201,7 +181,6 @@ public:
         } else {
             rhs._data.ptr = nullptr;
         }
-        rhs._buffer = nullptr;
         rhs._capacity = 0;
         rhs._count = 0;
     }
@@ -229,7 +208,6 @@ public:
         } else {
             rhs._data.ptr = nullptr;
         }
-        rhs._buffer = nullptr;
         rhs._capacity = 0;
         rhs._count = 0;
     }
@@ -410,7 +388,7 @@ private:
         }
         if constexpr (USE_HANDLE) {
             _data.handle = _allocator->allocate_handle(_capacity * sizeof(Bucket), alignof(Bucket));
-            init_buffer_empty(_data.ptr, _capacity);
+            init_buffer_empty(access_data(), _capacity);
         } else {
             _data.ptr = static_cast<Bucket*>(_allocator->allocate(_capacity * sizeof(Bucket), alignof(Bucket)));
             init_buffer_empty(_data.ptr, _capacity);
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <span>
+#include <type_traits>
+
+namespace sf {
+
+// Bounded lock-free queue for any number of producers and consumers (Vyukov).
+// Every cell has a sequence number telling which lap of the ring it is ready for,
+// so producers and consumers only contend on their own position counter, never on a lock.
+// Batches claim a run of ready cells with a single CAS.
+template<typename T, AllocatorTrait Allocator = GeneralPurposeAllocator>
+struct MpmcQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "MpmcQueue elements should be trivially copyable");
+private:
+    struct Cell {
+        // == position: free for the producer of 'position'
+        // == position + 1: holds the item for the consumer of 'position'
+        std::atomic<usize>  sequence;
+        T                   item;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<usize>     _enqueue_pos;
+    alignas(CACHE_LINE_SIZE) std::atomic<usize>     _dequeue_pos;
+    // read only after creation
+    alignas(CACHE_LINE_SIZE) Allocator*             _allocator;
+    Cell*                                           _cells;
+    usize                                           _mask;
+
+public:
+    explicit MpmcQueue(u32 capacity, Allocator* allocator) noexcept
+        : _enqueue_pos{ 0 }
+        , _dequeue_pos{ 0 }
+        , _allocator{ allocator }
+        , _cells{ nullptr }
+        , _mask{ 0 }
+    {
+        SF_ASSERT_MSG(allocator, "MpmcQueue: allocator should be valid pointer");
+        SF_ASSERT_MSG(capacity > 1 && capacity <= (1u << 31), "MpmcQueue: invalid capacity");
+        capacity = std::bit_ceil(capacity);
+        _cells = static_cast<Cell*>(_allocator->allocate(capacity * sizeof(Cell), alignof(Cell)));
+        for (u32 i{0}; i < capacity; ++i) {
+            sf_mem_place(&_cells[i].sequence, static_cast<usize>(i));
+        }
+        _mask = capacity - 1;
+    }
+
+    MpmcQueue(const MpmcQueue& rhs) = delete;
+    MpmcQueue& operator=(const MpmcQueue& rhs) = delete;
+
+    ~MpmcQueue() noexcept
+    {
+        _allocator->free(_cells);
+    }
+
+    // false if full
+    bool push(const T& item) noexcept {
+        return push_batch({ &item, 1 }) == 1;
+    }
+
+    // returns how many items from the front of 'items' were pushed, 0 if full
+    u32 push_batch(std::span<const T> items) noexcept {
+        if (items.empty()) {
+            return 0;
+        }
+
+        usize pos = _enqueue_pos.load(std::memory_order_relaxed);
+        u32 claim_count;
+        while (true) {
+            claim_count = count_ready_cells(pos, 0, items.size());
+            if (claim_count == 0) {
+                const isize diff = static_cast<isize>(_cells[pos & _mask].sequence.load(std::memory_order_acquire) - pos);
+                if (diff < 0) {
+                    // consumers are still a lap behind
+                    return 0;
+                }
+                // another producer took this position
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + claim_count, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        for (u32 i{0}; i < claim_count; ++i) {
+            Cell& cell = _cells[(pos + i) & _mask];
+            cell.item = items[i];
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return claim_count;
+    }
+
+    // false if empty
+    bool pop(T& out_item) noexcept {
+        return pop_batch({ &out_item, 1 }) == 1;
+    }
+
+    // returns how many items were written to the front of 'out_items', 0 if empty
+    u32 pop_batch(std::span<T> out_items) noexcept {
+        if (out_items.empty()) {
+            return 0;
+        }
+
+        usize pos = _dequeue_pos.load(std::memory_order_relaxed);
+        u32 claim_count;
+        while (true) {
+            claim_count = count_ready_cells(pos, 1, out_items.size());
+            if (claim_count == 0) {
+                const isize diff = static_cast<isize>(_cells[pos & _mask].sequence.load(std::memory_order_acquire) - (pos + 1));
+                if (diff < 0) {
+                    // producer hasn't published this position yet
+                    return 0;
+                }
+                // another consumer took this position
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (_dequeue_pos.compare_exchange_weak(pos, pos + claim_count, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        for (u32 i{0}; i < claim_count; ++i) {
+            Cell& cell = _cells[(pos + i) & _mask];
+            out_items[i] = cell.item;
+            // free for the producer of the next lap
+            cell.sequence.store(pos + i + _mask + 1, std::memory_order_release);
+        }
+        return claim_count;
+    }
+
+    // approximate when called while other threads are running
+    u32 count() const noexcept {
+        const usize enqueue_pos = _enqueue_pos.load(std::memory_order_acquire);
+        const usize dequeue_pos = _dequeue_pos.load(std::memory_order_acquire);
+        return enqueue_pos > dequeue_pos ? static_cast<u32>(enqueue_pos - dequeue_pos) : 0;
+    }
+
+    u32 capacity() const noexcept { return static_cast<u32>(_mask + 1); }
+
+private:
+    // run of cells starting at 'pos' whose sequence is 'position + lag', at most 'max_count'
+    // cells stay in that state until somebody moves the position counter past them, so the run can be claimed by CAS
+    u32 count_ready_cells(usize pos, usize lag, usize max_count) const noexcept {
+        max_count = std::min(max_count, static_cast<usize>(capacity()));
+        u32 ready_count{0};
+        while (ready_count < max_count
+            && _cells[(pos + ready_count) & _mask].sequence.load(std::memory_order_acquire) == pos + ready_count + lag) {
+            ++ready_count;
+        }
+        return ready_count;
+    }
+}; // MpmcQueue
+
+} // sf
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/dynamic_array.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+// Array split into fixed-size pages, page table is the only thing that is reallocated.
+// Page is allocated when the first element in it is appended, elements are constructed on append,
+// so memory scales with the count, not with the max count. Addresses of elements never change.
+template<typename T, u32 PAGE_SIZE = 256, AllocatorTrait Allocator = GeneralPurposeAllocator>
+struct PagedArray {
+public:
+    static_assert(std::has_single_bit(PAGE_SIZE), "Page size should be a power of 2");
+    static constexpr u32 PAGE_SHIFT{ static_cast<u32>(std::countr_zero(PAGE_SIZE)) };
+    static constexpr u32 PAGE_MASK{ PAGE_SIZE - 1 };
+
+    using ValueType = T;
+private:
+    Allocator*                          _allocator;
+    DynamicArray<T*, Allocator, false>  _pages;
+    u32                                 _count;
+    // pages are tracked under it, elements are not tracked one by one
+    MemoryTag                           _tag;
+
+public:
+    PagedArray() noexcept
+        : _allocator{ nullptr }
+        , _count{ 0 }
+        , _tag{ MemoryTag::UNKNOWN }
+    {}
+
+    explicit PagedArray(Allocator* allocator) noexcept
+        : _allocator{ allocator }
+        , _pages(allocator)
+        , _count{ 0 }
+        , _tag{ MemoryTag::UNKNOWN }
+    {}
+
+    PagedArray(const PagedArray& rhs) = delete;
+    PagedArray& operator=(const PagedArray& rhs) = delete;
+
+    ~PagedArray() noexcept
+    {
+        clear();
+        if (_allocator) {
+            for (T* page : _pages) {
+                _allocator->free(page);
+            }
+            memory_track_free(_tag, static_cast<usize>(_pages.count()) * PAGE_SIZE * sizeof(T));
+        }
+    }
+
+    void set_allocator(Allocator* allocator) noexcept {
+        SF_ASSERT_MSG(_pages.is_empty(), "Can't change allocator of non empty paged array");
+        _allocator = allocator;
+        _pages.set_allocator(allocator);
+    }
+
+    // should be set before the first page is allocated
+    void set_memory_tag(MemoryTag tag) noexcept {
+        SF_ASSERT_MSG(_pages.is_empty(), "Can't change memory tag of paged array with allocated pages");
+        _tag = tag;
+    }
+
+    constexpr MemoryTag memory_tag() const noexcept { return _tag; }
+
+    // allocates pages for 'count' elements up front, elements are still constructed on append
+    bool reserve(u32 count) noexcept {
+        if (count > 0) {
+            return ensure_page((count - 1) >> PAGE_SHIFT);
+        }
+        return true;
+    }
+
+    static constexpr usize memory_requirement(u32 count) {
+        const usize page_count = (static_cast<usize>(count) + PAGE_MASK) >> PAGE_SHIFT;
+        return page_count * (PAGE_SIZE * sizeof(T) + alignof(T) + sizeof(T*));
+    }
+
+    // nullptr if the page for the new element couldn't be allocated, nothing is constructed then
+    template<typename ...Args>
+    T* emplace(Args&&... args) noexcept {
+        if (!ensure_page(_count >> PAGE_SHIFT)) {
+            return nullptr;
+        }
+        T* item = element_ptr(_count);
+        sf_mem_place(item, std::forward<Args>(args)...);
+        ++_count;
+        return item;
+    }
+
+    T* append(const T& item) noexcept {
+        return emplace(item);
+    }
+
+    T* append(T&& item) noexcept {
+        return emplace(std::move(item));
+    }
+
+    void pop() noexcept {
+        SF_ASSERT_MSG(_count > 0, "Can't pop from empty paged array");
+        --_count;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            element_ptr(_count)->~T();
+        }
+    }
+
+    // new elements are default constructed, pages are kept on shrink,
+    // false if growth stopped on a failed page allocation, elements constructed so far are kept
+    bool resize(u32 new_count) noexcept {
+        while (_count > new_count) {
+            pop();
+        }
+        while (_count < new_count) {
+            if (!emplace()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // destroys all elements, pages are kept
+    void clear() noexcept {
+        resize(0);
+    }
+
+    T& operator[](u32 index) noexcept {
+        SF_ASSERT_MSG(index < _count, "Out of bounds");
+        return *element_ptr(index);
+    }
+
+    const T& operator[](u32 index) const noexcept {
+        SF_ASSERT_MSG(index < _count, "Out of bounds");
+        return *element_ptr(index);
+    }
+
+    T& last() noexcept { return (*this)[_count - 1]; }
+    const T& last() const noexcept { return (*this)[_count - 1]; }
+
+    // live elements of the page, contiguous in memory
+    std::span<T> page_span(u32 page_index) noexcept {
+        SF_ASSERT_MSG(page_index < page_count(), "Out of bounds");
+        const u32 first = page_index << PAGE_SHIFT;
+        return { _pages[page_index], first < _count ? std::min(PAGE_SIZE, _count - first) : 0u };
+    }
+
+    // fn(T& item, u32 index), walks page by page
+    template<typename Fn>
+    void for_each(Fn&& fn) noexcept {
+        for (u32 page_index{0}; (page_index << PAGE_SHIFT) < _count; ++page_index) {
+            std::span<T> page = page_span(page_index);
+            for (u32 i{0}; i < page.size(); ++i) {
+                fn(page[i], (page_index << PAGE_SHIFT) + i);
+            }
+        }
+    }
+
+    constexpr u32 count() const noexcept { return _count; }
+    constexpr u32 capacity() const noexcept { return _pages.count() << PAGE_SHIFT; }
+    constexpr u32 page_count() const noexcept { return _pages.count(); }
+    constexpr bool is_empty() const noexcept { return _count == 0; }
+
+private:
+    T* element_ptr(u32 index) const noexcept {
+        return _pages[index >> PAGE_SHIFT] + (index & PAGE_MASK);
+    }
+
+    bool ensure_page(u32 page_index) noexcept {
+        SF_ASSERT_MSG(_allocator, "PagedArray: allocator is not set");
+        if (!_allocator) {
+            return false;
+        }
+        while (_pages.count() <= page_index) {
+            T* page = static_cast<T*>(_allocator->allocate(PAGE_SIZE * sizeof(T), alignof(T)));
+            if (!page) {
+                LOG_ERROR("PagedArray: failed to allocate page of {} bytes", PAGE_SIZE * sizeof(T));
+                return false;
+            }
+            _pages.append(page);
+            memory_track_alloc(_tag, PAGE_SIZE * sizeof(T));
+        }
+        return true;
+    }
+}; // PagedArray
+
+} // sf
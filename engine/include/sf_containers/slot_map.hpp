@@ -0,0 +1,173 @@
+#pragma once
+
+#include "sf_allocators/pool_allocator.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+// Slot index of a SlotMap plus generation of the slot when the handle was made.
+// 64-bit handle is 32/32 bits, 32-bit handle is 20 bits of index and 12 bits of generation.
+// Generations start from 1, so zero initialized handle is always null.
+// 'T' only makes handles of different maps distinct types.
+template<typename T, typename Bits = u64>
+struct SlotHandle {
+    static_assert(std::is_same_v<Bits, u64> || std::is_same_v<Bits, u32>, "SlotHandle bits should be u32 or u64");
+    static constexpr u32 INDEX_BITS{ sizeof(Bits) == 8 ? 32u : 20u };
+    static constexpr u32 GENERATION_BITS{ sizeof(Bits) * 8 - INDEX_BITS };
+    static constexpr u32 MAX_INDEX{ static_cast<u32>((1ull << INDEX_BITS) - 2) };
+    static constexpr u32 GENERATION_MASK{ static_cast<u32>((1ull << GENERATION_BITS) - 1) };
+
+    Bits bits{0};
+
+    static constexpr SlotHandle make(u32 index, u32 generation) {
+        return { static_cast<Bits>((static_cast<Bits>(generation) << INDEX_BITS) | index) };
+    }
+
+    constexpr u32 index() const { return static_cast<u32>(bits & ((static_cast<Bits>(1) << INDEX_BITS) - 1)); }
+    constexpr u32 generation() const { return static_cast<u32>(bits >> INDEX_BITS); }
+    constexpr bool is_null() const { return bits == 0; }
+    friend constexpr bool operator==(SlotHandle first, SlotHandle second) = default;
+};
+
+// Value of a slot lives in a PoolAllocator slot with the same index and is never moved, erase destroys it in place,
+// so a pointer returned by 'get' stays valid until its own handle is erased.
+// Generation of the slot is stored next to the value and survives erase, stale handles fail generation check
+// instead of pointing into reused memory. Iteration walks occupancy bits of the pool, so it only touches live values.
+// Storage is a reserved address range committed chunk by chunk, it doesn't come from an outer allocator.
+// Writers should be serialized, 'get' and 'contains' don't lock and can run next to a writer: slot storage never
+// moves and the slot count is published with release after generations of new slots are written.
+// Reading a value while another thread erases that same handle is still a race, ref counting should prevent it.
+template<typename T, typename Handle = SlotHandle<T>, u32 CHUNK_CAPACITY = 256, u32 MAX_CHUNK_COUNT = 256>
+struct SlotMap {
+public:
+    struct Entry {
+        T   value;
+        // placed after the value, so the free index the pool keeps in a released slot doesn't overwrite it
+        u32 generation;
+    };
+
+    using HandleType = Handle;
+    using Pool = PoolAllocator<Entry, CHUNK_CAPACITY, MAX_CHUNK_COUNT>;
+    static_assert(Pool::MAX_SLOT_COUNT - 1 <= Handle::MAX_INDEX, "Handle index bits can't address every slot of the map");
+private:
+    Pool                _values;
+    // slots below it have initialized generation
+    std::atomic<u32>    _slot_count;
+
+public:
+    SlotMap() noexcept
+        : _slot_count{ 0 }
+    {}
+
+    SlotMap(const SlotMap& rhs) = delete;
+    SlotMap& operator=(const SlotMap& rhs) = delete;
+
+    // live values are tracked under 'tag', should be set before the first insert
+    void set_memory_tag(MemoryTag tag) noexcept {
+        _values.set_memory_tag(tag);
+    }
+
+    // false if the max slot count or commit failure stopped it short
+    bool reserve(u32 count) noexcept {
+        _values.reserve(count);
+        return _values.capacity() >= count;
+    }
+
+    Handle insert(const T& value) noexcept {
+        return emplace(value);
+    }
+
+    Handle insert(T&& value) noexcept {
+        return emplace(std::move(value));
+    }
+
+    // null handle if the slot limit is reached or storage couldn't grow
+    template<typename ...Args>
+    Handle emplace(Args&&... args) noexcept {
+        const u32 slot_index = _values.acquire_slot();
+        if (slot_index == INVALID_ID) {
+            return {};
+        }
+        // slots are handed out lowest index first, but every skipped one still gets its generation
+        const u32 slot_count = _slot_count.load(std::memory_order_relaxed);
+        if (slot_index >= slot_count) {
+            for (u32 i = slot_count; i <= slot_index; ++i) {
+                entry_ptr(i)->generation = 1;
+            }
+            _slot_count.store(slot_index + 1, std::memory_order_release);
+        }
+        Entry* entry = entry_ptr(slot_index);
+        sf_mem_place(&entry->value, std::forward<Args>(args)...);
+        return Handle::make(slot_index, entry->generation);
+    }
+
+    // returns false for stale handles
+    bool erase(Handle handle) noexcept {
+        if (!contains(handle)) {
+            return false;
+        }
+        Entry* entry = entry_ptr(handle.index());
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            entry->value.~T();
+        }
+        bump_generation(*entry);
+        _values.release_slot(handle.index());
+        return true;
+    }
+
+    bool contains(Handle handle) const noexcept {
+        const u32 slot_index = handle.index();
+        return !handle.is_null() && slot_index < _slot_count.load(std::memory_order_acquire) && entry_ptr(slot_index)->generation == handle.generation();
+    }
+
+    // nullptr if handle is stale
+    T* get(Handle handle) noexcept {
+        return contains(handle) ? &entry_ptr(handle.index())->value : nullptr;
+    }
+
+    const T* get(Handle handle) const noexcept {
+        return contains(handle) ? &entry_ptr(handle.index())->value : nullptr;
+    }
+
+    // erases every value, all handles given out before become stale
+    void clear() noexcept {
+        _values.for_each([](Entry& entry, u32) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                entry.value.~T();
+            }
+            bump_generation(entry);
+        });
+        _values.clear();
+    }
+
+    // fn(T& value, Handle handle), in slot order
+    template<typename Fn>
+    void for_each(Fn&& fn) noexcept {
+        _values.for_each([&fn](Entry& entry, u32 slot_index) {
+            fn(entry.value, Handle::make(slot_index, entry.generation));
+        });
+    }
+
+    constexpr u32 count() const noexcept { return _values.count(); }
+    constexpr u32 capacity() const noexcept { return _values.capacity(); }
+    constexpr bool is_empty() const noexcept { return _values.count() == 0; }
+
+private:
+    Entry* entry_ptr(u32 slot_index) const noexcept {
+        return static_cast<Entry*>(_values.slot_ptr_unchecked(slot_index));
+    }
+
+    // handles to the slot become stale, zero is skipped on wrap
+    static void bump_generation(Entry& entry) noexcept {
+        entry.generation = (entry.generation + 1) & Handle::GENERATION_MASK;
+        if (entry.generation == 0) {
+            entry.generation = 1;
+        }
+    }
+}; // SlotMap
+
+} // sf
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/iterator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+// Array with inline storage for N elements, allocator is touched only when count grows past N.
+// Elements are moved with memcpy, same as DynamicArray does on grow, so only trivially copyable types are allowed.
+// Moving inline array copies its elements, moving spilled one takes its buffer.
+template<typename T, u32 N, AllocatorTrait Allocator = GeneralPurposeAllocator>
+struct SmallArray {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallArray elements should be trivially copyable");
+    static_assert(N > 0, "Inline capacity should be at least 1");
+protected:
+    Allocator*      _allocator;
+    // points to '_inline' until spilled
+    T*              _data;
+    u32             _capacity;
+    u32             _count;
+    alignas(T) u8   _inline[N * sizeof(T)];
+
+public:
+    using ValueType     = T;
+    using PointerType   = T*;
+
+public:
+    SmallArray() noexcept
+        : _allocator{ nullptr }
+        , _data{ inline_data() }
+        , _capacity{ N }
+        , _count{ 0 }
+    {}
+
+    explicit SmallArray(Allocator* allocator) noexcept
+        : _allocator{ allocator }
+        , _data{ inline_data() }
+        , _capacity{ N }
+        , _count{ 0 }
+    {}
+
+    explicit SmallArray(u32 capacity_input, Allocator* allocator) noexcept
+        : SmallArray(allocator)
+    {
+        reserve(capacity_input);
+    }
+
+    SmallArray(SmallArray&& rhs) noexcept
+        : SmallArray(rhs._allocator)
+    {
+        take(rhs);
+    }
+
+    SmallArray& operator=(SmallArray&& rhs) noexcept {
+        if (this == &rhs) return *this;
+        free();
+        _allocator = rhs._allocator;
+        take(rhs);
+        return *this;
+    }
+
+    SmallArray(const SmallArray& rhs) noexcept
+        : SmallArray(rhs._allocator)
+    {
+        append_slice(rhs.to_span());
+    }
+
+    SmallArray& operator=(const SmallArray& rhs) noexcept {
+        if (this == &rhs) return *this;
+        _count = 0;
+        if (!_allocator) {
+            _allocator = rhs._allocator;
+        }
+        append_slice(rhs.to_span());
+        return *this;
+    }
+
+    ~SmallArray() noexcept
+    {
+        free();
+    }
+
+    // returns heap buffer to the allocator, array becomes empty and inline again
+    void free() noexcept {
+        if (!is_inline()) {
+            _allocator->free(_data);
+            _data = inline_data();
+            _capacity = N;
+        }
+        _count = 0;
+    }
+
+    void set_allocator(Allocator* allocator) noexcept {
+        if (allocator) {
+            _allocator = allocator;
+        } else {
+            LOG_ERROR("SmallArray : set_allocator(): provided allocator is nullptr");
+        }
+    }
+
+    void reserve(u32 new_capacity) noexcept {
+        if (new_capacity > _capacity) {
+            grow(new_capacity);
+        }
+    }
+
+    template<typename ...Args>
+    void append_emplace(Args&&... args) noexcept {
+        sf_mem_place(move_forward(1), std::forward<Args>(args)...);
+    }
+
+    void append(const T& item) noexcept {
+        // item may live in this array, copy it before growing
+        const T value = item;
+        *move_forward(1) = value;
+    }
+
+    // 'sp' may be a part of this array, then it's read from the new storage after growing
+    void append_slice(std::span<const T> sp) noexcept {
+        if (sp.empty()) {
+            return;
+        }
+        const usize src_offset = reinterpret_cast<usize>(sp.data()) - reinterpret_cast<usize>(_data);
+        const bool is_own = src_offset < static_cast<usize>(_count) * sizeof(T);
+        T* place = move_forward(sp.size());
+        const T* src = is_own ? reinterpret_cast<const T*>(reinterpret_cast<const u8*>(_data) + src_offset) : sp.data();
+        sf_mem_copy(place, src, sizeof(T) * sp.size());
+    }
+
+    void resize(u32 new_count) noexcept {
+        if (new_count > _count) {
+            move_forward(new_count - _count);
+        } else {
+            _count = new_count;
+        }
+    }
+
+    constexpr void pop() noexcept {
+        SF_ASSERT_MSG(_count > 0, "Can't pop from empty array");
+        --_count;
+    }
+
+    constexpr void clear() noexcept {
+        _count = 0;
+    }
+
+    std::span<T> to_span() noexcept { return { _data, _count }; }
+    std::span<const T> to_span() const noexcept { return { _data, _count }; }
+
+    constexpr bool is_empty() const noexcept { return _count == 0; }
+    // false once elements were moved to the allocator
+    bool is_inline() const noexcept { return _data == inline_data(); }
+    constexpr T* data() noexcept { return _data; }
+    constexpr const T* data() const noexcept { return _data; }
+    constexpr T& first() noexcept { return _data[0]; }
+    constexpr const T& first() const noexcept { return _data[0]; }
+    constexpr T& last() noexcept { return _data[_count - 1]; }
+    constexpr const T& last() const noexcept { return _data[_count - 1]; }
+    constexpr u32 count() const noexcept { return _count; }
+    constexpr u32 capacity() const noexcept { return _capacity; }
+
+    constexpr PtrRandomAccessIterator<T> begin() const noexcept {
+        return PtrRandomAccessIterator<T>(_data);
+    }
+
+    constexpr PtrRandomAccessIterator<T> end() const noexcept {
+        return PtrRandomAccessIterator<T>(_data + _count);
+    }
+
+    T& operator[](u32 ind) noexcept {
+        SF_ASSERT_MSG(ind < _count, "Out of bounds");
+        return _data[ind];
+    }
+
+    const T& operator[](u32 ind) const noexcept {
+        SF_ASSERT_MSG(ind < _count, "Out of bounds");
+        return _data[ind];
+    }
+
+protected:
+    T* inline_data() const noexcept {
+        return reinterpret_cast<T*>(const_cast<u8*>(_inline));
+    }
+
+    T* move_forward(u32 add_count) noexcept {
+        if (_count + add_count > _capacity) {
+            u32 new_capacity = _capacity * 2;
+            while (new_capacity < _count + add_count) {
+                new_capacity *= 2;
+            }
+            grow(new_capacity);
+        }
+        T* place = _data + _count;
+        _count += add_count;
+        return place;
+    }
+
+    void grow(u32 new_capacity) noexcept {
+        SF_ASSERT_MSG(_allocator, "SmallArray: allocator should be set to grow past inline capacity");
+
+        if (is_inline()) {
+            T* heap_data = static_cast<T*>(_allocator->allocate(new_capacity * sizeof(T), alignof(T)));
+            if (_count > 0) {
+                sf_mem_copy((void*)heap_data, (void*)_data, _count * sizeof(T));
+            }
+            _data = heap_data;
+        } else {
+            ReallocReturn realloc_res = _allocator->reallocate(_data, new_capacity * sizeof(T), alignof(T));
+            if (realloc_res.should_mem_copy && _count > 0) {
+                sf_mem_copy(realloc_res.ptr, (void*)_data, _count * sizeof(T));
+            }
+            _data = static_cast<T*>(realloc_res.ptr);
+        }
+        _capacity = new_capacity;
+    }
+
+    // expects this array to be empty and inline
+    void take(SmallArray& rhs) noexcept {
+        if (rhs.is_inline()) {
+            if (rhs._count > 0) {
+                sf_mem_copy((void*)_data, (void*)rhs._data, rhs._count * sizeof(T));
+            }
+        } else {
+            _data = rhs._data;
+            _capacity = rhs._capacity;
+            rhs._data = rhs.inline_data();
+            rhs._capacity = N;
+        }
+        _count = rhs._count;
+        rhs._count = 0;
+    }
+}; // SmallArray
+
+template<u32 N, AllocatorTrait Allocator = GeneralPurposeAllocator>
+struct SmallString : public SmallArray<char, N, Allocator>
+{
+    using SmallArray<char, N, Allocator>::SmallArray;
+
+    std::string_view to_sv() const noexcept {
+        return std::string_view{ this->_data, this->_count };
+    }
+
+    std::string_view to_sv_not_null_terminated() const noexcept {
+        return std::string_view{ this->_data, is_null_terminated() ? this->_count - 1 : this->_count };
+    }
+
+    void append_sv(std::string_view sv) noexcept {
+        this->append_slice(std::span<const char>{ sv.data(), sv.size() });
+    }
+
+    void trim_end(char trimmer = ' ') noexcept {
+        while (this->_count > 0 && (this->last() == trimmer)) {
+            this->_count--;
+        }
+    }
+
+    void ensure_null_terminated() noexcept {
+        if (!is_null_terminated()) {
+            this->append('\0');
+        }
+    }
+
+    bool is_null_terminated() const noexcept {
+        return this->_count > 0 && this->last() == '\0';
+    }
+};
+
+} // sf
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+// Structure of arrays, one column per field in a single allocation, all columns grow together.
+// Every column starts at COLUMN_ALIGNMENT, so kernels can stream exactly the fields they need with aligned loads.
+// Columns are relocated with memcpy on grow, so only trivially copyable fields are allowed.
+template<AllocatorTrait Allocator, typename ...Ts>
+struct SoaArray {
+    static_assert(sizeof...(Ts) > 0, "SoaArray should have at least 1 column");
+    static_assert((std::is_trivially_copyable_v<Ts> && ...), "SoaArray columns should be trivially copyable");
+public:
+    static constexpr u32 COLUMN_COUNT{ sizeof...(Ts) };
+    // cache line, also enough for the widest vector loads
+    static constexpr u32 COLUMN_ALIGNMENT{ 64 };
+
+    template<u32 I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+private:
+    Allocator*          _allocator;
+    // first column is at the start of the block
+    std::tuple<Ts*...>  _columns;
+    u32                 _capacity;
+    u32                 _count;
+
+public:
+    SoaArray() noexcept
+        : _allocator{ nullptr }
+        , _columns{}
+        , _capacity{ 0 }
+        , _count{ 0 }
+    {}
+
+    explicit SoaArray(Allocator* allocator) noexcept
+        : _allocator{ allocator }
+        , _columns{}
+        , _capacity{ 0 }
+        , _count{ 0 }
+    {}
+
+    explicit SoaArray(u32 capacity_input, Allocator* allocator) noexcept
+        : SoaArray(allocator)
+    {
+        reserve(capacity_input);
+    }
+
+    SoaArray(SoaArray&& rhs) noexcept
+        : _allocator{ rhs._allocator }
+        , _columns{ rhs._columns }
+        , _capacity{ rhs._capacity }
+        , _count{ rhs._count }
+    {
+        rhs._columns = {};
+        rhs._capacity = 0;
+        rhs._count = 0;
+    }
+
+    SoaArray& operator=(SoaArray&& rhs) noexcept {
+        if (this == &rhs) return *this;
+        free();
+        _allocator = rhs._allocator;
+        _columns = rhs._columns;
+        _capacity = rhs._capacity;
+        _count = rhs._count;
+        rhs._columns = {};
+        rhs._capacity = 0;
+        rhs._count = 0;
+        return *this;
+    }
+
+    SoaArray(const SoaArray& rhs) = delete;
+    SoaArray& operator=(const SoaArray& rhs) = delete;
+
+    ~SoaArray() noexcept
+    {
+        free();
+    }
+
+    void free() noexcept {
+        if (_allocator && block()) {
+            _allocator->free(block());
+        }
+        _columns = {};
+        _capacity = 0;
+        _count = 0;
+    }
+
+    void set_allocator(Allocator* allocator) noexcept {
+        if (allocator) {
+            _allocator = allocator;
+        } else {
+            LOG_ERROR("SoaArray : set_allocator(): provided allocator is nullptr");
+        }
+    }
+
+    // false if the allocation failed, array is left as it was
+    bool reserve(u32 new_capacity) noexcept {
+        if (new_capacity > _capacity) {
+            return grow(new_capacity);
+        }
+        return true;
+    }
+
+    // bytes of the single block for 'capacity' rows, padding between columns included
+    static constexpr usize memory_requirement(u32 capacity) {
+        usize size{0};
+        ((size = align_column(size) + sizeof(Ts) * capacity), ...);
+        return size;
+    }
+
+    // returns index of the new row, INVALID_ID if the array couldn't grow
+    u32 append(const Ts&... values) noexcept {
+        const u32 index = move_forward(1);
+        if (index == INVALID_ID) {
+            return INVALID_ID;
+        }
+        append_impl(index, std::index_sequence_for<Ts...>{}, values...);
+        return index;
+    }
+
+    // last row is moved into the removed one
+    void remove_unordered_at(u32 index) noexcept {
+        SF_ASSERT_MSG(index < _count, "Out of bounds");
+        --_count;
+        if (index != _count) {
+            std::apply([index, this](Ts*... columns) {
+                ((columns[index] = columns[_count]), ...);
+            }, _columns);
+        }
+    }
+
+    // new rows are value initialized, false if the array couldn't grow
+    bool resize(u32 new_count) noexcept {
+        if (new_count > _count) {
+            const u32 first = move_forward(new_count - _count);
+            if (first == INVALID_ID) {
+                return false;
+            }
+            std::apply([first, this](Ts*... columns) {
+                (fill_column(columns + first, _count - first), ...);
+            }, _columns);
+        } else {
+            _count = new_count;
+        }
+        return true;
+    }
+
+    constexpr void pop() noexcept {
+        SF_ASSERT_MSG(_count > 0, "Can't pop from empty array");
+        --_count;
+    }
+
+    constexpr void clear() noexcept {
+        _count = 0;
+    }
+
+    template<u32 I>
+    std::span<ColumnType<I>> column() noexcept {
+        return { std::get<I>(_columns), _count };
+    }
+
+    template<u32 I>
+    std::span<const ColumnType<I>> column() const noexcept {
+        return { std::get<I>(_columns), _count };
+    }
+
+    template<u32 I>
+    ColumnType<I>& get(u32 index) noexcept {
+        SF_ASSERT_MSG(index < _count, "Out of bounds");
+        return std::get<I>(_columns)[index];
+    }
+
+    template<u32 I>
+    const ColumnType<I>& get(u32 index) const noexcept {
+        SF_ASSERT_MSG(index < _count, "Out of bounds");
+        return std::get<I>(_columns)[index];
+    }
+
+    // fn(Ts&... fields, u32 index), walks all columns of a row together
+    template<typename Fn>
+    void for_each(Fn&& fn) noexcept {
+        std::apply([&fn, this](Ts*... columns) {
+            for (u32 i{0}; i < _count; ++i) {
+                fn(columns[i]..., i);
+            }
+        }, _columns);
+    }
+
+    constexpr u32 count() const noexcept { return _count; }
+    constexpr u32 capacity() const noexcept { return _capacity; }
+    constexpr bool is_empty() const noexcept { return _count == 0; }
+
+private:
+    static constexpr usize align_column(usize offset) {
+        return (offset + (COLUMN_ALIGNMENT - 1)) & ~static_cast<usize>(COLUMN_ALIGNMENT - 1);
+    }
+
+    void* block() const noexcept {
+        return static_cast<void*>(std::get<0>(_columns));
+    }
+
+    template<typename T>
+    static void fill_column(T* from, u32 count) noexcept {
+        for (u32 i{0}; i < count; ++i) {
+            from[i] = T{};
+        }
+    }
+
+    template<usize ...Is>
+    void append_impl(u32 index, std::index_sequence<Is...>, const Ts&... values) noexcept {
+        ((std::get<Is>(_columns)[index] = values), ...);
+    }
+
+    // returns index of the first added row, INVALID_ID if grow failed and nothing was added
+    u32 move_forward(u32 add_count) noexcept {
+        if (_count + add_count > _capacity) {
+            u32 new_capacity = _capacity == 0 ? add_count : _capacity * 2;
+            while (new_capacity < _count + add_count) {
+                new_capacity *= 2;
+            }
+            if (!grow(new_capacity)) {
+                return INVALID_ID;
+            }
+        }
+        const u32 first = _count;
+        _count += add_count;
+        return first;
+    }
+
+    // columns move to different offsets when capacity changes, so block is reallocated by hand
+    bool grow(u32 new_capacity) noexcept {
+        SF_ASSERT_MSG(_allocator, "SoaArray: allocator should be set to grow");
+        if (!_allocator) {
+            return false;
+        }
+
+        u8* new_block = static_cast<u8*>(_allocator->allocate(memory_requirement(new_capacity), COLUMN_ALIGNMENT));
+        if (!new_block) {
+            LOG_ERROR("SoaArray: failed to allocate {} bytes", memory_requirement(new_capacity));
+            return false;
+        }
+
+        std::tuple<Ts*...> new_columns;
+        usize offset{0};
+        std::apply([&offset, new_block, new_capacity](auto*&... columns) {
+            ((columns = reinterpret_cast<std::remove_reference_t<decltype(columns)>>(new_block + align_column(offset)),
+                offset = align_column(offset) + sizeof(*columns) * new_capacity), ...);
+        }, new_columns);
+
+        if (block()) {
+            if (_count > 0) {
+                copy_columns(new_columns, std::index_sequence_for<Ts...>{});
+            }
+            _allocator->free(block());
+        }
+
+        _columns = new_columns;
+        _capacity = new_capacity;
+        return true;
+    }
+
+    template<usize ...Is>
+    void copy_columns(std::tuple<Ts*...>& dst, std::index_sequence<Is...>) noexcept {
+        (sf_mem_copy(std::get<Is>(dst), std::get<Is>(_columns), _count * sizeof(Ts)), ...);
+    }
+}; // SoaArray
+
+} // sf
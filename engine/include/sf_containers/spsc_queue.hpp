@@ -0,0 +1,135 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <span>
+#include <type_traits>
+
+namespace sf {
+
+// Bounded lock-free ring for exactly one producer and one consumer thread.
+// Head and tail live on their own cache lines, each side also keeps a cached copy of the other index,
+// so the shared line is only read when the cached one says the ring is full/empty.
+// Indices run freely and wrap, capacity is rounded up to a power of 2.
+template<typename T, AllocatorTrait Allocator = GeneralPurposeAllocator>
+struct SpscQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue elements should be trivially copyable");
+private:
+    // consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<u32>   _head;
+    u32                                         _cached_tail;
+    // producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<u32>   _tail;
+    u32                                         _cached_head;
+    // read only after creation
+    alignas(CACHE_LINE_SIZE) Allocator*         _allocator;
+    T*                                          _buffer;
+    u32                                         _mask;
+
+public:
+    explicit SpscQueue(u32 capacity, Allocator* allocator) noexcept
+        : _head{ 0 }
+        , _cached_tail{ 0 }
+        , _tail{ 0 }
+        , _cached_head{ 0 }
+        , _allocator{ allocator }
+        , _buffer{ nullptr }
+        , _mask{ 0 }
+    {
+        SF_ASSERT_MSG(allocator, "SpscQueue: allocator should be valid pointer");
+        SF_ASSERT_MSG(capacity > 0 && capacity <= (1u << 31), "SpscQueue: invalid capacity");
+        capacity = std::bit_ceil(capacity);
+        _buffer = static_cast<T*>(_allocator->allocate(capacity * sizeof(T), alignof(T)));
+        _mask = capacity - 1;
+    }
+
+    SpscQueue(const SpscQueue& rhs) = delete;
+    SpscQueue& operator=(const SpscQueue& rhs) = delete;
+
+    ~SpscQueue() noexcept
+    {
+        _allocator->free(_buffer);
+    }
+
+    // producer only, false if full
+    bool push(const T& item) noexcept {
+        return push_batch({ &item, 1 }) == 1;
+    }
+
+    // producer only, returns how many items from the front of 'items' were pushed
+    u32 push_batch(std::span<const T> items) noexcept {
+        const u32 tail = _tail.load(std::memory_order_relaxed);
+        u32 free_count = capacity() - (tail - _cached_head);
+        if (free_count < items.size()) {
+            _cached_head = _head.load(std::memory_order_acquire);
+            free_count = capacity() - (tail - _cached_head);
+        }
+
+        const u32 push_count = std::min(free_count, static_cast<u32>(items.size()));
+        if (push_count == 0) {
+            return 0;
+        }
+        copy_in(tail, items.data(), push_count);
+        _tail.store(tail + push_count, std::memory_order_release);
+        return push_count;
+    }
+
+    // consumer only, false if empty
+    bool pop(T& out_item) noexcept {
+        return pop_batch({ &out_item, 1 }) == 1;
+    }
+
+    // consumer only, returns how many items were written to the front of 'out_items'
+    u32 pop_batch(std::span<T> out_items) noexcept {
+        const u32 head = _head.load(std::memory_order_relaxed);
+        u32 ready_count = _cached_tail - head;
+        if (ready_count < out_items.size()) {
+            _cached_tail = _tail.load(std::memory_order_acquire);
+            ready_count = _cached_tail - head;
+        }
+
+        const u32 pop_count = std::min(ready_count, static_cast<u32>(out_items.size()));
+        if (pop_count == 0) {
+            return 0;
+        }
+        copy_out(head, out_items.data(), pop_count);
+        _head.store(head + pop_count, std::memory_order_release);
+        return pop_count;
+    }
+
+    // approximate when called while the other side is running
+    u32 count() const noexcept {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+    u32 capacity() const noexcept { return _mask + 1; }
+
+private:
+    // range may wrap around the end of the buffer
+    void copy_in(u32 index, const T* src, u32 item_count) noexcept {
+        const u32 first = index & _mask;
+        const u32 first_part = std::min(item_count, capacity() - first);
+        sf_mem_copy((void*)(_buffer + first), (void*)src, first_part * sizeof(T));
+        if (first_part < item_count) {
+            sf_mem_copy((void*)_buffer, (void*)(src + first_part), (item_count - first_part) * sizeof(T));
+        }
+    }
+
+    void copy_out(u32 index, T* dst, u32 item_count) noexcept {
+        const u32 first = index & _mask;
+        const u32 first_part = std::min(item_count, capacity() - first);
+        sf_mem_copy((void*)dst, (void*)(_buffer + first), first_part * sizeof(T));
+        if (first_part < item_count) {
+            sf_mem_copy((void*)(dst + first_part), (void*)_buffer, (item_count - first_part) * sizeof(T));
+        }
+    }
+}; // SpscQueue
+
+} // sf
@@ -0,0 +1,650 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/hashmap.hpp"
+#include "sf_containers/optional.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/utility.hpp"
+#include <bit>
+#include <memory>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SF_SWISS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SF_SWISS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace sf {
+
+// control byte per slot, full slot stores low 7 bits of the key hash, so the high bit is clear
+static constexpr u8 SWISS_CTRL_EMPTY{ 0x80 };
+static constexpr u8 SWISS_CTRL_DELETED{ 0xFE };
+
+constexpr bool swiss_ctrl_is_full(u8 ctrl) {
+    return (ctrl & 0x80) == 0;
+}
+
+// matched slots of the group, one bit per slot (one nibble with NEON)
+struct SwissBitMask {
+#ifdef SF_SWISS_NEON
+    static constexpr u32 SHIFT{ 2 };
+#else
+    static constexpr u32 SHIFT{ 0 };
+#endif
+    u64 bits;
+
+    bool any() const { return bits != 0; }
+    u32 lowest() const { return static_cast<u32>(std::countr_zero(bits)) >> SHIFT; }
+    void clear_lowest() { bits &= bits - 1; }
+};
+
+// 16 control bytes checked at once, groups are aligned to their width
+struct SwissGroup {
+    static constexpr u32 WIDTH{ 16 };
+
+#if defined(SF_SWISS_SSE2)
+    __m128i ctrl;
+
+    explicit SwissGroup(const u8* group_start)
+        : ctrl{ _mm_load_si128(reinterpret_cast<const __m128i*>(group_start)) }
+    {}
+
+    SwissBitMask match(u8 h2) const {
+        return { static_cast<u64>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<i8>(h2))))) };
+    }
+
+    // empty and deleted are the only negative values
+    SwissBitMask match_empty_or_deleted() const {
+        return { static_cast<u64>(_mm_movemask_epi8(ctrl)) };
+    }
+#elif defined(SF_SWISS_NEON)
+    uint8x16_t ctrl;
+
+    explicit SwissGroup(const u8* group_start)
+        : ctrl{ vld1q_u8(group_start) }
+    {}
+
+    // narrows 0xFF/0x00 bytes to nibbles, keeps one bit of each
+    static SwissBitMask to_mask(uint8x16_t cmp) {
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+        return { vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull };
+    }
+
+    SwissBitMask match(u8 h2) const {
+        return to_mask(vceqq_u8(ctrl, vdupq_n_u8(h2)));
+    }
+
+    SwissBitMask match_empty_or_deleted() const {
+        return to_mask(vcltq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0)));
+    }
+#else
+    const u8* ctrl;
+
+    explicit SwissGroup(const u8* group_start)
+        : ctrl{ group_start }
+    {}
+
+    SwissBitMask match(u8 h2) const {
+        u64 bits{0};
+        for (u32 i{0}; i < WIDTH; ++i) {
+            bits |= static_cast<u64>(ctrl[i] == h2) << i;
+        }
+        return { bits };
+    }
+
+    SwissBitMask match_empty_or_deleted() const {
+        u64 bits{0};
+        for (u32 i{0}; i < WIDTH; ++i) {
+            bits |= static_cast<u64>(!swiss_ctrl_is_full(ctrl[i])) << i;
+        }
+        return { bits };
+    }
+#endif
+
+    SwissBitMask match_empty() const {
+        return match(SWISS_CTRL_EMPTY);
+    }
+};
+
+// Open addressing map with a separate control byte array (SwissTable layout).
+// Lookup compares 7 bit hash fragments of a whole group with one SIMD instruction
+// and touches keys only on fragment match, probing goes group by group (triangular steps over power of two group count).
+// Removal leaves a tombstone only when the group is full, tombstones are purged by rehash in place.
+// Buffer: [control bytes: capacity][buckets: capacity], one allocation.
+template<typename K, typename V, AllocatorTrait Allocator = GeneralPurposeAllocator, bool USE_HANDLE = true, u32 DEFAULT_INIT_CAPACITY = SwissGroup::WIDTH>
+struct SwissHashMap {
+    static_assert(std::has_single_bit(DEFAULT_INIT_CAPACITY) && DEFAULT_INIT_CAPACITY >= SwissGroup::WIDTH, "Capacity should be power of two, not less than group width");
+public:
+    using KeyType = K;
+    using ValueType = V;
+
+    struct Bucket {
+        K key;
+        V value;
+    };
+
+    union Data {
+        u8*     ptr;
+        usize   handle;
+    };
+
+    struct Iterator {
+    private:
+        u8*     _ctrl;
+        Bucket* _buckets;
+        u32     _index;
+        u32     _capacity;
+
+    public:
+        Iterator(u8* ctrl, Bucket* buckets, u32 index, u32 capacity)
+            : _ctrl{ ctrl }
+            , _buckets{ buckets }
+            , _index{ index }
+            , _capacity{ capacity }
+        {
+            skip_not_full();
+        }
+
+        Bucket& operator*() const { return _buckets[_index]; }
+        Bucket* operator->() const { return &_buckets[_index]; }
+
+        Iterator& operator++() {
+            ++_index;
+            skip_not_full();
+            return *this;
+        }
+
+        friend bool operator==(const Iterator& first, const Iterator& second) {
+            return first._index == second._index;
+        }
+
+        friend bool operator!=(const Iterator& first, const Iterator& second) {
+            return first._index != second._index;
+        }
+
+    private:
+        void skip_not_full() {
+            while (_index < _capacity && !swiss_ctrl_is_full(_ctrl[_index])) {
+                ++_index;
+            }
+        }
+    };
+
+private:
+    static constexpr u16 BUFFER_ALIGNMENT = alignof(Bucket) > SwissGroup::WIDTH ? alignof(Bucket) : SwissGroup::WIDTH;
+
+    Allocator*          _allocator;
+    Data                _data;
+    // 0 or power of two
+    u32                 _capacity;
+    u32                 _count;
+    // inserts into empty slots left before rehash, tombstones don't give it back
+    u32                 _growth_left;
+    HashMapConfig<K>    _config;
+
+public:
+    SwissHashMap()
+        : _allocator{nullptr}
+        , _capacity{0}
+        , _count{0}
+        , _growth_left{0}
+        , _config{ get_default_config<K>() }
+    {
+        reset_data();
+    }
+
+    SwissHashMap(Allocator* allocator)
+        : _allocator{allocator}
+        , _capacity{0}
+        , _count{0}
+        , _growth_left{0}
+        , _config{ get_default_config<K>() }
+    {
+        reset_data();
+    }
+
+    // room for 'prealloc_count' entries without rehash
+    SwissHashMap(u32 prealloc_count, Allocator* allocator, const HashMapConfig<K>& config = get_default_config<K>())
+        : _allocator{allocator}
+        , _capacity{0}
+        , _count{0}
+        , _growth_left{0}
+        , _config{config}
+    {
+        reset_data();
+        reserve(prealloc_count);
+    }
+
+    SwissHashMap(SwissHashMap&& rhs) noexcept
+        : _allocator{rhs._allocator}
+        , _data{rhs._data}
+        , _capacity{rhs._capacity}
+        , _count{rhs._count}
+        , _growth_left{rhs._growth_left}
+        , _config{rhs._config}
+    {
+        rhs.reset_data();
+        rhs._capacity = 0;
+        rhs._count = 0;
+        rhs._growth_left = 0;
+    }
+
+    SwissHashMap& operator=(SwissHashMap&& rhs) noexcept
+    {
+        if (this == &rhs) {
+            return *this;
+        }
+
+        free();
+
+        _allocator = rhs._allocator;
+        _data = rhs._data;
+        _capacity = rhs._capacity;
+        _count = rhs._count;
+        _growth_left = rhs._growth_left;
+        _config = rhs._config;
+
+        rhs.reset_data();
+        rhs._capacity = 0;
+        rhs._count = 0;
+        rhs._growth_left = 0;
+        return *this;
+    }
+
+    SwissHashMap(const SwissHashMap& rhs) = delete;
+    SwissHashMap& operator=(const SwissHashMap& rhs) = delete;
+
+    ~SwissHashMap() noexcept {
+        free();
+    }
+
+    // bytes of the buffer which 'reserve(count)' allocates
+    static constexpr usize memory_requirement(u32 count, f32 load_factor = 0.8f) {
+        return buffer_size(capacity_for_count(count, load_factor));
+    }
+
+    void free() noexcept {
+        if (_capacity == 0) {
+            return;
+        }
+
+        destroy_buckets();
+        if constexpr (USE_HANDLE) {
+            _allocator->free_handle(_data.handle);
+        } else {
+            _allocator->free(_data.ptr);
+        }
+        reset_data();
+        _capacity = 0;
+        _count = 0;
+        _growth_left = 0;
+    }
+
+    void set_allocator(Allocator* alloc) noexcept {
+        SF_ASSERT_MSG(alloc, "Should be valid pointer");
+        _allocator = alloc;
+    }
+
+    // updates entry with the same key
+    template<typename Key, typename Val>
+    requires SameTypes<K, Key> && SameTypes<V, Val>
+    void put(Key&& key, Val&& val) noexcept {
+        SF_ASSERT_MSG(_allocator, "Should be valid pointer");
+        const u64 hash = _config.hash_fn(key);
+        const u32 index = find_index(key, hash);
+
+        if (index != INVALID_ID) {
+            buckets()[index].value = std::forward<Val>(val);
+            return;
+        }
+
+        insert_new(prepare_insert(hash, true), hash, std::forward<Key>(key), std::forward<Val>(val));
+    }
+
+    // put without resize, if can
+    template<typename Key, typename Val>
+    requires SameTypes<K, Key> && SameTypes<V, Val>
+    bool put_assume_capacity(Key&& key, Val&& val) noexcept {
+        const u64 hash = _config.hash_fn(key);
+        const u32 index = find_index(key, hash);
+
+        if (index != INVALID_ID) {
+            buckets()[index].value = std::forward<Val>(val);
+            return true;
+        }
+
+        const u32 target = prepare_insert(hash, false);
+        if (target == INVALID_ID) {
+            LOG_ERROR("Not enough capacity in SwissHashMap");
+            return false;
+        }
+
+        insert_new(target, hash, std::forward<Key>(key), std::forward<Val>(val));
+        return true;
+    }
+
+    // put without update
+    template<typename Key, typename Val>
+    requires SameTypes<K, Key> && SameTypes<V, Val>
+    bool put_if_empty(Key&& key, Val&& val) noexcept {
+        SF_ASSERT_MSG(_allocator, "Should be valid pointer");
+        const u64 hash = _config.hash_fn(key);
+
+        if (find_index(key, hash) != INVALID_ID) {
+            return false;
+        }
+
+        insert_new(prepare_insert(hash, true), hash, std::forward<Key>(key), std::forward<Val>(val));
+        return true;
+    }
+
+    Option<V*> get(ConstLRefOrValType<K> key) noexcept {
+        const u32 index = find_index(key, _config.hash_fn(key));
+        if (index == INVALID_ID) {
+            return {None::VALUE};
+        }
+
+        return &buckets()[index].value;
+    }
+
+    bool remove(ConstLRefOrValType<K> key) noexcept {
+        const u32 index = find_index(key, _config.hash_fn(key));
+        if (index == INVALID_ID) {
+            return false;
+        }
+
+        u8* ctrl = access_data();
+        std::destroy_at(&buckets()[index]);
+        --_count;
+
+        // probe stops at the first group with an empty slot, so no key was probed past this group
+        if (SwissGroup(ctrl + group_start(index)).match_empty().any()) {
+            ctrl[index] = SWISS_CTRL_EMPTY;
+            ++_growth_left;
+        } else {
+            ctrl[index] = SWISS_CTRL_DELETED;
+        }
+
+        return true;
+    }
+
+    // room for 'count' entries without rehash
+    void reserve(u32 count) noexcept {
+        SF_ASSERT_MSG(_allocator, "Allocator should be set");
+
+        const u32 new_capacity = capacity_for_count(count, _config.load_factor);
+        if (new_capacity > _capacity) {
+            resize(new_capacity);
+        }
+    }
+
+    // removes entries, keeps the buffer
+    void clear() noexcept {
+        if (_capacity == 0) {
+            return;
+        }
+
+        destroy_buckets();
+        sf_mem_set(access_data(), _capacity, SWISS_CTRL_EMPTY);
+        _count = 0;
+        _growth_left = max_load(_capacity);
+    }
+
+    u32 count() const { return _count; }
+    u32 capacity() const { return _capacity; }
+    bool is_empty() const { return _count == 0; }
+
+    Iterator begin() noexcept {
+        return _capacity == 0 ? end() : Iterator(access_data(), buckets(), 0, _capacity);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(nullptr, nullptr, _capacity, _capacity);
+    }
+
+private:
+    static constexpr usize buckets_offset(u32 capacity) {
+        return (static_cast<usize>(capacity) + alignof(Bucket) - 1) & ~(static_cast<usize>(alignof(Bucket)) - 1);
+    }
+
+    static constexpr usize buffer_size(u32 capacity) {
+        return buckets_offset(capacity) + static_cast<usize>(capacity) * sizeof(Bucket);
+    }
+
+    // at least one slot stays empty, so probing always ends
+    static constexpr u32 max_load(u32 capacity, f32 load_factor) {
+        const u32 load = static_cast<u32>(capacity * load_factor);
+        return load < capacity ? load : capacity - 1;
+    }
+
+    static constexpr u32 capacity_for_count(u32 count, f32 load_factor) {
+        u32 capacity = DEFAULT_INIT_CAPACITY;
+        while (max_load(capacity, load_factor) < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    static constexpr u32 group_start(u32 index) {
+        return index & ~(SwissGroup::WIDTH - 1);
+    }
+
+    // low 7 bits pick the slot inside the group, the rest pick the group
+    static constexpr u8 hash_h2(u64 hash) {
+        return static_cast<u8>(hash & 0x7F);
+    }
+
+    u32 max_load(u32 capacity) const {
+        return max_load(capacity, _config.load_factor);
+    }
+
+    void reset_data() {
+        if constexpr (USE_HANDLE) {
+            _data.handle = INVALID_ALLOC_HANDLE;
+        } else {
+            _data.ptr = nullptr;
+        }
+    }
+
+    u8* access_data() const {
+        if constexpr (USE_HANDLE) {
+            return static_cast<u8*>(_allocator->handle_to_ptr(_data.handle));
+        } else {
+            return _data.ptr;
+        }
+    }
+
+    Bucket* buckets() const {
+        return reinterpret_cast<Bucket*>(access_data() + buckets_offset(_capacity));
+    }
+
+    // calls 'fn(group_offset)' for groups of the probe sequence until it returns true
+    template<typename Fn>
+    void probe(u64 hash, Fn&& fn) const {
+        const u32 group_mask = _capacity / SwissGroup::WIDTH - 1;
+        u32 group = static_cast<u32>(hash >> 7) & group_mask;
+
+        for (u32 step{1}; !fn(group * SwissGroup::WIDTH); ++step) {
+            group = (group + step) & group_mask;
+        }
+    }
+
+    u32 find_index(ConstLRefOrValType<K> key, u64 hash) const {
+        if (_count == 0) {
+            return INVALID_ID;
+        }
+
+        const u8* ctrl = access_data();
+        const Bucket* data = buckets();
+        const u8 h2 = hash_h2(hash);
+        u32 result = INVALID_ID;
+
+        probe(hash, [&](u32 offset) {
+            const SwissGroup group(ctrl + offset);
+            for (SwissBitMask match = group.match(h2); match.any(); match.clear_lowest()) {
+                const u32 index = offset + match.lowest();
+                if (_config.equal_fn(key, data[index].key)) {
+                    result = index;
+                    return true;
+                }
+            }
+            return group.match_empty().any();
+        });
+
+        return result;
+    }
+
+    u32 find_first_non_full(u64 hash) const {
+        const u8* ctrl = access_data();
+        u32 result = INVALID_ID;
+
+        probe(hash, [&](u32 offset) {
+            const SwissBitMask match = SwissGroup(ctrl + offset).match_empty_or_deleted();
+            if (match.any()) {
+                result = offset + match.lowest();
+                return true;
+            }
+            return false;
+        });
+
+        return result;
+    }
+
+    // slot for a new key, rehashes when empty slots run out, INVALID_ID if it has to grow and 'can_grow' is false
+    u32 prepare_insert(u64 hash, bool can_grow) {
+        u32 target = _capacity > 0 ? find_first_non_full(hash) : INVALID_ID;
+        if (_growth_left > 0 || (target != INVALID_ID && access_data()[target] == SWISS_CTRL_DELETED)) {
+            return target;
+        }
+
+        // mostly tombstones, purging them is enough
+        if (_capacity > 0 && _count <= max_load(_capacity) / 2) {
+            drop_deleted_without_resize();
+        } else if (can_grow) {
+            const u32 grown = static_cast<u32>(_capacity * _config.grow_factor);
+            resize(std::max(std::bit_ceil(grown), DEFAULT_INIT_CAPACITY));
+        } else {
+            return INVALID_ID;
+        }
+
+        return find_first_non_full(hash);
+    }
+
+    template<typename Key, typename Val>
+    void insert_new(u32 index, u64 hash, Key&& key, Val&& val) {
+        u8* ctrl = access_data();
+        _growth_left -= ctrl[index] == SWISS_CTRL_EMPTY;
+        ctrl[index] = hash_h2(hash);
+        std::construct_at(&buckets()[index], Bucket{ .key = std::forward<Key>(key), .value = std::forward<Val>(val) });
+        ++_count;
+    }
+
+    void destroy_buckets() {
+        if constexpr (!std::is_trivially_destructible_v<Bucket>) {
+            const u8* ctrl = access_data();
+            Bucket* data = buckets();
+            for (u32 i{0}; i < _capacity; ++i) {
+                if (swiss_ctrl_is_full(ctrl[i])) {
+                    std::destroy_at(&data[i]);
+                }
+            }
+        }
+    }
+
+    void resize(u32 new_capacity) noexcept {
+        SF_ASSERT_MSG(_allocator, "Should be valid pointer");
+
+        const Data old_data = _data;
+        const u32 old_capacity = _capacity;
+
+        if constexpr (USE_HANDLE) {
+            _data.handle = _allocator->allocate_handle(buffer_size(new_capacity), BUFFER_ALIGNMENT);
+        } else {
+            _data.ptr = static_cast<u8*>(_allocator->allocate(buffer_size(new_capacity), BUFFER_ALIGNMENT));
+        }
+        _capacity = new_capacity;
+        _growth_left = max_load(new_capacity) - _count;
+        sf_mem_set(access_data(), new_capacity, SWISS_CTRL_EMPTY);
+
+        if (old_capacity == 0) {
+            return;
+        }
+
+        // allocation could move the old buffer, it's resolved only now
+        u8* old_ctrl;
+        if constexpr (USE_HANDLE) {
+            old_ctrl = static_cast<u8*>(_allocator->handle_to_ptr(old_data.handle));
+        } else {
+            old_ctrl = old_data.ptr;
+        }
+        Bucket* old_buckets = reinterpret_cast<Bucket*>(old_ctrl + buckets_offset(old_capacity));
+        u8* ctrl = access_data();
+        Bucket* data = buckets();
+
+        for (u32 i{0}; i < old_capacity; ++i) {
+            if (!swiss_ctrl_is_full(old_ctrl[i])) {
+                continue;
+            }
+            const u64 hash = _config.hash_fn(old_buckets[i].key);
+            const u32 target = find_first_non_full(hash);
+            ctrl[target] = hash_h2(hash);
+            std::construct_at(&data[target], std::move(old_buckets[i]));
+            std::destroy_at(&old_buckets[i]);
+        }
+
+        if constexpr (USE_HANDLE) {
+            _allocator->free_handle(old_data.handle);
+        } else {
+            _allocator->free(old_data.ptr);
+        }
+    }
+
+    void drop_deleted_without_resize() noexcept {
+        u8* ctrl = access_data();
+        Bucket* data = buckets();
+
+        // full -> deleted (not placed yet), deleted -> empty
+        for (u32 i{0}; i < _capacity; ++i) {
+            ctrl[i] = swiss_ctrl_is_full(ctrl[i]) ? SWISS_CTRL_DELETED : SWISS_CTRL_EMPTY;
+        }
+
+        u32 i{0};
+        while (i < _capacity) {
+            if (ctrl[i] != SWISS_CTRL_DELETED) {
+                ++i;
+                continue;
+            }
+
+            const u64 hash = _config.hash_fn(data[i].key);
+            const u32 target = find_first_non_full(hash);
+
+            // no free slot before this group in the probe sequence, entry stays
+            if (group_start(target) == group_start(i)) {
+                ctrl[i] = hash_h2(hash);
+                ++i;
+            } else if (ctrl[target] == SWISS_CTRL_EMPTY) {
+                ctrl[target] = hash_h2(hash);
+                std::construct_at(&data[target], std::move(data[i]));
+                std::destroy_at(&data[i]);
+                ctrl[i] = SWISS_CTRL_EMPTY;
+                ++i;
+            } else {
+                // target holds another entry which isn't placed yet, swap and place that one next
+                ctrl[target] = hash_h2(hash);
+                std::swap(data[i], data[target]);
+            }
+        }
+
+        _growth_left = max_load(_capacity) - _count;
+    }
+};
+
+} // sf
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "sf_allocators/arena_allocator.hpp"
+#include "sf_allocators/frame_allocator.hpp"
 #include "sf_allocators/general_purpose_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
+#include "sf_core/async_io.hpp"
 #include "sf_core/defines.hpp"
 #include "sf_core/clock.hpp"
 #include "sf_core/event.hpp"
+#include "sf_core/job_system.hpp"
 #include "sf_platform/platform.hpp"
 #include "sf_vulkan/material.hpp"
 #include "sf_vulkan/mesh.hpp"
@@ -18,6 +21,8 @@ struct ApplicationConfig {
     u16         window_y;
     u16         window_width;
     u16         window_height;
+    // logs every frame which allocates after warmup, only has effect with SF_MEMORY_TRACKING
+    bool        expect_zero_frame_allocs;
 };
 
 struct GameInstance;
@@ -27,7 +32,10 @@ public:
     static constexpr f64 TARGET_FRAME_SECONDS = 1.0 / 60.0;
     ArenaAllocator              main_allocator;
     StackAllocator              temp_allocator;
+    FrameAllocator              frame_allocator;
     GeneralPurposeAllocator     gpa;
+    AsyncIoSystem               async_io;
+    JobSystem                   job_system;
     EventSystem                 event_system;
     TextureSystem               texture_system;
     MaterialSystem              material_system;
@@ -50,7 +58,10 @@ bool application_on_mouse(u8 code, void* sender, void* listener_inst, Option<Eve
 bool application_on_key(u8 code, void* sender, void* listener_inst, Option<EventContext> context);
 ArenaAllocator& application_get_main_allocator();
 StackAllocator& application_get_temp_allocator();
+// scratch memory which is valid until the end of the next frame, no need to free it
+FrameAllocator& application_get_frame_allocator();
 GeneralPurposeAllocator& application_get_gpa();
+JobSystem& application_get_job_system();
 
 }
 
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "sf_containers/optional.hpp"
+#include "sf_core/defines.hpp"
+#include <atomic>
+#include <span>
+
+namespace sf {
+
+enum struct IoPriority : u8 {
+    // needed for the current frame
+    HIGH,
+    NORMAL,
+    // prefetch, only runs when nothing else waits
+    LOW,
+    COUNT
+};
+
+enum struct IoStatus : u8 {
+    PENDING,
+    DONE,
+    FAILED
+};
+
+enum struct AsyncIoBackend : u8 {
+    IO_URING,
+    THREAD_POOL
+};
+
+struct IoRequest;
+
+// runs on the I/O thread which completed the request, heavy work (decoding) should go to the job system
+using IoCallback = void(*)(IoRequest& request);
+
+// Read of 'size' bytes at 'offset' into 'buffer', which is owned by the caller and can be mapped staging memory.
+// Request is its own future: it and 'path' should stay alive until 'status' leaves PENDING.
+// Reading past the end of the file is not an error, 'bytes_read' tells how much was read.
+struct IoRequest {
+public:
+    const char*             path;
+    void*                   buffer;
+    u64                     offset;
+    u32                     size;
+    IoPriority              priority;
+    IoCallback              callback;
+    void*                   user_data;
+
+    std::atomic<IoStatus>   status;
+    u32                     bytes_read;
+    // errno of the step which failed
+    i32                     error;
+
+    // owned by the I/O system while pending
+    IoRequest*              next;
+    i32                     fd;
+    u8                      stage;
+
+public:
+    IoRequest() noexcept;
+    IoRequest(const char* path, void* buffer, u32 size, u64 offset = 0, IoPriority priority = IoPriority::NORMAL) noexcept;
+    IoRequest(const IoRequest& rhs) = delete;
+    IoRequest& operator=(const IoRequest& rhs) = delete;
+
+    bool is_done() const noexcept { return status.load(std::memory_order_acquire) != IoStatus::PENDING; }
+    // blocks until the request completes, true if it succeeded
+    bool wait() const noexcept;
+};
+
+struct IoUringState;
+struct IoPoolState;
+
+// Asynchronous file reads. On Linux requests go through io_uring: open and read are queued to the kernel
+// and one completion thread reaps them, chaining the read after the open. If io_uring is unavailable
+// (old kernel, seccomp, other platforms) a small thread pool runs blocking pread.
+// Requests wait in a queue per priority, higher classes go to the kernel/pool first,
+// io_uring also gets the class as ioprio.
+struct AsyncIoSystem {
+public:
+    static constexpr u32 RING_ENTRY_COUNT{ 256 };
+    // requests handed to the kernel at once, the rest waits in priority queues
+    static constexpr u32 MAX_IN_FLIGHT_COUNT{ 128 };
+    static constexpr u32 POOL_THREAD_COUNT{ 4 };
+private:
+    IoUringState*       _uring;
+    IoPoolState*        _pool;
+    AsyncIoBackend      _backend;
+
+public:
+    AsyncIoSystem() noexcept;
+    AsyncIoSystem(const AsyncIoSystem& rhs) = delete;
+    AsyncIoSystem& operator=(const AsyncIoSystem& rhs) = delete;
+    ~AsyncIoSystem() noexcept;
+
+    // falls back to the thread pool if 'preferred' backend can't be started
+    static bool create(AsyncIoBackend preferred, AsyncIoSystem& out_system);
+    // waits for requests in flight
+    void destroy() noexcept;
+
+    void submit(IoRequest& request) noexcept;
+    // one lock and one kernel call for the whole batch
+    void submit_batch(std::span<IoRequest* const> requests) noexcept;
+
+    AsyncIoBackend backend() const noexcept { return _backend; }
+};
+
+// size of the file, None if it can't be opened
+Option<u64> io_file_size(const char* path) noexcept;
+// through the last created AsyncIoSystem, requests run synchronously on the calling thread when there is none
+void io_submit(IoRequest& request) noexcept;
+void io_submit_batch(std::span<IoRequest* const> requests) noexcept;
+// submits and waits, true if the request succeeded
+bool io_read_blocking(IoRequest& request) noexcept;
+
+} // sf
@@ -10,6 +10,8 @@ inline constexpr u32 INVALID_ID{ UINT_MAX };
 inline constexpr u32 INVALID_ALLOC_HANDLE{ UINT_MAX };
 inline constexpr u32 VK_MAX_EXTENSION_COUNT{ 10 };
 inline constexpr u32 MAX_FILE_NAME_LEN{ 100 };
+// keeps data written by different threads on different lines
+inline constexpr usize CACHE_LINE_SIZE{ 64 };
 inline constexpr std::string_view TEXTURE_ASSETS_PATH{ "build/debug/engine/assets/textures/" };
 inline constexpr std::string_view MODEL_ASSETS_PATH{ "build/debug/engine/assets/models/" };
 inline constexpr std::string_view MATERIAL_ASSETS_PATH{ "build/debug/engine/assets/materials/" };
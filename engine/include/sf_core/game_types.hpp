@@ -3,6 +3,7 @@
 #include "sf_core/application.hpp"
 #include "sf_allocators/linear_allocator.hpp"
 #include "sf_core/constants.hpp"
+#include "sf_core/job_system.hpp"
 
 namespace sf {
 struct GameInstance {
@@ -20,10 +21,13 @@ public:
     LinearAllocator   allocator;
     ApplicationConfig app_config;
     u32 game_state_handle;
+    // set by application_create before 'init', update/render work can be split into jobs through it
+    JobSystem* job_system;
 
 public:
     GameInstance(LinearAllocator&& allocator)
         : allocator{ std::move(allocator) }
+        , job_system{ nullptr }
     {}
 
     ~GameInstance()
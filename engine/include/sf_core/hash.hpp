@@ -0,0 +1,139 @@
+#pragma once
+
+#include "sf_core/defines.hpp"
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace sf {
+
+// wyhash (final 4), 48 bytes per step in 3 independent multiply lanes, short keys are 2 multiplies total.
+// Same result in constant evaluation and at runtime, so names hashed at compile time match runtime lookups.
+// Reads are little endian, hashes are not meant to be stored on disk.
+inline constexpr u64 HASH_SECRET[4]{ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+// full 64x64 -> 128 multiply, 'a' gets low and 'b' high half
+constexpr void hash_mum(u64& a, u64& b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<u64>(product);
+    b = static_cast<u64>(product >> 64);
+#else
+    if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER)
+        a = _umul128(a, b, &b);
+        return;
+#endif
+    }
+    const u64 a_hi = a >> 32, a_lo = static_cast<u32>(a);
+    const u64 b_hi = b >> 32, b_lo = static_cast<u32>(b);
+    const u64 hi_hi = a_hi * b_hi, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, lo_lo = a_lo * b_lo;
+    const u64 mid = lo_lo + (hi_lo << 32);
+    const u64 lo = mid + (lo_hi << 32);
+    a = lo;
+    b = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid < lo_lo) + (lo < mid);
+#endif
+}
+
+constexpr u64 hash_mix(u64 a, u64 b) {
+    hash_mum(a, b);
+    return a ^ b;
+}
+
+constexpr u64 hash_read8(const char* p) {
+    if (std::is_constant_evaluated()) {
+        u64 val{0};
+        for (u32 i{0}; i < 8; ++i) {
+            val |= static_cast<u64>(static_cast<u8>(p[i])) << (i * 8);
+        }
+        return val;
+    }
+    u64 val;
+    std::memcpy(&val, p, sizeof(val));
+    return val;
+}
+
+constexpr u64 hash_read4(const char* p) {
+    if (std::is_constant_evaluated()) {
+        u64 val{0};
+        for (u32 i{0}; i < 4; ++i) {
+            val |= static_cast<u64>(static_cast<u8>(p[i])) << (i * 8);
+        }
+        return val;
+    }
+    u32 val;
+    std::memcpy(&val, p, sizeof(val));
+    return val;
+}
+
+// 1-3 bytes, reads first, middle and last byte
+constexpr u64 hash_read3(const char* p, usize len) {
+    return (static_cast<u64>(static_cast<u8>(p[0])) << 16) | (static_cast<u64>(static_cast<u8>(p[len >> 1])) << 8) | static_cast<u8>(p[len - 1]);
+}
+
+constexpr u64 hash_bytes(const char* data, usize len, u64 seed = 0) {
+    const char* p = data;
+    seed ^= hash_mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    u64 a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            const usize quarter = (len >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + quarter);
+            b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - quarter);
+        } else if (len > 0) {
+            a = hash_read3(p, len);
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        usize remain = len;
+        if (remain >= 48) {
+            u64 seed_1 = seed;
+            u64 seed_2 = seed;
+            do {
+                seed = hash_mix(hash_read8(p) ^ HASH_SECRET[1], hash_read8(p + 8) ^ seed);
+                seed_1 = hash_mix(hash_read8(p + 16) ^ HASH_SECRET[2], hash_read8(p + 24) ^ seed_1);
+                seed_2 = hash_mix(hash_read8(p + 32) ^ HASH_SECRET[3], hash_read8(p + 40) ^ seed_2);
+                p += 48;
+                remain -= 48;
+            } while (remain >= 48);
+            seed ^= seed_1 ^ seed_2;
+        }
+        while (remain > 16) {
+            seed = hash_mix(hash_read8(p) ^ HASH_SECRET[1], hash_read8(p + 8) ^ seed);
+            p += 16;
+            remain -= 16;
+        }
+        // last 16 bytes, may overlap already consumed ones
+        a = hash_read8(p + remain - 16);
+        b = hash_read8(p + remain - 8);
+    }
+
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    hash_mum(a, b);
+    return hash_mix(a ^ HASH_SECRET[0] ^ len, b ^ HASH_SECRET[1]);
+}
+
+constexpr u64 hash_str(std::string_view str, u64 seed = 0) {
+    return hash_bytes(str.data(), str.size(), seed);
+}
+
+// single multiply mixer for keys up to 8 bytes, all bits of the result depend on all bits of the key
+constexpr u64 hash_u64(u64 key) {
+    return hash_mix(key ^ HASH_SECRET[0], HASH_SECRET[1]);
+}
+
+// forces compile time evaluation, for names written in source
+consteval u64 hash_str_ct(std::string_view str) {
+    return hash_str(str);
+}
+
+} // sf
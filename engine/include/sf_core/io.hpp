@@ -4,22 +4,28 @@
 #include "sf_containers/fixed_array.hpp"
 #include "sf_containers/result.hpp"
 #include "sf_containers/traits.hpp"
-#include <fstream>
+#include "sf_core/async_io.hpp"
 #include <string_view>
 
 namespace sf {
 
+// 'file_path' should be null terminated, read goes through the async I/O system and blocks until it's done.
+// Copies the whole file, consumers which only read it should map it with MappedFile instead
 template<AllocatorTrait Allocator>
 Result<String<Allocator>> read_file(std::string_view file_path, Allocator& allocator) noexcept {
-    std::ifstream file(file_path.data(), std::ios::ate | std::ios::binary);
-
-    if (!file.is_open()) {
+    Option<u64> file_size = io_file_size(file_path.data());
+    if (file_size.is_none()) {
         return {ResultError::VALUE};
     }
 
-    String<Allocator> file_contents(file.tellg(), file.tellg(), &allocator);
-    file.seekg(0, std::ios::beg);
-    file.read(file_contents.data(), static_cast<std::streamsize>(file_contents.count()));
+    const u32 size = static_cast<u32>(file_size.unwrap_copy());
+    String<Allocator> file_contents(size, size, &allocator);
+    if (size > 0) {
+        IoRequest request(file_path.data(), file_contents.data(), size);
+        if (!io_read_blocking(request) || request.bytes_read != size) {
+            return {ResultError::VALUE};
+        }
+    }
 
     return std::move(file_contents);
 }
@@ -50,6 +56,37 @@ std::string_view extract_extension_from_file_name(std::string_view file_name);
 std::string_view strip_extension_from_file_name(std::string_view file_name);
 std::string_view strip_file_name_from_path(std::string_view file_path);
 std::string_view trim_dir_and_extension_from_path(std::string_view file_path);
-std::string_view strip_part_from_start_and_extension(std::string_view file_path, std::string_view part);
+
+// constexpr, texture names are hashed from it at compile time
+constexpr std::string_view strip_part_from_start_and_extension(std::string_view file_path, std::string_view part) {
+    u32 part_sz{static_cast<u32>(part.size())};
+    u32 file_path_sz{static_cast<u32>(file_path.size())};
+
+    if (part_sz > file_path_sz) {
+        return file_path;
+    }
+
+    u32 from{0};
+
+    while (from < part_sz && file_path[from] == part[from]) {
+        ++from;
+    }
+
+    u32 curr{from};
+    u32 to{from};
+
+    while (curr < file_path_sz) {
+        if (file_path[curr] == '.') {
+            to = curr;   
+        }
+        ++curr;
+    }
+
+    if (to == from) {
+        to = file_path_sz;
+    }
+
+    return file_path.substr(from, to - from);
+}
 
 } // sf
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_allocators/stack_allocator.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include <atomic>
+#include <span>
+
+namespace sf {
+
+using JobFn = void(*)(void* data);
+
+struct Job {
+    JobFn   fn;
+    void*   data;
+};
+
+// Number of unfinished jobs of a batch, work which depends on the batch waits for it to reach zero.
+// One counter can be shared by several 'run' calls, it is incremented before the jobs are pushed.
+struct JobCounter {
+    std::atomic<u32> value{ 0 };
+
+    bool is_done() const noexcept { return value.load(std::memory_order_acquire) == 0; }
+};
+
+struct JobWorker;
+
+// Work-stealing job system, one worker per core, thread which creates it is worker 0.
+// Every worker owns a Chase-Lev deque: owner pushes and pops at the bottom without contention,
+// idle workers steal the oldest jobs from the top of other deques.
+// 'wait' doesn't block, the waiting thread runs other jobs until the counter reaches zero,
+// so jobs can wait on jobs they spawned.
+// Every job runs inside of a scope of its worker's scratch allocator, which is rewound when the job returns.
+struct JobSystem {
+public:
+    static constexpr u32 MAX_WORKER_COUNT{ 64 };
+    // jobs which don't fit into the deque of a full worker are run inline
+    static constexpr u32 DEQUE_CAPACITY{ 4096 };
+    // yields before idle worker goes to sleep
+    static constexpr u32 IDLE_SPIN_COUNT{ 64 };
+private:
+    GeneralPurposeAllocator*                    _allocator;
+    JobWorker*                                  _workers;
+    u32                                         _worker_count;
+    std::atomic<bool>                           _is_running;
+    // bumped on every push, idle workers sleep on it
+    alignas(CACHE_LINE_SIZE) std::atomic<u32>   _wake_epoch;
+    std::atomic<u32>                            _sleeping_count;
+
+public:
+    JobSystem() noexcept;
+    JobSystem(const JobSystem& rhs) = delete;
+    JobSystem& operator=(const JobSystem& rhs) = delete;
+    ~JobSystem() noexcept;
+
+    // 'worker_count' == 0: one worker per hardware thread, capped at MAX_WORKER_COUNT
+    static bool create(GeneralPurposeAllocator& allocator, u32 worker_count, JobSystem& out_system);
+    // joins the workers, jobs which are still queued are run by the calling thread
+    void destroy() noexcept;
+
+    // from the creating thread or from a job, other threads run the jobs inline
+    void run(std::span<const Job> jobs, JobCounter* counter) noexcept;
+    void run(const Job& job, JobCounter* counter) noexcept;
+    // runs queued jobs while counter is not zero
+    void wait(JobCounter& counter) noexcept;
+
+    u32 worker_count() const noexcept { return _worker_count; }
+    // INVALID_ID on threads which don't belong to a job system
+    static u32 worker_index() noexcept;
+    // scratch of the calling worker, rewound after every job
+    static StackAllocator& scratch_allocator() noexcept;
+
+private:
+    static void worker_loop(JobSystem* system, JobWorker* worker) noexcept;
+    // pops own deque first, then steals, false if every deque is empty
+    bool try_run_one(JobWorker& worker) noexcept;
+    void wake_workers() noexcept;
+};
+
+} // sf
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sf_core/defines.hpp"
+#include <span>
+#include <string_view>
+
+namespace sf {
+
+enum struct FileAccessHint : u8 {
+    // read front to back once: aggressive readahead, pages behind the reader can be dropped
+    SEQUENTIAL,
+    // jumps around (model buffers, archives): no readahead past the touched pages
+    RANDOM
+};
+
+// Read-only view of a whole file mapped into the address space, pages are read by the os on first touch
+// straight into the page cache, so the contents never go through a heap copy.
+// Bytes are valid while the view is alive, the view is movable but not copyable.
+// Mapping is page aligned, so it satisfies any alignment a file format needs (SPIR-V words).
+struct MappedFile {
+private:
+    const u8*   _data;
+    u64         _size;
+
+public:
+    MappedFile() noexcept;
+    MappedFile(const MappedFile& rhs) = delete;
+    MappedFile& operator=(const MappedFile& rhs) = delete;
+    MappedFile(MappedFile&& rhs) noexcept;
+    MappedFile& operator=(MappedFile&& rhs) noexcept;
+    ~MappedFile() noexcept;
+
+    // 'file_path' should be null terminated, empty file opens to an empty view
+    static bool open(std::string_view file_path, MappedFile& out_file, FileAccessHint hint = FileAccessHint::SEQUENTIAL) noexcept;
+    void close() noexcept;
+
+    std::span<const u8> bytes() const noexcept { return { _data, static_cast<usize>(_size) }; }
+    std::string_view to_sv() const noexcept { return { reinterpret_cast<const char*>(_data), static_cast<usize>(_size) }; }
+    u64 size() const noexcept { return _size; }
+};
+
+} // sf
@@ -7,13 +7,14 @@
 namespace sf {
 
 SF_EXPORT void* sf_mem_alloc(usize byte_size, u16 alignment = 0);
-SF_EXPORT void* sf_mem_realloc(void* ptr, usize byte_size);
+// 'alignment' has to match the one used for allocation of 'ptr'
+SF_EXPORT void* sf_mem_realloc(void* ptr, usize old_byte_size, usize new_byte_size, u16 alignment = 0);
 SF_EXPORT void  sf_mem_free(void* block, u16 alignment = 0);
 SF_EXPORT void  sf_mem_set(void* block, usize byte_size, i32 value);
 SF_EXPORT void  sf_mem_zero(void* block, usize byte_size);
-SF_EXPORT void  sf_mem_copy(void* dest, void* src, usize byte_size);
-SF_EXPORT void  sf_mem_move(void* dest, void* src, usize byte_size);
-SF_EXPORT bool  sf_mem_cmp(void* first, void* second, usize byte_size);
+SF_EXPORT void  sf_mem_copy(void* dest, const void* src, usize byte_size);
+SF_EXPORT void  sf_mem_move(void* dest, const void* src, usize byte_size);
+SF_EXPORT bool  sf_mem_cmp(const void* first, const void* second, usize byte_size);
 SF_EXPORT bool  sf_str_cmp(const char* first, const char* second);
 
 u32 sf_calc_padding(void* address, u16 alignment);
@@ -55,17 +56,17 @@ SF_EXPORT T* sf_mem_alloc_typed(usize count) {
     return platform_mem_alloc_typed<T, should_align>(count);
 }
 
-template<typename T>
-SF_EXPORT T* sf_mem_realloc_typed(T* ptr, usize count) {
-    return static_cast<T*>(sf_mem_realloc(ptr, sizeof(T) * count));
+template<typename T, bool should_align>
+SF_EXPORT T* sf_mem_realloc_typed(T* ptr, usize old_count, usize new_count) {
+    return static_cast<T*>(sf_mem_realloc(ptr, sizeof(T) * old_count, sizeof(T) * new_count, should_align ? alignof(T) : 0));
 }
 
 template<typename T, bool should_align>
 void sf_mem_free_typed(T* block) {
     if constexpr (should_align) {
-        ::operator delete(block, static_cast<std::align_val_t>(alignof(T)), std::nothrow);
+        platform_mem_free(block, alignof(T));
     } else {
-        ::operator delete(block, std::nothrow);
+        platform_mem_free(block, 0);
     }
 }
 
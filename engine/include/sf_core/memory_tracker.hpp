@@ -0,0 +1,65 @@
+#pragma once
+
+#include "sf_core/defines.hpp"
+#include <string_view>
+
+namespace sf {
+
+enum struct MemoryTag : u8 {
+    UNKNOWN,
+    GENERAL,
+    MAIN,
+    TEMP,
+    FRAME,
+    GAME,
+    TEXTURE,
+    MATERIAL,
+    VULKAN,
+    THREAD,
+    STRING,
+    TEST,
+    COUNT
+};
+
+inline constexpr std::string_view memory_tag_names[static_cast<u8>(MemoryTag::COUNT)]{
+    "UNKNOWN", "GENERAL", "MAIN", "TEMP", "FRAME", "GAME", "TEXTURE", "MATERIAL", "VULKAN", "THREAD", "STRING", "TEST"
+};
+
+struct MemoryTagStats {
+    usize current_bytes;
+    usize peak_bytes;
+    u64   alloc_count;
+    u64   free_count;
+    // allocations made during the last finished frame
+    u32   frame_alloc_count;
+};
+
+// Allocators report every allocation/free through these functions.
+// Compiled to no-ops unless SF_MEMORY_TRACKING is defined.
+#ifdef SF_MEMORY_TRACKING
+
+SF_EXPORT void memory_track_alloc(MemoryTag tag, usize byte_size);
+SF_EXPORT void memory_track_free(MemoryTag tag, usize byte_size);
+SF_EXPORT void memory_tracker_end_frame();
+SF_EXPORT MemoryTagStats memory_tracker_get_stats(MemoryTag tag);
+SF_EXPORT u32 memory_tracker_get_frame_alloc_count();
+// reports every frame which allocates after 'warmup_frames' frames, meant for benchmark runs
+// allocations from the frame allocator are not counted
+SF_EXPORT void memory_tracker_expect_zero_frame_allocs(bool enable, u32 warmup_frames = 60);
+SF_EXPORT u32 memory_tracker_get_violation_count();
+SF_EXPORT void memory_tracker_log_report();
+
+#else
+
+inline void memory_track_alloc(MemoryTag, usize) {}
+inline void memory_track_free(MemoryTag, usize) {}
+inline void memory_tracker_end_frame() {}
+inline MemoryTagStats memory_tracker_get_stats(MemoryTag) { return {}; }
+inline u32 memory_tracker_get_frame_alloc_count() { return 0; }
+inline void memory_tracker_expect_zero_frame_allocs(bool, u32 = 60) {}
+inline u32 memory_tracker_get_violation_count() { return 0; }
+inline void memory_tracker_log_report() {}
+
+#endif // SF_MEMORY_TRACKING
+
+} // sf
@@ -4,12 +4,15 @@
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_vulkan/shared_types.hpp"
 #include "sf_containers/dynamic_array.hpp"
+#include "sf_core/string_id.hpp"
 #include "sf_vulkan/mesh.hpp"
 
 namespace sf {
 
 struct Model {
     DynamicArray<Mesh, ArenaAllocator, false> meshes;
+    // file name without extension
+    StringId                                  name;
     static void create(ArenaAllocator& alloc, Model& out_model);
     static bool load(std::string_view model_file_name, ArenaAllocator& main_alloc, StackAllocator& alloc, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, VulkanShaderPipeline& shader, Model& out_model);
 };
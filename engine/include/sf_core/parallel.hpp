@@ -0,0 +1,398 @@
+#pragma once
+
+#include "sf_allocators/allocator_scope.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/job_system.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace sf {
+
+// Data parallel algorithms scheduled on the engine job system.
+// Calling thread always takes part in the work and returns when everything is done,
+// so they can be called from jobs as well. Temporary arrays come from the calling worker's scratch allocator.
+// DynamicArray and FixedArray are passed through 'to_span()'.
+
+// fixed-block algorithms (scan, partition, radix sort) split into at most this many blocks per worker
+inline constexpr u32 PARALLEL_BLOCKS_PER_WORKER{ 4 };
+// smaller ranges are not worth a job
+inline constexpr u32 PARALLEL_MIN_BLOCK_SIZE{ 2048 };
+
+template<typename Fn>
+struct ParallelForContext {
+    Fn*                 fn;
+    std::atomic<u32>    cursor;
+    u32                 count;
+    u32                 min_grain;
+    u32                 divisor;
+
+    // guided scheduling: chunk is a share of what is left, big chunks first and small ones at the end balance the load
+    void execute() noexcept {
+        u32 begin = cursor.load(std::memory_order_relaxed);
+        while (begin < count) {
+            const u32 end = begin + std::min(count - begin, std::max(min_grain, (count - begin) / divisor));
+            if (cursor.compare_exchange_weak(begin, end, std::memory_order_relaxed)) {
+                (*fn)(begin, end);
+                begin = cursor.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// fn(u32 begin, u32 end) over chunks of [0, count), chunks are never smaller than 'min_grain' except the last one.
+// 'min_grain' == 0 picks one from count and worker count.
+template<typename Fn>
+void parallel_for(JobSystem& system, u32 count, Fn&& fn, u32 min_grain = 0) {
+    if (count == 0) {
+        return;
+    }
+    const u32 worker_count = system.worker_count();
+    if (min_grain == 0) {
+        min_grain = std::max(1u, count / (worker_count * 64));
+    }
+    if (worker_count <= 1 || count <= min_grain) {
+        fn(0u, count);
+        return;
+    }
+
+    using FnType = std::remove_reference_t<Fn>;
+    ParallelForContext<FnType> context{ &fn, 0, count, min_grain, worker_count * 2 };
+    const u32 job_count = std::min(worker_count, (count + min_grain - 1) / min_grain);
+    Job jobs[JobSystem::MAX_WORKER_COUNT];
+    for (u32 i{0}; i < job_count - 1; ++i) {
+        jobs[i] = { [](void* data) { static_cast<ParallelForContext<FnType>*>(data)->execute(); }, &context };
+    }
+
+    JobCounter counter;
+    system.run({ jobs, job_count - 1 }, &counter);
+    context.execute();
+    system.wait(counter);
+}
+
+// fn(T& item)
+template<typename T, typename Fn>
+void parallel_for_each(JobSystem& system, std::span<T> items, Fn&& fn, u32 min_grain = 0) {
+    parallel_for(system, static_cast<u32>(items.size()), [items, &fn](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i) {
+            fn(items[i]);
+        }
+    }, min_grain);
+}
+
+// chunk_fn(u32 begin, u32 end) -> R, partial results are folded with 'combine(R, R) -> R' in no particular order,
+// so 'combine' should be associative and commutative
+template<typename R, typename ChunkFn, typename CombineFn>
+R parallel_reduce(JobSystem& system, u32 count, R identity, ChunkFn&& chunk_fn, CombineFn&& combine, u32 min_grain = 0) {
+    // one per worker and one for threads outside of the system, own cache line each
+    struct alignas(CACHE_LINE_SIZE) Partial {
+        R value;
+    };
+    StackAllocator& scratch = JobSystem::scratch_allocator();
+    AllocatorScope scope{ scratch };
+    const u32 partial_count = system.worker_count() + 1;
+    Partial* partials = static_cast<Partial*>(scratch.allocate(partial_count * sizeof(Partial), alignof(Partial)));
+    for (u32 i{0}; i < partial_count; ++i) {
+        sf_mem_place(&partials[i], identity);
+    }
+
+    parallel_for(system, count, [&](u32 begin, u32 end) {
+        const u32 worker_index = std::min(JobSystem::worker_index(), partial_count - 1);
+        // chunk first: it may help other jobs of this reduce on the same worker while waiting
+        R chunk_result = chunk_fn(begin, end);
+        partials[worker_index].value = combine(std::move(partials[worker_index].value), std::move(chunk_result));
+    }, min_grain);
+
+    R result = std::move(identity);
+    for (u32 i{0}; i < partial_count; ++i) {
+        result = combine(std::move(result), std::move(partials[i].value));
+        partials[i].~Partial();
+    }
+    return result;
+}
+
+// map(const T& item) -> R
+template<typename T, typename R, typename MapFn, typename CombineFn>
+R parallel_reduce(JobSystem& system, std::span<T> items, R identity, MapFn&& map, CombineFn&& combine, u32 min_grain = 0) {
+    return parallel_reduce(system, static_cast<u32>(items.size()), identity, [items, &map, &combine, &identity](u32 begin, u32 end) {
+        R result = identity;
+        for (u32 i = begin; i < end; ++i) {
+            result = combine(std::move(result), map(items[i]));
+        }
+        return result;
+    }, combine, min_grain);
+}
+
+// equal blocks for algorithms which make several passes over the same split
+struct ParallelBlocks {
+    u32 count;
+    u32 item_count;
+
+    u32 begin(u32 block) const noexcept { return static_cast<u32>(static_cast<u64>(item_count) * block / count); }
+    u32 end(u32 block) const noexcept { return static_cast<u32>(static_cast<u64>(item_count) * (block + 1) / count); }
+};
+
+inline ParallelBlocks parallel_split_blocks(const JobSystem& system, u32 item_count) {
+    const u32 block_count = std::clamp(item_count / PARALLEL_MIN_BLOCK_SIZE, 1u, system.worker_count() * PARALLEL_BLOCKS_PER_WORKER);
+    return { block_count, item_count };
+}
+
+// fn(u32 block) for every block
+template<typename Fn>
+void parallel_for_blocks(JobSystem& system, const ParallelBlocks& blocks, Fn&& fn) {
+    parallel_for(system, blocks.count, [&fn](u32 begin, u32 end) {
+        for (u32 block = begin; block < end; ++block) {
+            fn(block);
+        }
+    }, 1);
+}
+
+template<typename T>
+void parallel_copy(JobSystem& system, std::span<const std::type_identity_t<T>> src, std::span<T> dst) {
+    SF_ASSERT_MSG(src.size() == dst.size(), "Copy ranges should be of the same size");
+    parallel_for(system, static_cast<u32>(src.size()), [src, dst](u32 begin, u32 end) {
+        std::copy(src.begin() + begin, src.begin() + end, dst.begin() + begin);
+    }, PARALLEL_MIN_BLOCK_SIZE);
+}
+
+// two passes: block sums, serial scan over them, then every block scans itself from its offset.
+// 'input' and 'output' can be the same span, returns the total
+template<typename T>
+T parallel_scan_impl(JobSystem& system, std::span<const T> input, std::span<T> output, bool inclusive) {
+    SF_ASSERT_MSG(input.size() == output.size(), "Scan ranges should be of the same size");
+    const ParallelBlocks blocks = parallel_split_blocks(system, static_cast<u32>(input.size()));
+    StackAllocator& scratch = JobSystem::scratch_allocator();
+    AllocatorScope scope{ scratch };
+    T* block_offsets = static_cast<T*>(scratch.allocate(blocks.count * sizeof(T), alignof(T)));
+
+    parallel_for_blocks(system, blocks, [&](u32 block) {
+        T sum{};
+        for (u32 i = blocks.begin(block); i < blocks.end(block); ++i) {
+            sum = sum + input[i];
+        }
+        block_offsets[block] = sum;
+    });
+
+    T total{};
+    for (u32 block{0}; block < blocks.count; ++block) {
+        const T block_sum = block_offsets[block];
+        block_offsets[block] = total;
+        total = total + block_sum;
+    }
+
+    parallel_for_blocks(system, blocks, [&](u32 block) {
+        T running = block_offsets[block];
+        for (u32 i = blocks.begin(block); i < blocks.end(block); ++i) {
+            const T value = input[i];
+            output[i] = inclusive ? running + value : running;
+            running = running + value;
+        }
+    });
+    return total;
+}
+
+// output[i] = input[0] + ... + input[i - 1]
+template<typename T>
+T parallel_exclusive_scan(JobSystem& system, std::span<const std::type_identity_t<T>> input, std::span<T> output) {
+    return parallel_scan_impl<T>(system, input, output, false);
+}
+
+// output[i] = input[0] + ... + input[i]
+template<typename T>
+T parallel_inclusive_scan(JobSystem& system, std::span<const std::type_identity_t<T>> input, std::span<T> output) {
+    return parallel_scan_impl<T>(system, input, output, true);
+}
+
+// Stable: items matching 'pred' go first, both groups keep their order. 'scratch_items' should be as big as 'items'.
+// Returns count of matching items.
+template<typename T, typename Pred>
+u32 parallel_partition(JobSystem& system, std::span<T> items, std::span<T> scratch_items, Pred&& pred) {
+    SF_ASSERT_MSG(scratch_items.size() >= items.size(), "Partition scratch should be as big as the items");
+    const ParallelBlocks blocks = parallel_split_blocks(system, static_cast<u32>(items.size()));
+    StackAllocator& scratch = JobSystem::scratch_allocator();
+    AllocatorScope scope{ scratch };
+    u32* match_offsets = static_cast<u32*>(scratch.allocate(blocks.count * sizeof(u32), alignof(u32)));
+
+    parallel_for_blocks(system, blocks, [&](u32 block) {
+        u32 match_count{0};
+        for (u32 i = blocks.begin(block); i < blocks.end(block); ++i) {
+            match_count += pred(items[i]) ? 1 : 0;
+        }
+        match_offsets[block] = match_count;
+    });
+
+    u32 total_match_count{0};
+    for (u32 block{0}; block < blocks.count; ++block) {
+        const u32 match_count = match_offsets[block];
+        match_offsets[block] = total_match_count;
+        total_match_count += match_count;
+    }
+
+    parallel_for_blocks(system, blocks, [&](u32 block) {
+        u32 match_pos = match_offsets[block];
+        // items before the block which don't match
+        u32 rest_pos = total_match_count + blocks.begin(block) - match_pos;
+        for (u32 i = blocks.begin(block); i < blocks.end(block); ++i) {
+            if (pred(items[i])) {
+                scratch_items[match_pos++] = std::move(items[i]);
+            } else {
+                scratch_items[rest_pos++] = std::move(items[i]);
+            }
+        }
+    });
+
+    parallel_copy<T>(system, scratch_items.first(items.size()), items);
+    return total_match_count;
+}
+
+// Stable LSD radix sort by an unsigned integer key, 8 bits per pass.
+// Every block counts its digits, so scatter writes without atomics; passes where all keys share the digit are skipped.
+// 'scratch_items' should be as big as 'items'.
+template<typename T, typename KeyFn>
+void parallel_radix_sort(JobSystem& system, std::span<T> items, std::span<T> scratch_items, KeyFn&& key_fn) {
+    using Key = std::invoke_result_t<KeyFn&, const T&>;
+    static_assert(std::unsigned_integral<Key>, "Radix sort key should be an unsigned integer");
+    constexpr u32 DIGIT_COUNT{ 256 };
+    SF_ASSERT_MSG(scratch_items.size() >= items.size(), "Radix sort scratch should be as big as the items");
+
+    const u32 count = static_cast<u32>(items.size());
+    const ParallelBlocks blocks = parallel_split_blocks(system, count);
+    StackAllocator& scratch = JobSystem::scratch_allocator();
+    AllocatorScope scope{ scratch };
+    u32* histograms = static_cast<u32*>(scratch.allocate(blocks.count * DIGIT_COUNT * sizeof(u32), CACHE_LINE_SIZE));
+
+    std::span<T> src = items;
+    std::span<T> dst = scratch_items.first(count);
+    for (u32 shift{0}; shift < sizeof(Key) * 8; shift += 8) {
+        parallel_for_blocks(system, blocks, [&](u32 block) {
+            u32* histogram = histograms + block * DIGIT_COUNT;
+            std::fill_n(histogram, DIGIT_COUNT, 0u);
+            for (u32 i = blocks.begin(block); i < blocks.end(block); ++i) {
+                ++histogram[(key_fn(src[i]) >> shift) & 0xFF];
+            }
+        });
+
+        // digit major order: all blocks of digit 0, then all blocks of digit 1..., scatter stays stable
+        u32 offset{0};
+        bool is_single_digit{ false };
+        for (u32 digit{0}; digit < DIGIT_COUNT; ++digit) {
+            const u32 digit_start = offset;
+            for (u32 block{0}; block < blocks.count; ++block) {
+                const u32 block_digit_count = histograms[block * DIGIT_COUNT + digit];
+                histograms[block * DIGIT_COUNT + digit] = offset;
+                offset += block_digit_count;
+            }
+            is_single_digit |= offset - digit_start == count;
+        }
+        if (is_single_digit) {
+            continue;
+        }
+
+        parallel_for_blocks(system, blocks, [&](u32 block) {
+            u32* offsets = histograms + block * DIGIT_COUNT;
+            for (u32 i = blocks.begin(block); i < blocks.end(block); ++i) {
+                dst[offsets[(key_fn(src[i]) >> shift) & 0xFF]++] = std::move(src[i]);
+            }
+        });
+        std::swap(src, dst);
+    }
+
+    if (src.data() != items.data()) {
+        parallel_copy<T>(system, src, items);
+    }
+}
+
+template<std::unsigned_integral T>
+void parallel_radix_sort(JobSystem& system, std::span<T> items, std::span<T> scratch_items) {
+    parallel_radix_sort(system, items, scratch_items, [](const T& item) { return item; });
+}
+
+// Merge path: how many items of 'a' are among the first 'diagonal' items of merged 'a' and 'b', ties go to 'a'
+template<typename T, typename Less>
+u32 merge_path_split(std::span<const T> a, std::span<const T> b, u32 diagonal, Less& less) {
+    u32 low = diagonal > b.size() ? diagonal - static_cast<u32>(b.size()) : 0;
+    u32 high = std::min(diagonal, static_cast<u32>(a.size()));
+    while (low < high) {
+        const u32 mid = (low + high) / 2;
+        if (!less(b[diagonal - mid - 1], a[mid])) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Blocks are sorted by std::sort in parallel, then runs are merged pairwise.
+// Every merge is cut by merge path into pieces of similar size, so the last rounds with few long runs still use every worker.
+// Order of equal items is not kept. 'scratch_items' should be as big as 'items'.
+template<typename T, typename Less = std::less<>>
+void parallel_merge_sort(JobSystem& system, std::span<T> items, std::span<T> scratch_items, Less less = {}) {
+    SF_ASSERT_MSG(scratch_items.size() >= items.size(), "Merge sort scratch should be as big as the items");
+    const u32 count = static_cast<u32>(items.size());
+    const ParallelBlocks blocks = parallel_split_blocks(system, count);
+    if (blocks.count == 1) {
+        std::sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    struct MergePiece {
+        u32 run_begin;
+        u32 diagonal_begin;
+        u32 diagonal_end;
+    };
+    // every run is cut into pieces of at most 'piece_size', plus a shorter one per run
+    const u32 run_size = (count + blocks.count - 1) / blocks.count;
+    const u32 piece_size = std::max(1u, count / blocks.count);
+    const u32 max_piece_count = 2 * blocks.count + 1;
+    StackAllocator& scratch = JobSystem::scratch_allocator();
+    AllocatorScope scope{ scratch };
+    MergePiece* pieces = static_cast<MergePiece*>(scratch.allocate(max_piece_count * sizeof(MergePiece), alignof(MergePiece)));
+
+    parallel_for_blocks(system, blocks, [&](u32 block) {
+        const u32 begin = std::min(count, block * run_size);
+        std::sort(items.begin() + begin, items.begin() + std::min(count, begin + run_size), less);
+    });
+
+    std::span<T> src = items;
+    std::span<T> dst = scratch_items.first(count);
+    for (u32 width = run_size; width < count; width *= 2) {
+        u32 piece_count{0};
+        for (u32 run_begin{0}; run_begin < count; run_begin += 2 * width) {
+            const u32 merged_size = std::min(count - run_begin, 2 * width);
+            for (u32 diagonal{0}; diagonal < merged_size; diagonal += piece_size) {
+                SF_ASSERT_MSG(piece_count < max_piece_count, "Merge sort: too many pieces");
+                pieces[piece_count++] = { run_begin, diagonal, std::min(merged_size, diagonal + piece_size) };
+            }
+        }
+
+        parallel_for(system, piece_count, [&](u32 begin, u32 end) {
+            for (u32 p = begin; p < end; ++p) {
+                const MergePiece& piece = pieces[p];
+                const u32 a_size = std::min(width, count - piece.run_begin);
+                const u32 b_size = std::min(width, count - piece.run_begin - a_size);
+                std::span<const T> a{ src.data() + piece.run_begin, a_size };
+                std::span<const T> b{ src.data() + piece.run_begin + a_size, b_size };
+                const u32 a_begin = merge_path_split(a, b, piece.diagonal_begin, less);
+                const u32 a_end = merge_path_split(a, b, piece.diagonal_end, less);
+                std::merge(a.begin() + a_begin, a.begin() + a_end,
+                    b.begin() + (piece.diagonal_begin - a_begin), b.begin() + (piece.diagonal_end - a_end),
+                    dst.begin() + piece.run_begin + piece.diagonal_begin, less);
+            }
+        }, 1);
+        std::swap(src, dst);
+    }
+
+    if (src.data() != items.data()) {
+        parallel_copy<T>(system, src, items);
+    }
+}
+
+} // sf
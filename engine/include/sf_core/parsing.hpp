@@ -9,14 +9,14 @@
 
 namespace sf {
 
-template<AllocatorTrait Allocator>
+// works on a view, so input can be a mapped file as well as an owned string
 struct Parser {
 public:
     using CheckCharFn = i32(*)(i32) noexcept;
-    const String<Allocator>& str;
+    std::string_view str;
     u32 offset;
 public:
-    Parser(const String<Allocator>& str_in)
+    Parser(std::string_view str_in)
         : str{ str_in }
         , offset{0}
     {}
@@ -24,10 +24,10 @@ public:
     template<u32 MAX_LEN>
     bool parse_until(char terminator, FixedArray<char, MAX_LEN>& result) {
         u32 i{offset};
-        while (i < str.count()) {
+        while (i < str.size()) {
             if (str[i] == terminator) {
                 u32 len{ i - offset };
-                result = str.to_span(offset, len);
+                result = std::span<const char>{ str.data() + offset, len };
                 offset += len;
                 return true;
             }
@@ -38,7 +38,7 @@ public:
 
     bool parse_until_no_store(char terminator) {
         u32 i{offset};
-        while (i < str.count()) {
+        while (i < str.size()) {
             if (str[i] == terminator) {
                 offset += (i - offset);
                 return true;
@@ -48,16 +48,16 @@ public:
         return false;
     }
 
-    bool end_reached() { return offset >= str.count(); }
+    bool end_reached() { return offset >= str.size(); }
 
     void skip_ws() {
-        while (offset < str.count() && std::isspace(str[offset])) {
+        while (offset < str.size() && std::isspace(str[offset])) {
             ++offset;
         }
     }
 
     void skip_until_callback(CheckCharFn cb) {
-        while (offset < str.count() && !cb(str[offset])) {
+        while (offset < str.size() && !cb(str[offset])) {
             ++offset;
         }
     }
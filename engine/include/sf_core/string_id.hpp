@@ -0,0 +1,37 @@
+#pragma once
+
+#include "sf_containers/hashmap.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/defines.hpp"
+#include "sf_core/hash.hpp"
+#include <string_view>
+
+namespace sf {
+
+// Id of an interned string, equal strings always get the same id.
+// Compare and hash ids instead of string bytes, 'string_id_to_sv' gives the string back.
+struct StringId {
+    u32 id{ INVALID_ID };
+
+    constexpr bool is_valid() const { return id != INVALID_ID; }
+    friend constexpr bool operator==(StringId first, StringId second) = default;
+};
+
+template<>
+inline u64 hashfn_default<StringId>(ConstLRefOrValType<StringId> key) noexcept {
+    return hash_u64(key.id);
+}
+
+// Global interner, ids and strings live until the program exits.
+// Bytes are copied into a virtual arena once and never move, so returned views stay valid.
+// Thread safe: strings which are already interned take a shared lock, new ones an exclusive lock.
+SF_EXPORT StringId string_intern(std::string_view str);
+// 'hash' must be hash_str(str), lets names hashed at compile time skip hashing
+SF_EXPORT StringId string_intern_hashed(std::string_view str, u64 hash);
+// invalid id if the string was never interned, doesn't insert
+SF_EXPORT StringId string_id_find(std::string_view str);
+// null terminated
+SF_EXPORT std::string_view string_id_to_sv(StringId id);
+SF_EXPORT u32 string_interner_count();
+
+} // sf
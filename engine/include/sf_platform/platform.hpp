@@ -30,7 +30,23 @@ public:
 };
 
 void*   platform_mem_alloc(u64 byte_size, u16 alignment);
+// 'alignment' has to be the same as the one passed to platform_mem_alloc
+void    platform_mem_free(void* block, u16 alignment);
 u32     platform_get_mem_page_size();
+// virtual memory: reserve address range without backing pages, then commit/decommit page-aligned parts of it
+void*   platform_mem_reserve(u64 byte_size);
+bool    platform_mem_commit(void* addr, u64 byte_size);
+void    platform_mem_decommit(void* addr, u64 byte_size);
+void    platform_mem_release(void* addr, u64 byte_size);
+// grows/shrinks committed range, it may move, on linux without copying
+void*   platform_mem_remap(void* addr, u64 old_size, u64 new_size);
+// huge pages: fewer TLB misses for big randomly accessed pools
+u64     platform_get_huge_page_size();
+// like platform_mem_reserve, range is aligned to huge page size and committed pages are backed by huge pages when the os allows
+void*   platform_mem_reserve_huge(u64 byte_size);
+// committed memory, rounded up to huge page size, falls back to regular pages, 'out_huge' tells which one was used
+void*   platform_mem_alloc_huge(u64 byte_size, bool& out_huge);
+void    platform_mem_free_huge(void* addr, u64 byte_size);
 void    platform_console_write(char* message_buff, u16 written_count, u8 color);
 void    platform_console_write_error(char* message_buff, u16 written_count, u8 color);
 f64     platform_get_abs_time();
@@ -4,6 +4,11 @@
 
 namespace sf {
 void* platform_mem_alloc(u64 byte_size, u16 alignment);
+void  platform_mem_free(void* block, u16 alignment);
+// virtual memory for header-only containers, same functions as in sf_platform/platform.hpp
+void* platform_mem_reserve(u64 byte_size);
+bool  platform_mem_commit(void* addr, u64 byte_size);
+void  platform_mem_release(void* addr, u64 byte_size);
 
 template<typename T, bool should_align>
 T* platform_mem_alloc_typed(u64 count) {
@@ -10,6 +10,7 @@ struct VulkanImage {
 public:
     VkImage         handle;
     VkDeviceMemory  memory;
+    VkDeviceSize    memory_size;
     VkImageView     view;
     u32             width;
     u32             height;
@@ -2,41 +2,45 @@
 
 #include "glm/ext/vector_float4.hpp"
 #include "sf_allocators/arena_allocator.hpp"
+#include "sf_allocators/general_purpose_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_containers/dynamic_array.hpp"
 #include "sf_containers/fixed_array.hpp"
+#include "sf_containers/slot_map.hpp"
+#include "sf_containers/concurrent_hashmap.hpp"
 #include "sf_core/asserts_sf.hpp"
 #include "sf_core/constants.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/string_id.hpp"
 #include "sf_vulkan/device.hpp"
 #include "sf_vulkan/shared_types.hpp"
 #include "sf_vulkan/texture.hpp"
 #include "sf_vulkan/pipeline.hpp"
+#include <atomic>
+#include <mutex>
 #include <span>
 #include <string_view>
 
 namespace sf {
 
-inline constexpr u32 MATERIAL_NAME_MAX_LEN{ 64 };
-
 struct MaterialConfig {
     static constexpr u32 PROP_COUNT{4};
     static constexpr u32 MAX_STR_LEN{ 128 };
     
-    FixedString<MATERIAL_NAME_MAX_LEN> name;
-    FixedString<TEXTURE_NAME_MAX_LEN>  diffuse_texture_name;
+    StringId         name;
+    StringId         diffuse_texture_name;
     glm::vec4        diffuse_color;
     bool             auto_release;
 };
 
 struct TextureMap {
-    Texture*      texture;
+    TextureHandle texture;
     TextureType   type;  
 };
 
 template<u32 CAPACITY>
 struct TextureMaps {
-    FixedArray<Texture*, CAPACITY>      textures;
+    FixedArray<TextureHandle, CAPACITY> textures;
     FixedArray<TextureType, CAPACITY>   types;
 
     TextureMaps()
@@ -83,17 +87,15 @@ struct Material {
     TextureMaps<VulkanShaderPipeline::TEXTURE_COUNT> texture_maps;
     glm::vec4                                        diffuse_color{ DEFAULT_DIFFUSE_COLOR };
     Option<MaterialConfig>                           config{None::VALUE};
-    u32                                              id{INVALID_ID};
-    u32                                              generation{INVALID_ID};
 public:
-    static void create_empty(u32 id, Material& out_material);
     void destroy();
 };
 
+// 'handle' and 'auto_release' are written by the thread which owns the load, before 'state' leaves LOADING
 struct MaterialRef {
-    u32  handle{INVALID_ID};
-    u32  ref_count{0};
-    bool auto_release{false};  
+    MaterialHandle                  handle;
+    ResourceRefState                state;
+    bool                            auto_release{false};
 };
 
 struct MaterialSystem {
@@ -101,31 +103,40 @@ public:
     static constexpr std::string_view DEFAULT_FILE_NAME{ "default_mat.sfmt" };
     static constexpr u32 INIT_MATERIAL_AMOUNT{ 4096 };
 
-    using MaterialHashMap = HashMap<std::string_view, MaterialRef, ArenaAllocator, false>;
-    DynamicArray<Material, ArenaAllocator, false>       materials;
+    // keyed by interned material name, lookups don't lock, tables are grown on the inserting thread
+    using MaterialHashMap = ConcurrentHashMap<StringId, MaterialRef, GeneralPurposeAllocator>;
+    using MaterialSlotMap = SlotMap<Material>;
+    MaterialSlotMap                                     materials;
+    GeneralPurposeAllocator                             lookup_allocator;
     MaterialHashMap                                     material_lookup_table;
+    // serializes slot map writers, textures are loaded before it is taken, slot map reads don't take it
+    std::mutex                                          slot_mutex;
+    MaterialHandle                                      default_material;
 public:
-    static void create(ArenaAllocator& system_allocator, MaterialSystem& out_system);
-    static consteval u32 get_memory_requirement() { return INIT_MATERIAL_AMOUNT * sizeof(Material) + INIT_MATERIAL_AMOUNT * sizeof(MaterialHashMap::Bucket); }
+    static void create(MaterialSystem& out_system);
     ~MaterialSystem();
     static void preload_material_from_file_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<std::string_view> file_names);
     static void preload_material_from_config_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<MaterialConfig> configs);
-    static void load_and_get_material_from_file_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<std::string_view> file_names, std::span<Material*> out_materials);
-    static void load_and_get_material_from_config_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<MaterialConfig> configs, std::span<Material*> out_materials);
-    static Material* load_and_get_material_from_config(MaterialConfig&& config, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc);
-    static Material* load_and_get_material_from_file(std::string_view file_name, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc);
-    static Material& create_material_from_textures(
+    static void load_and_get_material_from_file_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<std::string_view> file_names, std::span<MaterialHandle> out_materials);
+    static void load_and_get_material_from_config_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<MaterialConfig> configs, std::span<MaterialHandle> out_materials);
+    // thread safe, concurrent calls for the same material load it once, the other callers wait for the result
+    static MaterialHandle load_and_get_material_from_config(MaterialConfig&& config, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc);
+    static MaterialHandle load_and_get_material_from_file(std::string_view file_name, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc);
+    static MaterialHandle create_material_from_textures(
         const VulkanDevice& device,
         VulkanCommandBuffer& cmd_buffer,
         StackAllocator& alloc,
         std::span<TextureInputConfig> tex_configs
     );
     static void free_material(std::string_view name);
-    static Material& get_empty_slot();
-    static Material& get_default_material();
+    static void free_material(StringId name);
+    static MaterialHandle get_empty_slot();
+    static void release_slot(MaterialHandle handle);
+    // doesn't lock, safe next to loader threads, nullptr if handle is stale,
+    // pointer is valid until this material is released, other materials don't move it
+    static Material* get_material(MaterialHandle handle);
+    static MaterialHandle get_default_material();
     static void create_default_material(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc);
-private:
-    void resize();
 };
 
 } // sf
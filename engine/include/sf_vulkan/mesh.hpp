@@ -3,6 +3,8 @@
 #include "sf_allocators/arena_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_containers/dynamic_array.hpp"
+#include "sf_containers/slot_map.hpp"
+#include "sf_containers/soa_array.hpp"
 #include "sf_core/constants.hpp"
 #include "sf_core/defines.hpp"
 #include "sf_vulkan/shared_types.hpp"
@@ -36,6 +38,8 @@ public:
     void destroy();
 };
 
+using GeometryViewHandle = SlotHandle<GeometryView>;
+
 struct GeometrySystem {
     static constexpr u32 INIT_GEOMETRY_COUNT{64};
     static constexpr u32 AVG_VERTEX_COUNT{ 4 * 256 };
@@ -43,16 +47,19 @@ struct GeometrySystem {
 
     DynamicArray<Vertex, ArenaAllocator, false>               vertices;
     DynamicArray<Vertex::IndexType, ArenaAllocator, false>    indices;
-    DynamicArray<GeometryView, ArenaAllocator, false>         geometry_views;
+    SlotMap<GeometryView>                                     geometry_views;
+    GeometryViewHandle                                        default_geometry_view;
     ArenaAllocator*                                           alloc;
 public:
-    static consteval u32 get_memory_requirement() { return INIT_GEOMETRY_COUNT * sizeof(GeometryView) + INIT_GEOMETRY_COUNT * (AVG_INDEX_COUNT * sizeof(Vertex::IndexType) + AVG_VERTEX_COUNT * sizeof(Vertex)); }
+    static consteval u32 get_memory_requirement() { return INIT_GEOMETRY_COUNT * (AVG_INDEX_COUNT * sizeof(Vertex::IndexType) + AVG_VERTEX_COUNT * sizeof(Vertex)); }
     static void create(ArenaAllocator& allocator, StackAllocator& temp_allocator, GeometrySystem& out_state);
-    static GeometryView& create_geometry_and_get_view(
+    static GeometryViewHandle create_geometry_and_get_view(
         DynamicArray<Vertex, StackAllocator>&& vertices,
         DynamicArray<u32, StackAllocator>&& indices
     );
-    static GeometryView& get_default_geometry_view();
+    // nullptr if handle is stale
+    static GeometryView* get_geometry_view(GeometryViewHandle handle);
+    static GeometryViewHandle get_default_geometry_view();
     static std::span<Vertex> get_vertices();
     static std::span<Vertex::IndexType> get_indices();
 private:
@@ -62,25 +69,28 @@ private:
 
 struct Mesh {
     static constexpr u32 MAX_TEXTURE_COUNT{ 8 };
-    GeometryView* geometry_view;
-    Material*     material;
-    u32           descriptor_state_index{INVALID_ID};
+    GeometryViewHandle  geometry_view;
+    MaterialHandle      material;
+    u32                 descriptor_state_index{INVALID_ID};
 public:
     static void create_empty(VulkanShaderPipeline& shader, const VulkanDevice& device, Mesh& out_mesh);
     static void create_from_existing_data(
         VulkanShaderPipeline& shader,
         const VulkanDevice& device,
-        GeometryView* geometry,
-        Material* material,
+        GeometryViewHandle geometry,
+        MaterialHandle material,
         Mesh& out_mesh
     );
-    void set_geometry_view(GeometryView* geometry);
+    void set_geometry_view(GeometryViewHandle geometry);
     bool has_geometry_view() const;
-    void set_material(Material* mat);
+    void set_material(MaterialHandle mat);
     bool has_material() const;
     bool valid() const;
     void draw(VulkanCommandBuffer& cmd_buffer);
     void destroy();
 };
 
+// draw list in columns: geometry view, material, descriptor state index
+using MeshList = SoaArray<ArenaAllocator, GeometryViewHandle, MaterialHandle, u32>;
+
 } // sf
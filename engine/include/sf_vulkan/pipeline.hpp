@@ -2,6 +2,7 @@
 
 #include "sf_vulkan/shared_types.hpp"
 #include "sf_allocators/stack_allocator.hpp"
+#include "sf_containers/bitset.hpp"
 #include "sf_containers/dynamic_array.hpp"
 #include "sf_containers/fixed_array.hpp"
 #include "sf_containers/optional.hpp"
@@ -19,7 +20,7 @@
 
 namespace sf {
 
-Result<VkShaderModule> create_shader_module(const VulkanDevice& device, String<StackAllocator>&& shader_file_path);
+Result<VkShaderModule> create_shader_module(const VulkanDevice& device, AssetPath&& shader_file_path);
 
 struct VulkanDescriptorSetLayout {
 public:
@@ -78,15 +79,16 @@ public:
     VulkanContext*                                                                context;
     VulkanDescriptorSetLayout                                                     object_descriptor_layout;
     VulkanDescriptorPool                                                          object_descriptor_pool;
-    FixedArray<Texture*, MAX_DEFAULT_TEXTURES>                                    default_textures;
+    FixedArray<TextureHandle, MAX_DEFAULT_TEXTURES>                               default_textures;
     FixedArray<VkVertexInputAttributeDescription, MAX_ATTRIB_COUNT>               attrib_descriptions;
     FixedArray<ObjectShaderState, MAX_OBJECT_COUNT>                               object_shader_states;
+    // set bit for every object shader state in use
+    BitSet<MAX_OBJECT_COUNT>                                                      object_state_occupancy;
     VkShaderModule               shader_handle;
     VkPipeline                   pipeline_handle;
     VkPipelineLayout             pipeline_layout;
     VkViewport                   viewport;
     VkRect2D                     scissors;
-    u32                          descriptor_state_index_counter;
     // NOTE: TEMP
     u32                          default_texture_index;
 public:
@@ -100,7 +102,7 @@ public:
         const FixedArray<VkVertexInputAttributeDescription, MAX_ATTRIB_COUNT>& attrib_descriptions,
         VkViewport                     viewport,
         VkRect2D                       scissors,
-        std::span<Texture*>            default_textures,
+        std::span<TextureHandle>       default_textures,
         VulkanShaderPipeline&          out_pipeline,
         StackAllocator&                alloc
     );
@@ -95,7 +95,7 @@ struct Camera {
 struct VulkanRenderer {
 public:
     static constexpr u32 MAX_MESH_COUNT{ 512 };
-    FixedArray<Mesh, MAX_MESH_COUNT>   meshes;
+    MeshList                           meshes;
     PlatformState*                     platform_state;
     VulkanGlobalUniformBufferObject    global_ubo;
     Camera                             camera;
@@ -109,6 +109,7 @@ bool renderer_on_resize(u8 code, void* sender, void* listener_inst, Option<Event
 bool renderer_begin_frame(f64 delta_time);
 void renderer_end_frame(f64 delta_time);
 bool renderer_draw_frame(const RenderPacket& packet);
+void renderer_shutdown();
 const VulkanDevice& renderer_get_device();
 SF_EXPORT void renderer_update_global_ubo(const glm::mat4& view, const glm::mat4& proj);
 SF_EXPORT void renderer_update_view(const glm::mat4& view);
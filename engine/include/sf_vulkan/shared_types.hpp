@@ -2,6 +2,10 @@
 
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_containers/dynamic_array.hpp"
+#include "sf_containers/slot_map.hpp"
+#include "sf_containers/small_array.hpp"
+#include "sf_core/string_id.hpp"
+#include <atomic>
 
 namespace sf {
 
@@ -14,6 +18,9 @@ struct Texture;
 struct Material;
 struct GeometryView;
 
+using TextureHandle = SlotHandle<Texture>;
+using MaterialHandle = SlotHandle<Material>;
+
 // same as aiTextureType
 enum struct TextureType {
     NONE = 0,
@@ -46,13 +53,138 @@ enum struct TextureType {
     GLTF_METALLIC_ROUGHNESS = 27,
 };
 
+// state of a lookup table entry, threads asking for a resource which is loading or being released wait until it changes
+enum struct ResourceLoadState : u8 {
+    UNLOADED,
+    LOADING,
+    READY,
+    FAILED,
+    // last reference is gone, resource is being destroyed
+    RELEASING
+};
+
+enum struct ResourceAcquireResult : u8 {
+    // reference is taken, handle of the entry is valid until it's released
+    ACQUIRED,
+    // caller owns the load and should call 'finish_load'
+    SHOULD_LOAD,
+    FAILED
+};
+
+enum struct ResourceReleaseResult : u8 {
+    RELEASED,
+    // last reference of an auto released entry, caller should destroy the resource and call 'finish_release'
+    SHOULD_DESTROY,
+    NOT_HELD
+};
+
+// Load state and reference count of a lookup table entry packed into one word, so a reference can't be taken
+// from an entry whose last reference is being dropped. Entries stay in the table when they are released or fail,
+// the next acquire loads them again.
+struct ResourceRefState {
+private:
+    static constexpr u32 STATE_MASK{ 0xFF };
+    static constexpr u32 REF_ONE{ 1u << 8 };
+
+    std::atomic<u32> _word{ pack(ResourceLoadState::UNLOADED, 0) };
+
+public:
+    // blocks while the entry is loading or being released
+    ResourceAcquireResult acquire() noexcept {
+        bool has_waited{ false };
+        u32 current = _word.load(std::memory_order_acquire);
+        while (true) {
+            switch (state_of(current)) {
+                case ResourceLoadState::READY: {
+                    if (_word.compare_exchange_weak(current, current + REF_ONE, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        return ResourceAcquireResult::ACQUIRED;
+                    }
+                } break;
+                case ResourceLoadState::FAILED:
+                case ResourceLoadState::UNLOADED: {
+                    // failed load is retried by later calls, threads which waited for it get the failure
+                    if (has_waited && state_of(current) == ResourceLoadState::FAILED) {
+                        return ResourceAcquireResult::FAILED;
+                    }
+                    if (_word.compare_exchange_weak(current, pack(ResourceLoadState::LOADING, 0), std::memory_order_acquire, std::memory_order_acquire)) {
+                        return ResourceAcquireResult::SHOULD_LOAD;
+                    }
+                } break;
+                case ResourceLoadState::LOADING:
+                case ResourceLoadState::RELEASING: {
+                    _word.wait(current, std::memory_order_acquire);
+                    has_waited = true;
+                    current = _word.load(std::memory_order_acquire);
+                } break;
+            }
+        }
+    }
+
+    // doesn't block, true if the caller owns the load now
+    bool try_claim_load() noexcept {
+        u32 current = _word.load(std::memory_order_acquire);
+        while (state_of(current) == ResourceLoadState::UNLOADED || state_of(current) == ResourceLoadState::FAILED) {
+            if (_word.compare_exchange_weak(current, pack(ResourceLoadState::LOADING, 0), std::memory_order_acquire, std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // owner only, loaded entry starts with the owner's reference
+    void finish_load(bool is_loaded) noexcept {
+        _word.store(is_loaded ? pack(ResourceLoadState::READY, 1) : pack(ResourceLoadState::FAILED, 0), std::memory_order_release);
+        _word.notify_all();
+    }
+
+    ResourceReleaseResult release(bool auto_release) noexcept {
+        u32 current = _word.load(std::memory_order_relaxed);
+        while (true) {
+            if (state_of(current) != ResourceLoadState::READY || ref_count_of(current) == 0) {
+                return ResourceReleaseResult::NOT_HELD;
+            }
+            // dropping the last reference and leaving READY is one step, acquire can't revive the entry
+            const bool should_destroy = auto_release && ref_count_of(current) == 1;
+            const u32 next = should_destroy ? pack(ResourceLoadState::RELEASING, 0) : current - REF_ONE;
+            if (_word.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return should_destroy ? ResourceReleaseResult::SHOULD_DESTROY : ResourceReleaseResult::RELEASED;
+            }
+        }
+    }
+
+    void finish_release() noexcept {
+        _word.store(pack(ResourceLoadState::UNLOADED, 0), std::memory_order_release);
+        _word.notify_all();
+    }
+
+    ResourceLoadState state() const noexcept { return state_of(_word.load(std::memory_order_acquire)); }
+    u32 ref_count() const noexcept { return ref_count_of(_word.load(std::memory_order_acquire)); }
+
+private:
+    static constexpr u32 pack(ResourceLoadState state, u32 ref_count) noexcept {
+        return ref_count * REF_ONE | static_cast<u32>(state);
+    }
+    static constexpr ResourceLoadState state_of(u32 word) noexcept {
+        return static_cast<ResourceLoadState>(word & STATE_MASK);
+    }
+    static constexpr u32 ref_count_of(u32 word) noexcept {
+        return word / REF_ONE;
+    }
+};
+
+// asset paths are almost always shorter than this, so building them doesn't touch the allocator
+inline constexpr u32 ASSET_PATH_INLINE_CAPACITY{ 128 };
+using AssetPath = SmallString<ASSET_PATH_INLINE_CAPACITY, StackAllocator>;
+
 struct TextureInputConfig {
-    String<StackAllocator>       texture_path;
+    AssetPath                    texture_path;
+    // interned texture name if known up front, invalid - interned from the path
+    StringId                     name;
     bool                         auto_release;
     TextureType                  type;
 
     TextureInputConfig() = default;
-    TextureInputConfig(String<StackAllocator>&& texture_path, TextureType type = TextureType::DIFFUSE, bool auto_release = false): texture_path{ std::move(texture_path) }, auto_release{ auto_release } {};
+    TextureInputConfig(AssetPath&& texture_path, TextureType type = TextureType::DIFFUSE, bool auto_release = false, StringId name = {}): texture_path{ std::move(texture_path) }, name{ name }, auto_release{ auto_release }, type{ type } {};
 };
 
 } // sf
@@ -1,16 +1,24 @@
 #pragma once
 
 #include "sf_allocators/arena_allocator.hpp"
+#include "sf_allocators/general_purpose_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_containers/dynamic_array.hpp"
 #include "sf_containers/fixed_array.hpp"
-#include "sf_containers/hashmap.hpp"
 #include "sf_containers/result.hpp"
+#include "sf_containers/slot_map.hpp"
+#include "sf_containers/concurrent_hashmap.hpp"
 #include "sf_core/defines.hpp"
 #include "sf_core/constants.hpp"
+#include "sf_core/hash.hpp"
+#include "sf_core/io.hpp"
+#include "sf_core/job_system.hpp"
+#include "sf_core/string_id.hpp"
 #include "sf_vulkan/buffer.hpp"
 #include "sf_vulkan/image.hpp"
 #include "sf_vulkan/shared_types.hpp"
+#include <atomic>
+#include <mutex>
 #include <string_view>
 #include <vulkan/vulkan_core.h>
 
@@ -42,63 +50,94 @@ public:
     u32               width;
     u32               height;
     u32               size;
-    u32               id{INVALID_ID};
-    u32               generation{INVALID_ID};
     bool              has_transparency;
     u8                channel_count; 
     ImageFormat       format;
     TextureState      state{TextureState::NOT_LOADED};
 public:
-    static void create_empty(u32 id, Texture& out_texture);
+    static void create_empty(Texture& out_texture);
     static bool load(
         const VulkanDevice& device,
         VulkanCommandBuffer& cmd_buffer,
         TextureInputConfig&& input_config,
-        StackAllocator& alloc,
         Texture& out_texture
     );
     static Result<ImageFormat> map_extension_to_format(std::string_view extension);
     void destroy(const VulkanDevice& device);
-private:
+    // only touch this texture, can run on worker threads
+    bool load_from_disk(AssetPath&& file_name);
+    // decodes an image file already read into memory, 'texture_path' picks the format
+    bool load_from_memory(std::span<const u8> file_data, std::string_view texture_path);
+    // records into 'cmd_buffer', thread which owns it only
     bool upload_to_gpu(
         const VulkanDevice& device,
         VulkanCommandBuffer& cmd_buffer
     );
-    bool load_from_disk(String<StackAllocator>&& file_name, StackAllocator& alloc);
 };
 
+// 'handle' and 'auto_release' are written by the thread which owns the load, before 'state' leaves LOADING
 struct TextureRef {
-    u32               handle;
-    u32               ref_count;
-    bool              auto_release;
+    TextureHandle                   handle;
+    ResourceRefState                state;
+    bool                            auto_release{false};
 };
 
 struct TextureSystem {
 public:
-    static constexpr u32 MAX_TEXTURE_AMOUNT{ 65536 };
+    static constexpr u32 INIT_TEXTURE_AMOUNT{ 1024 };
 #ifdef SF_DEBUG
     static constexpr std::string_view TEXTURE_FILE_PATH_TRIM_PART{"build/engine/debug/assets/"};
 #else
     static constexpr std::string_view TEXTURE_FILE_PATH_TRIM_PART{"build/engine/release/assets/"};
 #endif
     
-    // storing hash of the string as key
-    using TextureHashMap = HashMap<u64, TextureRef, ArenaAllocator, false>;
+    // keyed by interned texture name, lookups don't lock, so loader threads can insert while main thread reads,
+    // tables are grown on the inserting thread, so they come from the heap, not from the system arena
+    using TextureHashMap = ConcurrentHashMap<StringId, TextureRef, GeneralPurposeAllocator>;
+    using TextureSlotMap = SlotMap<Texture>;
 
-    DynamicArray<Texture, ArenaAllocator, false> textures;
+    TextureSlotMap                               textures;
+    GeneralPurposeAllocator                      lookup_allocator;
     TextureHashMap                               texture_lookup_table;
+    // serializes slot map writers and the upload command buffer, slot map reads don't take it
+    std::mutex                                   load_mutex;
+    // images of a batch are decoded on its workers
+    JobSystem*             job_system;
     const VulkanDevice*    device;
-    u32                    id_counter;
 public:
-    static consteval u32 get_memory_requirement() { return MAX_TEXTURE_AMOUNT * sizeof(Texture) + MAX_TEXTURE_AMOUNT * sizeof(TextureHashMap::Bucket); }
-    static String<StackAllocator> acquire_default_texture_path(std::string_view texture_file_name, StackAllocator& alloc);
-    static void create(ArenaAllocator& allocator, const VulkanDevice& device, TextureSystem& out_system);
+    static AssetPath acquire_default_texture_path(std::string_view texture_file_name, StackAllocator& alloc);
+
+    // interned into the key of the lookup table, path without the trim part and extension
+    static constexpr std::string_view texture_name_from_path(std::string_view texture_path) {
+        return strip_part_from_start_and_extension(texture_path, TEXTURE_FILE_PATH_TRIM_PART);
+    }
+
+    // hash of the name for the path 'acquire_default_texture_path' builds, lets names written in source skip hashing on intern
+    static consteval u64 hash_default_texture_name(std::string_view texture_file_name) {
+        char path[256]{};
+        std::string_view::size_type len{0};
+        for (char c : TEXTURE_ASSETS_PATH) {
+            path[len++] = c;
+        }
+        for (char c : texture_file_name) {
+            path[len++] = c;
+        }
+        return hash_str(texture_name_from_path(std::string_view{ path, len }));
+    }
+
+    static void create(const VulkanDevice& device, JobSystem& job_system, TextureSystem& out_system);
     ~TextureSystem();
-    static void get_or_load_textures_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc,  std::span<TextureInputConfig> configs, std::span<Texture*> out_textures);
-    static Texture* get_or_load_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureInputConfig&& config, StackAllocator& alloc);
-    static Texture* get_texture(std::string_view name);
+    // images which are not loaded yet are decoded concurrently, then uploaded on the calling thread
+    static void get_or_load_textures_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc,  std::span<TextureInputConfig> configs, std::span<TextureHandle> out_textures);
+    // thread safe, concurrent calls for the same texture load it once, the other callers wait for the result
+    static TextureHandle get_or_load_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureInputConfig&& config);
+    // doesn't lock, safe next to loader threads, nullptr if handle is stale,
+    // pointer is valid until this texture is freed, loads and frees of other textures don't move it
+    static Texture* get_texture(TextureHandle handle);
     static void free_texture(const VulkanDevice& device, std::string_view name);
-    static Texture& get_empty_slot();
+    static void free_texture(const VulkanDevice& device, StringId name);
+    static TextureHandle get_empty_slot();
+    static void release_slot(TextureHandle handle);
 };
 
 } // sf
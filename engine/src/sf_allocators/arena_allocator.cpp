@@ -4,22 +4,138 @@
 #include "sf_core/asserts_sf.hpp"
 #include "sf_core/constants.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
 #include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include "sf_core/utility.hpp"
 #include "sf_allocators/arena_allocator.hpp"
+#include "sf_platform/platform.hpp"
 #include <algorithm>
+#include <limits>
 
 namespace sf {
 
+static usize align_up(usize size, usize granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
 ArenaAllocator::ArenaAllocator()
     : regions(DEFAULT_REGIONS_INIT_CAPACITY, &application_get_gpa())
+    , virtual_base{ nullptr }
+    , virtual_committed{ 0 }
+    , tag{ MemoryTag::UNKNOWN }
+    , huge_pages{ false }
+{
+}
+
+ArenaAllocator::ArenaAllocator(usize reserve_size, bool use_huge_pages)
+    : regions(DEFAULT_REGIONS_INIT_CAPACITY, &application_get_gpa())
+    , virtual_base{ nullptr }
+    , virtual_committed{ 0 }
+    , tag{ MemoryTag::UNKNOWN }
+    , huge_pages{ use_huge_pages }
 {
+    // Region::capacity is 32 bit
+    const usize max_reserve = static_cast<usize>(std::numeric_limits<u32>::max()) + 1 - commit_granularity();
+    reserve_size = std::min(align_to_commit_granularity(reserve_size), max_reserve);
+
+    virtual_base = static_cast<u8*>(huge_pages ? platform_mem_reserve_huge(reserve_size) : platform_mem_reserve(reserve_size));
+    if (!virtual_base) {
+        LOG_WARN("ArenaAllocator: failed to reserve virtual memory, falling back to heap regions");
+        return;
+    }
+
+    regions.append(Region{ .data = virtual_base, .capacity = static_cast<u32>(reserve_size), .offset = 0, .prev_offset = 0 });
+}
+
+usize ArenaAllocator::commit_granularity() const {
+    const usize granularity = get_mem_page_size() * static_cast<usize>(VIRTUAL_COMMIT_PAGES);
+    // commit whole huge pages, partly committed one can't be backed by a huge page
+    return huge_pages ? std::max<usize>(granularity, platform_get_huge_page_size()) : granularity;
+}
+
+usize ArenaAllocator::align_to_commit_granularity(usize size) const {
+    return align_up(size, commit_granularity());
+}
+
+u8* ArenaAllocator::alloc_region_memory(usize& inout_size) {
+    if (!huge_pages) {
+        return static_cast<u8*>(sf_mem_alloc(inout_size, DEFAULT_ALIGNMENT));
+    }
+
+    const usize huge_page_size = platform_get_huge_page_size();
+    if (huge_page_size) {
+        inout_size = align_up(inout_size, huge_page_size);
+    }
+    bool is_huge;
+    return static_cast<u8*>(platform_mem_alloc_huge(inout_size, is_huge));
+}
+
+void ArenaAllocator::free_region_memory(u8* data, usize size) {
+    if (huge_pages) {
+        platform_mem_free_huge(data, size);
+    } else {
+        sf_mem_free(data, DEFAULT_ALIGNMENT);
+    }
+}
+
+bool ArenaAllocator::virtual_commit(usize end_offset) {
+    if (end_offset <= virtual_committed) {
+        return true;
+    }
+
+    const usize new_committed = std::min(align_to_commit_granularity(end_offset), static_cast<usize>(regions[0].capacity));
+    if (!platform_mem_commit(virtual_base + virtual_committed, new_committed - virtual_committed)) {
+        LOG_FATAL("ArenaAllocator: failed to commit {} bytes", new_committed - virtual_committed);
+        return false;
+    }
+    virtual_committed = new_committed;
+    return true;
+}
+
+void ArenaAllocator::virtual_decommit(usize keep_offset) {
+    const usize keep = align_to_commit_granularity(keep_offset);
+    if (keep >= virtual_committed) {
+        return;
+    }
+
+    platform_mem_decommit(virtual_base + keep, virtual_committed - keep);
+    virtual_committed = keep;
 }
 
 void* ArenaAllocator::allocate(usize size, u16 alignment) {
+    // header sits right before the block, keep it aligned too
+    alignment = std::max<u16>(alignment, alignof(ArenaAllocatorHeader));
+
+    // fast path: bump inside of the reserved range
+    if (is_virtual()) {
+        Region* region = &regions[0];
+        u32 padding = calc_padding_with_header(region->data + region->offset, alignment, sizeof(ArenaAllocatorHeader));
+        usize end_offset = static_cast<usize>(region->offset) + padding + size;
+
+        if (end_offset <= region->capacity) {
+            if (!virtual_commit(end_offset)) {
+                return nullptr;
+            }
+
+            void* return_ptr = static_cast<void*>(region->data + region->offset + padding);
+            ArenaAllocatorHeader* header = ptr_step_bytes_backward<ArenaAllocatorHeader>(return_ptr, sizeof(ArenaAllocatorHeader));
+            header->padding = padding;
+            header->diff = region->offset - region->prev_offset;
+
+            region->prev_offset = region->offset;
+            region->offset = end_offset;
+            memory_track_alloc(tag, padding + size);
+            return return_ptr;
+        }
+    }
+
     auto [region, padding] = find_sufficient_region_for_alloc(size, alignment);
 
     if (region->data == nullptr) {
-        init_new_region(region, size + padding);
+        // worst case padding, the real one is known once the region exists
+        init_new_region(region, size + alignment + sizeof(ArenaAllocatorHeader));
+        padding = calc_padding_with_header(region->data, alignment, sizeof(ArenaAllocatorHeader));
     }
 
     void* return_ptr = static_cast<void*>(region->data + region->offset + padding);
@@ -29,6 +145,7 @@ void* ArenaAllocator::allocate(usize size, u16 alignment) {
     
     region->prev_offset = region->offset;
     region->offset += padding + size;
+    memory_track_alloc(tag, padding + size);
     return return_ptr;
 }
 
@@ -56,49 +173,36 @@ ReallocReturn ArenaAllocator::reallocate(void* ptr, usize new_size, u16 alignmen
         return {allocate(new_size, alignment), true};
     }
 
-    u32 prev_alloc_size = region->offset - region->prev_offset;
-    u32 alloc_diff = new_size - prev_alloc_size;
+    // last alloc -> grow/shrink in place
+    const usize new_end = static_cast<usize>(region->prev_offset) + header->padding + new_size;
 
-    // shrink last alloc
-    if (alloc_diff < 0) {
-        region->offset += alloc_diff;
+    if (new_end <= region->offset) {
+        memory_track_free(tag, region->offset - new_end);
+        region->offset = new_end;
         return {ptr, false};
     }
-    
-    u32 remain_mem = region->capacity - region->offset;
 
-    // enough space case
-    if (alloc_diff <= remain_mem) {
-        region->offset += alloc_diff; 
+    if (new_end <= region->capacity) {
+        if (region->data == virtual_base && !virtual_commit(new_end)) {
+            return {nullptr, false};
+        }
+        memory_track_alloc(tag, new_end - region->offset);
+        region->offset = new_end;
         return {ptr, false};
     }
 
-    // not enough space - reallocate to new region
-
-    // free old alloc
-    free_inside_region(ptr, region);
-
-    // allocate inside new region
-    auto [new_region, padding] = find_sufficient_region_for_alloc(new_size, alignment);
-
-    if (region->data == nullptr) {
-        init_new_region(region, new_size + padding);
-    }
-
-    void* return_ptr = static_cast<void*>(region->data + region->offset + padding);
-    header = ptr_step_bytes_backward<ArenaAllocatorHeader>(return_ptr, sizeof(ArenaAllocatorHeader));
-    header->padding = padding;
-    header->diff = region->offset - region->prev_offset;
-    
-    region->prev_offset = region->offset;
-    region->offset += padding + new_size;
-    return {return_ptr, true};
+    // not enough space, old block stays valid until the caller copied it
+    return {allocate(new_size, alignment), true};
 }
 
 ArenaAllocator::Region* ArenaAllocator::find_region_for_addr(void* addr) {
     if (regions.count() == 0) {
         return nullptr;
     }
+
+    if (is_virtual() && is_address_in_range(virtual_base, regions[0].capacity, addr)) {
+        return &regions[0];
+    }
     
     u32 region_ind{0};
     Region* region;
@@ -143,11 +247,11 @@ ArenaAllocator::FindSufficcientRegionReturn ArenaAllocator::find_sufficient_regi
 }
 
 void ArenaAllocator::init_new_region(Region* region, usize alloc_size) {
-    const usize alloc_size_ = std::max(alloc_size, get_mem_page_size() * static_cast<usize>(DEFAULT_REGION_CAPACITY_PAGES));
-    region->data = static_cast<u8*>(sf_mem_alloc(alloc_size, DEFAULT_ALIGNMENT));
+    usize region_size = std::max(alloc_size, get_mem_page_size() * static_cast<usize>(DEFAULT_REGION_CAPACITY_PAGES));
+    region->data = alloc_region_memory(region_size);
     region->offset = 0;
     region->prev_offset = 0;
-    region->capacity = alloc_size;
+    region->capacity = region_size;
 }
 
 ReallocReturnHandle ArenaAllocator::reallocate_handle(usize handle, usize size, u16 alignment) {
@@ -168,6 +272,7 @@ void ArenaAllocator::free(void* addr)
         return;
     }
 
+    memory_track_free(tag, region->offset - region->prev_offset);
     region->offset = region->prev_offset;
     region->prev_offset -= header->diff; 
 }
@@ -179,17 +284,29 @@ void ArenaAllocator::free_inside_region(void* addr, Region* region) {
         return;
     }
 
+    memory_track_free(tag, region->offset - region->prev_offset);
     region->offset = region->prev_offset;
     region->prev_offset -= header->diff; 
 }
 
 void ArenaAllocator::clear() {
+    memory_track_free(tag, used_size());
     for (auto& region : regions) {
         region.offset = 0;
     }
+
+    if (is_virtual()) {
+        virtual_decommit(0);
+    }
 }
 
 void ArenaAllocator::reserve(usize needed_capacity) {
+    // reserved range is big enough -> just commit pages up front
+    if (is_virtual() && regions[0].capacity - regions[0].offset >= needed_capacity) {
+        virtual_commit(regions[0].offset + needed_capacity);
+        return;
+    }
+
     Region* region;
     u32 founded_region{regions.count()};
 
@@ -208,28 +325,46 @@ void ArenaAllocator::reserve(usize needed_capacity) {
         region = regions.last_ptr();
     }
 
-    const usize alloc_size = std::max(needed_capacity, get_mem_page_size() * static_cast<usize>(DEFAULT_REGION_CAPACITY_PAGES));
-    region->data = static_cast<u8*>(sf_mem_alloc(alloc_size, DEFAULT_ALIGNMENT));
+    usize alloc_size = std::max(needed_capacity, get_mem_page_size() * static_cast<usize>(DEFAULT_REGION_CAPACITY_PAGES));
+    region->data = alloc_region_memory(alloc_size);
     region->offset = 0;
     region->capacity = alloc_size;
 }
 
 ArenaAllocator::~ArenaAllocator() {
     for (const auto& r : regions) {
-        sf_mem_free(r.data, DEFAULT_ALIGNMENT);
+        if (r.data == virtual_base && is_virtual()) {
+            platform_mem_release(r.data, r.capacity);
+        } else if (r.data) {
+            free_region_memory(r.data, r.capacity);
+        }
     }
 }
 
 void ArenaAllocator::rewind(Snapshot snapshot) {
     if (snapshot.region_index < regions.count())
     {
+        const usize used_before = used_size();
         Region* r = &regions[snapshot.region_index];
         r->offset = snapshot.region_offset;
         for (usize i = snapshot.region_index + 1; i < regions.count(); ++i)
         {
             regions[i].offset = 0;
         }
+
+        if (is_virtual()) {
+            virtual_decommit(regions[0].offset);
+        }
+        memory_track_free(tag, used_before - used_size());
+    }
+}
+
+usize ArenaAllocator::used_size() const {
+    usize used{0};
+    for (const auto& region : regions) {
+        used += region.offset;
     }
+    return used;
 }
 
 ArenaAllocator::Snapshot ArenaAllocator::make_snapshot() const {
@@ -0,0 +1,138 @@
+#include "sf_allocators/block_chain.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <bit>
+
+namespace sf {
+
+BlockChain::BlockChain(usize first_capacity) noexcept
+    : _blocks{}
+    , _first_capacity{ first_capacity }
+    , _capacity{ 0 }
+{}
+
+BlockChain::BlockChain(BlockChain&& rhs) noexcept
+    : _blocks{}
+    , _first_capacity{ rhs._first_capacity }
+    , _capacity{ rhs._capacity }
+{
+    for (u32 i{0}; i < MAX_BLOCK_COUNT; ++i) {
+        _blocks[i] = rhs._blocks[i];
+        rhs._blocks[i] = nullptr;
+    }
+    rhs._capacity = 0;
+}
+
+BlockChain& BlockChain::operator=(BlockChain&& rhs) noexcept
+{
+    if (this == &rhs) {
+        return *this;
+    }
+
+    release();
+    _first_capacity = rhs._first_capacity;
+    _capacity = rhs._capacity;
+    for (u32 i{0}; i < MAX_BLOCK_COUNT; ++i) {
+        _blocks[i] = rhs._blocks[i];
+        rhs._blocks[i] = nullptr;
+    }
+    rhs._capacity = 0;
+
+    return *this;
+}
+
+BlockChain::~BlockChain() noexcept
+{
+    release();
+}
+
+void BlockChain::release() noexcept
+{
+    for (u8*& block : _blocks) {
+        if (block) {
+            sf_mem_free(block);
+            block = nullptr;
+        }
+    }
+    _capacity = 0;
+}
+
+u32 BlockChain::block_index(usize offset) const noexcept
+{
+    // block i starts at first_capacity * (2^i - 1)
+    return static_cast<u32>(std::bit_width(offset / _first_capacity + 1) - 1);
+}
+
+u32 BlockChain::block_count() const noexcept
+{
+    u32 count{0};
+    for (u8* block : _blocks) {
+        count += block != nullptr;
+    }
+    return count;
+}
+
+BlockChain::Placement BlockChain::place(usize offset, usize size, u16 alignment, u16 header_size) noexcept
+{
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    u32 index = block_index(offset);
+
+    while (index < MAX_BLOCK_COUNT) {
+        const usize start = block_start(index);
+        const usize capacity = block_capacity(index);
+
+        if (!_blocks[index]) {
+            // block which can't fit the allocation even with the worst padding is left unallocated
+            if (capacity < size + header_size + alignment) {
+                ++index;
+                offset = block_start(index);
+                continue;
+            }
+            _blocks[index] = static_cast<u8*>(sf_mem_alloc(capacity));
+            _capacity += capacity;
+        }
+
+        u8* ptr = _blocks[index] + (offset - start);
+        usize padding = header_size > 0 ? calc_padding_with_header(ptr, alignment, header_size) : sf_calc_padding(ptr, alignment);
+        if (offset + padding + size <= start + capacity) {
+            return { offset, padding };
+        }
+
+        ++index;
+        offset = block_start(index);
+    }
+
+    LOG_ERROR("BlockChain: max block count {} is reached", MAX_BLOCK_COUNT);
+    return { INVALID_ALLOC_HANDLE, 0 };
+}
+
+u8* BlockChain::offset_to_ptr(usize offset) const noexcept
+{
+    const u32 index = block_index(offset);
+    if (index >= MAX_BLOCK_COUNT || !_blocks[index]) {
+        return nullptr;
+    }
+    return _blocks[index] + (offset - block_start(index));
+}
+
+usize BlockChain::ptr_to_offset(const void* ptr) const noexcept
+{
+    const u8* ptr_u8 = static_cast<const u8*>(ptr);
+    for (u32 i{0}; i < MAX_BLOCK_COUNT; ++i) {
+        if (_blocks[i] && ptr_u8 >= _blocks[i] && ptr_u8 < _blocks[i] + block_capacity(i)) {
+            return block_start(i) + (ptr_u8 - _blocks[i]);
+        }
+    }
+    return INVALID_ALLOC_HANDLE;
+}
+
+bool BlockChain::owns(const void* ptr) const noexcept
+{
+    return ptr_to_offset(ptr) != INVALID_ALLOC_HANDLE;
+}
+
+} // sf
@@ -0,0 +1,194 @@
+#include "sf_allocators/frame_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include "sf_core/utility.hpp"
+#include "sf_platform/platform.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace sf {
+
+static usize align_to_commit_granularity(usize size) {
+    const usize granularity = get_mem_page_size() * static_cast<usize>(FrameAllocator::COMMIT_PAGES);
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+FrameAllocator::FrameAllocator() noexcept
+    : FrameAllocator(DEFAULT_FRAME_CAPACITY)
+{}
+
+FrameAllocator::FrameAllocator(usize frame_capacity) noexcept
+    : _base{ nullptr }
+    , _frame_capacity{ 0 }
+    , _regions{}
+    , _curr_frame{ 0 }
+    , _is_virtual{ false }
+    , _tag{ MemoryTag::FRAME }
+{
+    // handles are 32 bit offsets from the base
+    const usize granularity = align_to_commit_granularity(1);
+    const usize max_frame_capacity = std::numeric_limits<u32>::max() / FRAME_COUNT / granularity * granularity;
+    _frame_capacity = std::min(align_to_commit_granularity(frame_capacity), max_frame_capacity);
+
+    _base = static_cast<u8*>(platform_mem_reserve(_frame_capacity * FRAME_COUNT));
+    _is_virtual = _base != nullptr;
+
+    if (!_is_virtual) {
+        LOG_WARN("FrameAllocator: failed to reserve virtual memory, falling back to heap");
+        _base = static_cast<u8*>(sf_mem_alloc(_frame_capacity * FRAME_COUNT, DEFAULT_ALIGNMENT));
+    }
+
+    for (u32 i{0}; i < FRAME_COUNT; ++i) {
+        _regions[i].data = _base + _frame_capacity * i;
+        _regions[i].committed = _is_virtual ? 0 : _frame_capacity;
+        _regions[i].last_offset = INVALID_ALLOC_HANDLE;
+    }
+}
+
+FrameAllocator::~FrameAllocator() noexcept
+{
+    if (!_base) {
+        return;
+    }
+
+    if (_is_virtual) {
+        platform_mem_release(_base, _frame_capacity * FRAME_COUNT);
+    } else {
+        sf_mem_free(_base, DEFAULT_ALIGNMENT);
+    }
+    _base = nullptr;
+}
+
+bool FrameAllocator::commit(Region& region, usize end_offset) noexcept
+{
+    if (end_offset <= region.committed) {
+        return true;
+    }
+
+    const usize new_committed = std::min(align_to_commit_granularity(end_offset), _frame_capacity);
+    if (!platform_mem_commit(region.data + region.committed, new_committed - region.committed)) {
+        LOG_FATAL("FrameAllocator: failed to commit {} bytes", new_committed - region.committed);
+        return false;
+    }
+    region.committed = new_committed;
+    return true;
+}
+
+void* FrameAllocator::allocate(usize size, u16 alignment) noexcept
+{
+    if (alignment == 0) {
+        alignment = DEFAULT_ALIGNMENT;
+    }
+
+    Region& region = _regions[_curr_frame];
+    const usize padding = sf_calc_padding(region.data + region.offset, alignment);
+    const usize end_offset = region.offset + padding + size;
+
+    if (end_offset > _frame_capacity) {
+        LOG_ERROR("FrameAllocator: frame capacity {} is exceeded, requested size: {}", _frame_capacity, size);
+        return nullptr;
+    }
+    if (!commit(region, end_offset)) {
+        return nullptr;
+    }
+
+    void* addr = region.data + region.offset + padding;
+    region.last_offset = region.offset + padding;
+    region.offset = end_offset;
+    region.peak_offset = std::max(region.peak_offset, end_offset);
+    memory_track_alloc(_tag, padding + size);
+    return addr;
+}
+
+usize FrameAllocator::allocate_handle(usize size, u16 alignment) noexcept
+{
+    void* addr = allocate(size, alignment);
+    if (!addr) {
+        return INVALID_ALLOC_HANDLE;
+    }
+    return turn_ptr_into_handle(addr, _base);
+}
+
+ReallocReturn FrameAllocator::reallocate(void* addr, usize new_size, u16 alignment) noexcept
+{
+    if (addr == nullptr) {
+        return {allocate(new_size, alignment), false};
+    }
+
+    Region& region = _regions[_curr_frame];
+    if (!is_address_in_range(_base, _frame_capacity * FRAME_COUNT, addr)) {
+        return {nullptr, false};
+    }
+
+    // the last allocation of the frame is resized in place
+    if (region.last_offset != INVALID_ALLOC_HANDLE && addr == region.data + region.last_offset) {
+        const usize end_offset = region.last_offset + new_size;
+        if (end_offset <= _frame_capacity && commit(region, end_offset)) {
+            if (end_offset > region.offset) {
+                memory_track_alloc(_tag, end_offset - region.offset);
+            } else {
+                memory_track_free(_tag, region.offset - end_offset);
+            }
+            region.offset = end_offset;
+            region.peak_offset = std::max(region.peak_offset, end_offset);
+            return {addr, false};
+        }
+    }
+
+    return {allocate(new_size, alignment), true};
+}
+
+ReallocReturnHandle FrameAllocator::reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept
+{
+    if (handle == INVALID_ALLOC_HANDLE) {
+        return {allocate_handle(new_size, alignment), false};
+    }
+
+    ReallocReturn res = reallocate(handle_to_ptr(handle), new_size, alignment);
+    if (!res.ptr) {
+        return {INVALID_ALLOC_HANDLE, false};
+    }
+    return {turn_ptr_into_handle(res.ptr, _base), res.should_mem_copy};
+}
+
+void* FrameAllocator::handle_to_ptr(usize handle) const noexcept
+{
+#ifdef SF_DEBUG
+    if (handle == INVALID_ALLOC_HANDLE || !is_handle_in_range(_base, _frame_capacity * FRAME_COUNT, handle)) {
+        return nullptr;
+    }
+#endif
+
+    return _base + handle;
+}
+
+usize FrameAllocator::ptr_to_handle(void* ptr) const noexcept
+{
+#ifdef SF_DEBUG
+    if (ptr == nullptr || !is_address_in_range(_base, _frame_capacity * FRAME_COUNT, ptr)) {
+        return INVALID_ALLOC_HANDLE;
+    }
+#endif
+
+    return turn_ptr_into_handle(ptr, _base);
+}
+
+void FrameAllocator::clear() noexcept
+{
+    Region& region = _regions[_curr_frame];
+    memory_track_free(_tag, region.offset);
+    region.offset = 0;
+    region.last_offset = INVALID_ALLOC_HANDLE;
+}
+
+void FrameAllocator::end_frame() noexcept
+{
+    _curr_frame = (_curr_frame + 1) % FRAME_COUNT;
+    // committed pages are kept, so steady state frames don't touch the page tables
+    clear();
+}
+
+} // sf
@@ -3,21 +3,153 @@
 #include "sf_core/asserts_sf.hpp"
 #include "sf_core/constants.hpp"
 #include "sf_core/defines.hpp"
+#include "sf_core/logger.hpp"
 #include "sf_core/memory_sf.hpp"
+#include "sf_core/utility.hpp"
+#include "sf_platform/platform.hpp"
+#include <algorithm>
 
 namespace sf {
 
+// every block is prefixed with the header, free/realloc need to know how the block was obtained
+struct GeneralPurposeAllocHeader {
+    // full width, large blocks grown by remapping aren't limited by the size type of a single request
+    usize     size;
+    // distance from the start of the block to the user pointer
+    u16       offset;
+    u16       alignment;
+    // own page mapping instead of heap block
+    bool      is_large;
+#ifdef SF_MEMORY_TRACKING
+    // block is tracked under the tag it was allocated with, even if the allocator is retagged later
+    MemoryTag tag;
+#endif
+};
+
+static constexpr u16 MIN_HEADER_OFFSET{ 16 };
+static_assert(sizeof(GeneralPurposeAllocHeader) <= MIN_HEADER_OFFSET, "Header should fit in front of the user pointer");
+
+static u16 calc_header_offset(u16 alignment) {
+    return alignment > MIN_HEADER_OFFSET ? alignment : MIN_HEADER_OFFSET;
+}
+
+static MemoryTag get_header_tag([[maybe_unused]] const GeneralPurposeAllocHeader* header) {
+#ifdef SF_MEMORY_TRACKING
+    return header->tag;
+#else
+    return MemoryTag::UNKNOWN;
+#endif
+}
+
+static GeneralPurposeAllocHeader* get_alloc_header(void* addr) {
+    return ptr_step_bytes_backward<GeneralPurposeAllocHeader>(addr, sizeof(GeneralPurposeAllocHeader));
+}
+
+static usize calc_mapping_size(usize byte_size) {
+    const usize page_size = get_mem_page_size();
+    return (byte_size + page_size - 1) / page_size * page_size;
+}
+
+static bool should_use_large_block(usize byte_size, u16 alignment) {
+    // mapping is only page aligned
+    return byte_size >= GeneralPurposeAllocator::LARGE_BLOCK_SIZE && alignment <= get_mem_page_size();
+}
+
+static u8* map_large_block(usize mapping_size) {
+    u8* block = static_cast<u8*>(platform_mem_reserve(mapping_size));
+    if (!block || !platform_mem_commit(block, mapping_size)) {
+        LOG_FATAL("Out of memory, requested size: {}", mapping_size);
+        panic("Ending the program");
+    }
+    return block;
+}
+
+static void* allocate_block(u32 size, u16 alignment, MemoryTag tag) {
+    const u16 offset = calc_header_offset(alignment);
+    const usize block_size = static_cast<usize>(size) + offset;
+    const bool is_large = should_use_large_block(block_size, alignment);
+
+    u8* block = is_large ? map_large_block(calc_mapping_size(block_size)) : static_cast<u8*>(sf_mem_alloc(block_size, alignment));
+    void* addr = block + offset;
+
+    GeneralPurposeAllocHeader* header = get_alloc_header(addr);
+    header->size = size;
+    header->offset = offset;
+    header->alignment = alignment;
+    header->is_large = is_large;
+#ifdef SF_MEMORY_TRACKING
+    header->tag = tag;
+#endif
+    memory_track_alloc(tag, size);
+    return addr;
+}
+
 void* GeneralPurposeAllocator::allocate(u32 size, u16 alignment) noexcept {
-    return sf_mem_alloc(size, alignment);
+    return allocate_block(size, alignment, _tag);
 }
 
 ReallocReturn GeneralPurposeAllocator::reallocate(void* addr, u32 new_size, u16 alignment) noexcept {
-    return {sf_mem_realloc(addr, new_size), false};
+    if (!addr) {
+        return {allocate(new_size, alignment), false};
+    }
+    if (new_size == 0) {
+        free(addr);
+        return {nullptr, false};
+    }
+
+    GeneralPurposeAllocHeader* header = get_alloc_header(addr);
+    const u16 offset = header->offset;
+    // user pointer is aligned to the header offset
+    const bool is_aligned = alignment <= offset;
+    const usize new_block_size = static_cast<usize>(new_size) + offset;
+
+    // large block stays large -> pages are moved by the os, nothing is copied
+    if (header->is_large && is_aligned && new_block_size >= LARGE_BLOCK_SIZE) {
+        const usize old_mapping_size = calc_mapping_size(header->size + offset);
+        const usize new_mapping_size = calc_mapping_size(new_block_size);
+        memory_track_free(get_header_tag(header), header->size);
+        memory_track_alloc(get_header_tag(header), new_size);
+
+        if (old_mapping_size != new_mapping_size) {
+            u8* block = static_cast<u8*>(platform_mem_remap(ptr_step_bytes_backward(addr, offset), old_mapping_size, new_mapping_size));
+            if (!block) {
+                LOG_FATAL("Out of memory, requested size: {}", new_mapping_size);
+                panic("Ending the program");
+            }
+            addr = block + offset;
+            header = get_alloc_header(addr);
+        }
+        header->size = new_size;
+        return {addr, false};
+    }
+
+    // heap block shrinks in place
+    if (!header->is_large && is_aligned && new_size <= header->size) {
+        memory_track_free(get_header_tag(header), header->size - new_size);
+        header->size = new_size;
+        return {addr, false};
+    }
+
+    void* new_addr = allocate_block(new_size, std::max(alignment, header->alignment), get_header_tag(header));
+    sf_mem_copy(new_addr, addr, std::min<usize>(header->size, new_size));
+    free(addr);
+    return {new_addr, false};
 }
 
 void GeneralPurposeAllocator::free(void* addr) noexcept {
-    sf_mem_free(addr);
-    addr = nullptr;
+    if (!addr) {
+        return;
+    }
+
+    GeneralPurposeAllocHeader* header = get_alloc_header(addr);
+    memory_track_free(get_header_tag(header), header->size);
+    u8* block = ptr_step_bytes_backward<u8>(addr, header->offset);
+
+    if (header->is_large) {
+        platform_mem_release(block, calc_mapping_size(header->size + header->offset));
+    } else {
+        sf_mem_free(block, header->alignment);
+    }
 }
 
 void GeneralPurposeAllocator::free_handle(usize handle) noexcept
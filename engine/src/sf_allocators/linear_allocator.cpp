@@ -2,29 +2,29 @@
 #include "sf_containers/traits.hpp"
 #include "sf_core/constants.hpp"
 #include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
 #include "sf_core/utility.hpp"
+#include <utility>
 
 namespace sf {
 
 LinearAllocator::LinearAllocator() noexcept
-    : _capacity{ get_mem_page_size() * 10 }
+    : _chain{ get_mem_page_size() * 10 }
     , _count{ 0 }
-    , _buffer{ static_cast<u8*>(sf_mem_alloc(_capacity)) }
+    , _tag{ MemoryTag::UNKNOWN }
 {}
 
 LinearAllocator::LinearAllocator(usize capacity) noexcept
-    : _capacity{ capacity }
+    : _chain{ capacity > 0 ? capacity : DEFAULT_INIT_CAPACITY }
     , _count{ 0 }
-    , _buffer{ static_cast<u8*>(sf_mem_alloc(capacity)) }
+    , _tag{ MemoryTag::UNKNOWN }
 {}
 
 LinearAllocator::LinearAllocator(LinearAllocator&& rhs) noexcept
-    : _capacity{ rhs._capacity }
+    : _chain{ std::move(rhs._chain) }
     , _count{ rhs._count }
-    , _buffer{ rhs._buffer }
+    , _tag{ rhs._tag }
 {
-    rhs._buffer = nullptr;
-    rhs._capacity = 0;
     rhs._count = 0;
 }
 
@@ -32,52 +32,39 @@ LinearAllocator& LinearAllocator::operator=(LinearAllocator&& rhs) noexcept {
     if (this == &rhs) {
         return *this;
     }
-    
-    if (_buffer) {
-        sf_mem_free(_buffer, _capacity);
-        _buffer = nullptr;
-    }
 
-    _buffer = rhs._buffer;
-    _capacity = rhs._capacity;
+    _chain = std::move(rhs._chain);
     _count = rhs._count;
+    _tag = rhs._tag;
 
-    rhs._buffer = nullptr;
-    rhs._capacity = 0;
     rhs._count = 0;
 
     return *this;
 }
 
-LinearAllocator::~LinearAllocator() noexcept
-{
-    if (_buffer) {
-        sf_mem_free(_buffer, _capacity);
-        _buffer = nullptr;
-    }
-}
-
 void* LinearAllocator::allocate(usize size, u16 alignment) noexcept
 {
-    usize padding = sf_calc_padding(_buffer + _count, alignment);
-
-    if (_count + padding + size > _capacity) {
-        u32 new_capacity = _capacity == 0 ? DEFAULT_INIT_CAPACITY : _capacity * 2;
-        while (_count + padding + size > new_capacity) {
-            new_capacity *= 2;
-        }
-        resize(new_capacity);
+    BlockChain::Placement placement = _chain.place(_count, size, alignment, 0);
+    if (placement.offset == INVALID_ALLOC_HANDLE) {
+        return nullptr;
     }
 
-    void* addr_to_return = _buffer + _count + padding;
-    _count += padding + size;
+    void* addr_to_return = _chain.offset_to_ptr(placement.offset) + placement.padding;
+    const usize new_count = placement.offset + placement.padding + size;
+    // skipped tail of the previous block is accounted together with the allocation
+    memory_track_alloc(_tag, new_count - _count);
+    _count = new_count;
 
     return addr_to_return;
 }
 
 usize LinearAllocator::allocate_handle(usize size, u16 alignment) noexcept
 {
-    return turn_ptr_into_handle(allocate(size, alignment), _buffer);
+    void* addr = allocate(size, alignment);
+    if (!addr) {
+        return INVALID_ALLOC_HANDLE;
+    }
+    return _chain.ptr_to_offset(addr);
 }
 
 ReallocReturn LinearAllocator::reallocate(void* addr, usize new_size, u16 alignment) noexcept {
@@ -85,7 +72,7 @@ ReallocReturn LinearAllocator::reallocate(void* addr, usize new_size, u16 alignm
         return {allocate(new_size, alignment), true};
     }
 
-    if (!is_address_in_range(_buffer, _capacity, addr)) {
+    if (!_chain.owns(addr)) {
         return {nullptr, true};
     }
 
@@ -96,40 +83,47 @@ ReallocReturnHandle LinearAllocator::reallocate_handle(usize handle, usize new_s
     if (handle == INVALID_ALLOC_HANDLE) {
         return {allocate_handle(new_size, alignment), true};
     }
-    if (!is_handle_in_range(_buffer, _capacity, handle)) {
+    if (handle > _count) {
         return {INVALID_ALLOC_HANDLE, true};
     }
     return {allocate_handle(new_size, alignment), true};
 }
 
-void LinearAllocator::resize(usize new_capacity) noexcept {
-    _buffer = static_cast<u8*>(sf_mem_realloc(_buffer, new_capacity));
-    _capacity = new_capacity;
-}
-
 void* LinearAllocator::handle_to_ptr(usize handle) const noexcept {
 #ifdef SF_DEBUG
-    if (!is_handle_in_range(_buffer, _capacity, handle) || handle == INVALID_ALLOC_HANDLE) {
+    if (handle == INVALID_ALLOC_HANDLE || handle > _count) {
         return nullptr;
     }
 #endif
 
-    return _buffer + handle;
+    return _chain.offset_to_ptr(handle);
 }
 
 usize LinearAllocator::ptr_to_handle(void* ptr) const noexcept {
-#ifdef SF_DEBUG
-    if (!is_address_in_range(_buffer, _capacity, ptr) || ptr == nullptr) {
+    if (ptr == nullptr) {
         return INVALID_ALLOC_HANDLE;
     }
-#endif
 
-    return turn_ptr_into_handle(ptr, _buffer);
+    return _chain.ptr_to_offset(ptr);
 }
 
 void LinearAllocator::clear() noexcept
 {
+    memory_track_free(_tag, _count);
     _count = 0;
 }
 
+LinearAllocator::Snapshot LinearAllocator::make_snapshot() const noexcept {
+    return { _count };
+}
+
+void LinearAllocator::rewind(Snapshot snapshot) noexcept {
+    if (snapshot.count > _count) {
+        return;
+    }
+
+    memory_track_free(_tag, _count - snapshot.count);
+    _count = snapshot.count;
+}
+
 } // sf
@@ -0,0 +1,300 @@
+#include "sf_allocators/thread_cache_allocator.hpp"
+#include "sf_allocators/stack_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include <algorithm>
+#include <bit>
+#include <mutex>
+
+namespace sf {
+
+static constexpr u32 LARGE_SIZE_CLASS{ INVALID_ID };
+static constexpr usize SCRATCH_INIT_CAPACITY{ 64 * 1024 };
+
+struct ThreadCacheChunk {
+    // all chunks of the size class, keeps them reachable
+    ThreadCacheChunk* next;
+    // total size of the allocation for large chunks
+    usize             byte_size;
+    u32               size_class;
+    // offset of the payload for large chunks
+    u32               data_offset;
+};
+
+static_assert(sizeof(ThreadCacheChunk) <= ThreadCacheAllocator::CHUNK_HEADER_SIZE);
+
+struct ThreadCacheFreeNode {
+    ThreadCacheFreeNode* next;
+};
+
+struct CentralFreeList {
+    std::mutex           mutex;
+    ThreadCacheFreeNode* head;
+    u32                  count;
+    ThreadCacheChunk*    chunks;
+};
+
+struct ThreadCacheList {
+    ThreadCacheFreeNode* head;
+    u32                  count;
+};
+
+struct ThreadCache {
+    ThreadCacheList lists[ThreadCacheAllocator::SIZE_CLASS_COUNT];
+    usize           cached_bytes;
+
+    ~ThreadCache() noexcept
+    {
+        ThreadCacheAllocator::flush_thread_cache();
+    }
+};
+
+// chunks are never given back to the OS, objects freed by other threads may still live in them
+static CentralFreeList central_lists[ThreadCacheAllocator::SIZE_CLASS_COUNT];
+static thread_local ThreadCache thread_cache;
+
+static u32 size_to_class(usize size) {
+    if (size <= 128) {
+        return size == 0 ? 0 : static_cast<u32>((size + 15) / 16 - 1);
+    }
+    // 2^(p-1) < size <= 2^p, range is split into 4 classes
+    const u32 p = static_cast<u32>(std::bit_width(size - 1));
+    const usize range_start = static_cast<usize>(1) << (p - 1);
+    const usize step = static_cast<usize>(1) << (p - 3);
+    const u32 sub = static_cast<u32>((size - range_start + step - 1) / step - 1);
+    return 8 + (p - 8) * 4 + sub;
+}
+
+static usize class_to_size(u32 size_class) {
+    if (size_class < 8) {
+        return (size_class + 1) * 16;
+    }
+    const u32 p = 8 + (size_class - 8) / 4;
+    const u32 sub = (size_class - 8) % 4;
+    return (static_cast<usize>(1) << (p - 1)) + (sub + 1) * (static_cast<usize>(1) << (p - 3));
+}
+
+// how many blocks move between thread and central lists at once
+static u32 class_batch_count(u32 size_class) {
+    return static_cast<u32>(std::clamp<usize>(8 * 1024 / class_to_size(size_class), 2, 32));
+}
+
+static ThreadCacheChunk* chunk_from_ptr(void* addr) {
+    return reinterpret_cast<ThreadCacheChunk*>(reinterpret_cast<usize>(addr) & ~(ThreadCacheAllocator::CHUNK_SIZE - 1));
+}
+
+// expects central list lock to be held
+static void central_carve_chunk(CentralFreeList& central, u32 size_class) {
+    const usize object_size = class_to_size(size_class);
+    const u32 object_count = static_cast<u32>((ThreadCacheAllocator::CHUNK_SIZE - ThreadCacheAllocator::CHUNK_HEADER_SIZE) / object_size);
+
+    u8* memory = static_cast<u8*>(sf_mem_alloc(ThreadCacheAllocator::CHUNK_SIZE, ThreadCacheAllocator::CHUNK_SIZE));
+    ThreadCacheChunk* chunk = reinterpret_cast<ThreadCacheChunk*>(memory);
+    chunk->next = central.chunks;
+    chunk->byte_size = ThreadCacheAllocator::CHUNK_SIZE;
+    chunk->size_class = size_class;
+    chunk->data_offset = ThreadCacheAllocator::CHUNK_HEADER_SIZE;
+    central.chunks = chunk;
+
+    u8* data = memory + ThreadCacheAllocator::CHUNK_HEADER_SIZE;
+    for (u32 i = object_count; i > 0; --i) {
+        ThreadCacheFreeNode* node = reinterpret_cast<ThreadCacheFreeNode*>(data + (i - 1) * object_size);
+        node->next = central.head;
+        central.head = node;
+    }
+    central.count += object_count;
+}
+
+static void fetch_from_central(ThreadCacheList& list, u32 size_class) {
+    CentralFreeList& central = central_lists[size_class];
+    const u32 batch_count = class_batch_count(size_class);
+
+    std::lock_guard lock{ central.mutex };
+    if (central.count < batch_count) {
+        central_carve_chunk(central, size_class);
+    }
+
+    for (u32 i{0}; i < batch_count; ++i) {
+        ThreadCacheFreeNode* node = central.head;
+        central.head = node->next;
+        node->next = list.head;
+        list.head = node;
+    }
+    central.count -= batch_count;
+    list.count += batch_count;
+    thread_cache.cached_bytes += batch_count * class_to_size(size_class);
+}
+
+static void return_to_central(ThreadCacheList& list, u32 size_class, u32 return_count) {
+    if (return_count == 0) {
+        return;
+    }
+
+    // detach first 'return_count' nodes, then splice them at once
+    ThreadCacheFreeNode* first = list.head;
+    ThreadCacheFreeNode* last = first;
+    for (u32 i{1}; i < return_count; ++i) {
+        last = last->next;
+    }
+    list.head = last->next;
+    list.count -= return_count;
+    thread_cache.cached_bytes -= return_count * class_to_size(size_class);
+
+    CentralFreeList& central = central_lists[size_class];
+    std::lock_guard lock{ central.mutex };
+    last->next = central.head;
+    central.head = first;
+    central.count += return_count;
+}
+
+static void* allocate_large(usize size, u16 alignment) {
+    SF_ASSERT_MSG(alignment < ThreadCacheAllocator::CHUNK_SIZE, "ThreadCacheAllocator: alignment is too big");
+    const usize data_offset = std::max<usize>(ThreadCacheAllocator::CHUNK_HEADER_SIZE, alignment);
+    const usize byte_size = data_offset + size;
+
+    ThreadCacheChunk* chunk = static_cast<ThreadCacheChunk*>(sf_mem_alloc(byte_size, ThreadCacheAllocator::CHUNK_SIZE));
+    chunk->next = nullptr;
+    chunk->byte_size = byte_size;
+    chunk->size_class = LARGE_SIZE_CLASS;
+    chunk->data_offset = static_cast<u32>(data_offset);
+    memory_track_alloc(MemoryTag::THREAD, size);
+    return reinterpret_cast<u8*>(chunk) + data_offset;
+}
+
+void* ThreadCacheAllocator::allocate(usize size, u16 alignment) noexcept
+{
+    if (size > MAX_SMALL_SIZE || alignment > MIN_ALIGNMENT) {
+        return allocate_large(size, alignment);
+    }
+
+    const u32 size_class = size_to_class(size);
+    ThreadCacheList& list = thread_cache.lists[size_class];
+    if (!list.head) {
+        fetch_from_central(list, size_class);
+    }
+
+    ThreadCacheFreeNode* node = list.head;
+    list.head = node->next;
+    --list.count;
+    thread_cache.cached_bytes -= class_to_size(size_class);
+    memory_track_alloc(MemoryTag::THREAD, class_to_size(size_class));
+    return node;
+}
+
+void ThreadCacheAllocator::free(void* addr) noexcept
+{
+    if (!addr) {
+        return;
+    }
+
+    ThreadCacheChunk* chunk = chunk_from_ptr(addr);
+    if (chunk->size_class == LARGE_SIZE_CLASS) {
+        memory_track_free(MemoryTag::THREAD, chunk->byte_size - chunk->data_offset);
+        sf_mem_free(chunk, CHUNK_SIZE);
+        return;
+    }
+
+    const u32 size_class = chunk->size_class;
+    ThreadCacheList& list = thread_cache.lists[size_class];
+    ThreadCacheFreeNode* node = static_cast<ThreadCacheFreeNode*>(addr);
+    node->next = list.head;
+    list.head = node;
+    ++list.count;
+    thread_cache.cached_bytes += class_to_size(size_class);
+    memory_track_free(MemoryTag::THREAD, class_to_size(size_class));
+
+    // keep one batch cached, so alternating alloc/free doesn't bounce between lists
+    const u32 batch_count = class_batch_count(size_class);
+    if (list.count > batch_count * 2) {
+        return_to_central(list, size_class, batch_count);
+    }
+}
+
+usize ThreadCacheAllocator::block_size(void* addr) noexcept
+{
+    ThreadCacheChunk* chunk = chunk_from_ptr(addr);
+    if (chunk->size_class == LARGE_SIZE_CLASS) {
+        return chunk->byte_size - chunk->data_offset;
+    }
+    return class_to_size(chunk->size_class);
+}
+
+ReallocReturn ThreadCacheAllocator::reallocate(void* addr, usize new_size, u16 alignment) noexcept
+{
+    if (!addr) {
+        return {allocate(new_size, alignment), false};
+    }
+    if (new_size == 0) {
+        free(addr);
+        return {nullptr, false};
+    }
+
+    // keep the block while it's not more than twice as big as needed
+    const usize old_size = block_size(addr);
+    const bool is_aligned = alignment <= MIN_ALIGNMENT || reinterpret_cast<usize>(addr) % alignment == 0;
+    if (new_size <= old_size && new_size > old_size / 2 && is_aligned) {
+        return {addr, false};
+    }
+
+    void* new_addr = allocate(new_size, alignment);
+    sf_mem_copy(new_addr, addr, std::min(old_size, new_size));
+    free(addr);
+    return {new_addr, false};
+}
+
+void ThreadCacheAllocator::flush_thread_cache() noexcept
+{
+    for (u32 size_class{0}; size_class < SIZE_CLASS_COUNT; ++size_class) {
+        ThreadCacheList& list = thread_cache.lists[size_class];
+        return_to_central(list, size_class, list.count);
+    }
+}
+
+usize ThreadCacheAllocator::thread_cache_size() noexcept
+{
+    return thread_cache.cached_bytes;
+}
+
+usize ThreadCacheAllocator::allocate_handle(usize size, u16 alignment) noexcept
+{
+    SF_ASSERT_MSG(false, "You are using ThreadCacheAllocator with handles");
+    return INVALID_ALLOC_HANDLE;
+}
+
+ReallocReturnHandle ThreadCacheAllocator::reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept
+{
+    SF_ASSERT_MSG(false, "You are using ThreadCacheAllocator with handles");
+    return {INVALID_ALLOC_HANDLE, false};
+}
+
+void* ThreadCacheAllocator::handle_to_ptr(usize handle) const noexcept
+{
+    SF_ASSERT_MSG(false, "You are using ThreadCacheAllocator with handles");
+    return nullptr;
+}
+
+usize ThreadCacheAllocator::ptr_to_handle(void* ptr) const noexcept
+{
+    SF_ASSERT_MSG(false, "You are using ThreadCacheAllocator with handles");
+    return INVALID_ALLOC_HANDLE;
+}
+
+void ThreadCacheAllocator::free_handle(usize handle) noexcept
+{
+    SF_ASSERT_MSG(false, "You are using ThreadCacheAllocator with handles");
+}
+
+StackAllocator& thread_scratch_allocator() noexcept
+{
+    static thread_local StackAllocator scratch = []{
+        StackAllocator allocator{ SCRATCH_INIT_CAPACITY };
+        allocator.set_memory_tag(MemoryTag::THREAD);
+        return allocator;
+    }();
+    return scratch;
+}
+
+} // sf
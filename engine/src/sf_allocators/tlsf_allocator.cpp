@@ -0,0 +1,483 @@
+#include "sf_allocators/tlsf_allocator.hpp"
+#include "sf_containers/traits.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/constants.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include <bit>
+
+namespace sf {
+
+static constexpr usize TLSF_BLOCK_FREE_BIT{ 1 };
+static constexpr usize TLSF_BLOCK_SIZE_MASK{ ~(static_cast<usize>(TLSFAllocator::ALIGN_SIZE) - 1) };
+// pool has to fit first block header, minimal payload and the sentinel header
+static constexpr usize TLSF_POOL_OVERHEAD{ TLSFAllocator::HEADER_SIZE * 2 };
+
+static inline usize block_size(const TLSFBlockHeader* block) {
+    return block->size_and_flags & TLSF_BLOCK_SIZE_MASK;
+}
+
+static inline void block_set_size(TLSFBlockHeader* block, usize size) {
+    block->size_and_flags = size | (block->size_and_flags & TLSF_BLOCK_FREE_BIT);
+}
+
+static inline bool block_is_free(const TLSFBlockHeader* block) {
+    return block->size_and_flags & TLSF_BLOCK_FREE_BIT;
+}
+
+static inline void block_mark_free(TLSFBlockHeader* block) {
+    block->size_and_flags |= TLSF_BLOCK_FREE_BIT;
+}
+
+static inline void block_mark_used(TLSFBlockHeader* block) {
+    block->size_and_flags &= ~TLSF_BLOCK_FREE_BIT;
+}
+
+static inline u8* block_payload(TLSFBlockHeader* block) {
+    return reinterpret_cast<u8*>(block) + TLSFAllocator::HEADER_SIZE;
+}
+
+static inline TLSFBlockHeader* block_from_payload(void* ptr) {
+    return static_cast<TLSFBlockHeader*>(ptr_step_bytes_backward(ptr, TLSFAllocator::HEADER_SIZE));
+}
+
+static inline TLSFBlockHeader* block_next_phys(TLSFBlockHeader* block) {
+    return reinterpret_cast<TLSFBlockHeader*>(block_payload(block) + block_size(block));
+}
+
+static inline TLSFFreeLinks* block_links(TLSFBlockHeader* block) {
+    return reinterpret_cast<TLSFFreeLinks*>(block_payload(block));
+}
+
+static inline usize align_size_up(usize size, usize alignment) {
+    return (size + (alignment - 1)) & ~(alignment - 1);
+}
+
+static inline usize adjust_request_size(usize size) {
+    usize aligned = align_size_up(size, TLSFAllocator::ALIGN_SIZE);
+    return aligned < TLSFAllocator::BLOCK_SIZE_MIN ? TLSFAllocator::BLOCK_SIZE_MIN : aligned;
+}
+
+// index of the most significant set bit
+static inline u32 tlsf_fls(usize value) {
+    return static_cast<u32>(sizeof(usize) * 8 - 1 - std::countl_zero(value));
+}
+
+static inline u32 tlsf_ffs(u32 value) {
+    return static_cast<u32>(std::countr_zero(value));
+}
+
+static void mapping_insert(usize size, u32& fl, u32& sl) {
+    if (size < TLSFAllocator::SMALL_BLOCK_SIZE) {
+        // small blocks are linearly split into the first level
+        fl = 0;
+        sl = static_cast<u32>(size) / (TLSFAllocator::SMALL_BLOCK_SIZE / TLSFAllocator::SL_INDEX_COUNT);
+    } else {
+        u32 msb = tlsf_fls(size);
+        sl = static_cast<u32>(size >> (msb - TLSFAllocator::SL_INDEX_COUNT_LOG2)) ^ TLSFAllocator::SL_INDEX_COUNT;
+        fl = msb - (TLSFAllocator::FL_INDEX_SHIFT - 1);
+    }
+}
+
+// rounds size up to the next list, so that any block from that list satisfies the request
+static void mapping_search(usize size, u32& fl, u32& sl) {
+    if (size >= TLSFAllocator::SMALL_BLOCK_SIZE) {
+        usize round = (static_cast<usize>(1) << (tlsf_fls(size) - TLSFAllocator::SL_INDEX_COUNT_LOG2)) - 1;
+        size += round;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+TLSFAllocator::TLSFAllocator() noexcept
+    : TLSFAllocator(DEFAULT_INIT_CAPACITY, true)
+{}
+
+TLSFAllocator::TLSFAllocator(usize capacity, bool resizable) noexcept
+    : _fl_bitmap{ 0 }
+    , _sl_bitmap{}
+    , _free_blocks{}
+    , _pools{}
+    , _capacity{ 0 }
+    , _used{ 0 }
+    , _tag{ MemoryTag::UNKNOWN }
+    , _resizable{ resizable }
+{
+    add_pool(capacity);
+}
+
+TLSFAllocator::~TLSFAllocator() noexcept
+{
+    for (Pool& pool : _pools) {
+        sf_mem_free(pool.data);
+    }
+    _pools.clear();
+    _capacity = 0;
+}
+
+bool TLSFAllocator::add_pool(usize capacity) noexcept
+{
+    if (_pools.is_full()) {
+        LOG_WARN("TLSFAllocator: pool limit is reached");
+        return false;
+    }
+
+    capacity = align_size_up(capacity, ALIGN_SIZE);
+    if (capacity < TLSF_POOL_OVERHEAD + BLOCK_SIZE_MIN) {
+        capacity = TLSF_POOL_OVERHEAD + BLOCK_SIZE_MIN;
+    }
+    if (capacity - TLSF_POOL_OVERHEAD >= BLOCK_SIZE_MAX) {
+        capacity = BLOCK_SIZE_MAX - ALIGN_SIZE + TLSF_POOL_OVERHEAD;
+    }
+
+    Pool pool{ static_cast<u8*>(sf_mem_alloc(capacity)), capacity };
+    init_pool(pool);
+    _pools.append(pool);
+    _capacity += capacity;
+    return true;
+}
+
+void TLSFAllocator::init_pool(Pool& pool) noexcept
+{
+    // one free block spanning the whole pool, followed by zero-sized used sentinel
+    TLSFBlockHeader* block = reinterpret_cast<TLSFBlockHeader*>(pool.data);
+    block->prev_phys = nullptr;
+    block->size_and_flags = pool.capacity - TLSF_POOL_OVERHEAD;
+    block_mark_free(block);
+
+    TLSFBlockHeader* sentinel = block_next_phys(block);
+    sentinel->prev_phys = block;
+    sentinel->size_and_flags = 0;
+
+    insert_free_block(block);
+}
+
+bool TLSFAllocator::owns(void* addr) const noexcept
+{
+    for (const Pool& pool : _pools) {
+        if (addr >= pool.data && addr < pool.data + pool.capacity) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TLSFAllocator::insert_free_block(TLSFBlockHeader* block) noexcept
+{
+    u32 fl, sl;
+    mapping_insert(block_size(block), fl, sl);
+
+    TLSFBlockHeader* head = _free_blocks[fl][sl];
+    TLSFFreeLinks* links = block_links(block);
+    links->next_free = head;
+    links->prev_free = nullptr;
+    if (head) {
+        block_links(head)->prev_free = block;
+    }
+
+    _free_blocks[fl][sl] = block;
+    _fl_bitmap |= (1U << fl);
+    _sl_bitmap[fl] |= (1U << sl);
+}
+
+void TLSFAllocator::remove_free_block(TLSFBlockHeader* block) noexcept
+{
+    u32 fl, sl;
+    mapping_insert(block_size(block), fl, sl);
+
+    TLSFFreeLinks* links = block_links(block);
+    if (links->next_free) {
+        block_links(links->next_free)->prev_free = links->prev_free;
+    }
+    if (links->prev_free) {
+        block_links(links->prev_free)->next_free = links->next_free;
+    }
+
+    if (_free_blocks[fl][sl] == block) {
+        _free_blocks[fl][sl] = links->next_free;
+        if (!links->next_free) {
+            _sl_bitmap[fl] &= ~(1U << sl);
+            if (!_sl_bitmap[fl]) {
+                _fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+}
+
+TLSFBlockHeader* TLSFAllocator::locate_free_block(usize size) noexcept
+{
+    if (size >= BLOCK_SIZE_MAX) {
+        return nullptr;
+    }
+
+    u32 fl, sl;
+    mapping_search(size, fl, sl);
+    if (fl >= FL_INDEX_COUNT) {
+        return nullptr;
+    }
+
+    // search in the same first level list, then in the next non-empty one
+    u32 sl_map = _sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+        u32 fl_map = fl + 1 < 32 ? _fl_bitmap & (~0U << (fl + 1)) : 0;
+        if (!fl_map) {
+            return nullptr;
+        }
+        fl = tlsf_ffs(fl_map);
+        sl_map = _sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    TLSFBlockHeader* block = _free_blocks[fl][sl];
+    SF_ASSERT_MSG(block && block_size(block) >= size, "TLSFAllocator: free list bitmap is out of sync");
+    remove_free_block(block);
+    return block;
+}
+
+// cuts block to 'size' bytes of payload and returns the remainder as separate block
+TLSFBlockHeader* TLSFAllocator::split_block(TLSFBlockHeader* block, usize size) noexcept
+{
+    usize remain_size = block_size(block) - size - HEADER_SIZE;
+    TLSFBlockHeader* remain = reinterpret_cast<TLSFBlockHeader*>(block_payload(block) + size);
+    remain->prev_phys = block;
+    remain->size_and_flags = remain_size;
+    block_next_phys(remain)->prev_phys = remain;
+    block_set_size(block, size);
+    return remain;
+}
+
+TLSFBlockHeader* TLSFAllocator::merge_with_prev(TLSFBlockHeader* block) noexcept
+{
+    TLSFBlockHeader* prev = block->prev_phys;
+    if (!prev || !block_is_free(prev)) {
+        return block;
+    }
+
+    remove_free_block(prev);
+    block_set_size(prev, block_size(prev) + HEADER_SIZE + block_size(block));
+    block_next_phys(prev)->prev_phys = prev;
+    return prev;
+}
+
+TLSFBlockHeader* TLSFAllocator::merge_with_next(TLSFBlockHeader* block) noexcept
+{
+    TLSFBlockHeader* next = block_next_phys(block);
+    if (!block_is_free(next)) {
+        return block;
+    }
+
+    remove_free_block(next);
+    block_set_size(block, block_size(block) + HEADER_SIZE + block_size(next));
+    block_next_phys(block)->prev_phys = block;
+    return block;
+}
+
+void TLSFAllocator::trim_free_tail(TLSFBlockHeader* block, usize size) noexcept
+{
+    if (block_size(block) >= size + HEADER_SIZE + BLOCK_SIZE_MIN) {
+        TLSFBlockHeader* remain = split_block(block, size);
+        block_mark_free(remain);
+        insert_free_block(remain);
+    }
+}
+
+void TLSFAllocator::trim_used_tail(TLSFBlockHeader* block, usize size) noexcept
+{
+    if (block_size(block) >= size + HEADER_SIZE + BLOCK_SIZE_MIN) {
+        TLSFBlockHeader* remain = split_block(block, size);
+        // remainder may border another free block
+        remain = merge_with_next(remain);
+        block_mark_free(remain);
+        insert_free_block(remain);
+    }
+}
+
+void* TLSFAllocator::allocate(usize size, u16 alignment) noexcept
+{
+    usize adjusted = adjust_request_size(size);
+    // leading gap has to fit a whole free block, otherwise it can't be given back
+    constexpr usize gap_min = HEADER_SIZE + BLOCK_SIZE_MIN;
+    bool over_aligned = alignment > ALIGN_SIZE;
+    usize request = over_aligned ? adjust_request_size(adjusted + alignment + gap_min) : adjusted;
+
+    TLSFBlockHeader* block = locate_free_block(request);
+    if (!block) {
+        if (!_resizable) {
+            return nullptr;
+        }
+        usize pool_capacity = _capacity;
+        while (pool_capacity < request + TLSF_POOL_OVERHEAD) {
+            pool_capacity *= 2;
+        }
+        if (!add_pool(pool_capacity)) {
+            return nullptr;
+        }
+        block = locate_free_block(request);
+        if (!block) {
+            return nullptr;
+        }
+    }
+
+    if (over_aligned) {
+        u8* payload = block_payload(block);
+        u8* aligned = static_cast<u8*>(sf_align_forward(payload, alignment));
+        usize gap = aligned - payload;
+        if (gap && gap < gap_min) {
+            aligned = static_cast<u8*>(sf_align_forward(payload + gap_min, alignment));
+            gap = aligned - payload;
+        }
+        if (gap) {
+            TLSFBlockHeader* aligned_block = split_block(block, gap - HEADER_SIZE);
+            block_mark_free(block);
+            insert_free_block(block);
+            block = aligned_block;
+        }
+    }
+
+    trim_free_tail(block, adjusted);
+    block_mark_used(block);
+    _used += block_size(block);
+    memory_track_alloc(_tag, block_size(block));
+    return block_payload(block);
+}
+
+usize TLSFAllocator::allocate_handle(usize size, u16 alignment) noexcept
+{
+    SF_ASSERT_MSG(false, "You are using TLSFAllocator with handles");
+    return INVALID_ALLOC_HANDLE;
+}
+
+ReallocReturn TLSFAllocator::reallocate(void* addr, usize new_size, u16 alignment) noexcept
+{
+    if (addr == nullptr) {
+        return {allocate(new_size, alignment), false};
+    }
+    if (!owns(addr)) {
+        return {nullptr, false};
+    }
+    if (new_size == 0) {
+        free(addr);
+        return {nullptr, false};
+    }
+
+    TLSFBlockHeader* block = block_from_payload(addr);
+    usize curr_size = block_size(block);
+    usize adjusted = adjust_request_size(new_size);
+    bool is_aligned = (reinterpret_cast<usize>(addr) & (alignment - 1)) == 0 || alignment == 0;
+
+    if (is_aligned) {
+        TLSFBlockHeader* next = block_next_phys(block);
+        usize available = block_is_free(next) ? curr_size + HEADER_SIZE + block_size(next) : curr_size;
+        // grow or shrink in place
+        if (available >= adjusted) {
+            if (adjusted > curr_size) {
+                merge_with_next(block);
+            }
+            trim_used_tail(block, adjusted);
+            _used = _used - curr_size + block_size(block);
+            if (block_size(block) > curr_size) {
+                memory_track_alloc(_tag, block_size(block) - curr_size);
+            } else if (block_size(block) < curr_size) {
+                memory_track_free(_tag, curr_size - block_size(block));
+            }
+            return {addr, false};
+        }
+    }
+
+    void* new_addr = allocate(new_size, alignment);
+    if (new_addr) {
+        sf_mem_copy(new_addr, addr, curr_size < new_size ? curr_size : new_size);
+        free(addr);
+    }
+    return {new_addr, false};
+}
+
+ReallocReturnHandle TLSFAllocator::reallocate_handle(usize handle, usize new_size, u16 alignment) noexcept
+{
+    SF_ASSERT_MSG(false, "You are using TLSFAllocator with handles");
+    return {INVALID_ALLOC_HANDLE, false};
+}
+
+void* TLSFAllocator::handle_to_ptr(usize handle) const noexcept
+{
+    SF_ASSERT_MSG(false, "You are using TLSFAllocator with handles");
+    return nullptr;
+}
+
+usize TLSFAllocator::ptr_to_handle(void* ptr) const noexcept
+{
+    SF_ASSERT_MSG(false, "You are using TLSFAllocator with handles");
+    return INVALID_ALLOC_HANDLE;
+}
+
+void TLSFAllocator::free(void* addr) noexcept
+{
+    if (!addr) {
+        return;
+    }
+#ifdef SF_DEBUG
+    if (!owns(addr)) {
+        LOG_WARN("Attempt to free block out of TLSFAllocator pools range");
+        return;
+    }
+#endif
+
+    TLSFBlockHeader* block = block_from_payload(addr);
+    SF_ASSERT_MSG(!block_is_free(block), "TLSFAllocator: double free");
+    _used -= block_size(block);
+    memory_track_free(_tag, block_size(block));
+    block_mark_free(block);
+    block = merge_with_prev(block);
+    block = merge_with_next(block);
+    insert_free_block(block);
+}
+
+void TLSFAllocator::free_handle(usize handle) noexcept
+{
+    SF_ASSERT_MSG(false, "You are using TLSFAllocator with handles");
+}
+
+void TLSFAllocator::clear() noexcept
+{
+    memory_track_free(_tag, _used);
+    _used = 0;
+    _fl_bitmap = 0;
+    sf_mem_zero(_sl_bitmap, sizeof(_sl_bitmap));
+    sf_mem_zero(_free_blocks, sizeof(_free_blocks));
+
+    for (Pool& pool : _pools) {
+        init_pool(pool);
+    }
+}
+
+usize TLSFAllocator::get_remain_space() const noexcept
+{
+    usize remain = 0;
+    for (u32 fl{0}; fl < FL_INDEX_COUNT; ++fl) {
+        for (u32 sl{0}; sl < SL_INDEX_COUNT; ++sl) {
+            for (TLSFBlockHeader* block = _free_blocks[fl][sl]; block; block = block_links(block)->next_free) {
+                remain += block_size(block);
+            }
+        }
+    }
+    return remain;
+}
+
+usize TLSFAllocator::get_largest_free_block() const noexcept
+{
+    if (!_fl_bitmap) {
+        return 0;
+    }
+
+    u32 fl = tlsf_fls(_fl_bitmap);
+    u32 sl = tlsf_fls(_sl_bitmap[fl]);
+    usize largest = 0;
+    for (TLSFBlockHeader* block = _free_blocks[fl][sl]; block; block = block_links(block)->next_free) {
+        if (block_size(block) > largest) {
+            largest = block_size(block);
+        }
+    }
+    return largest;
+}
+
+} // sf
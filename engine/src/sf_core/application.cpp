@@ -3,7 +3,9 @@
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_core/event.hpp"
 #include "sf_core/input.hpp"
+#include "sf_core/job_system.hpp"
 #include "sf_core/logger.hpp"
+#include "sf_core/memory_tracker.hpp"
 #include "sf_core/game_types.hpp"
 #include "sf_containers/optional.hpp"
 #include "sf_platform/platform.hpp"
@@ -17,19 +19,32 @@
 namespace sf {
 
 static const u32 TEMP_ALLOCATOR_INIT_PAGES{ 16 };
+// address space only, pages are committed when resource systems actually use them
+static const usize MAIN_ALLOCATOR_RESERVE_SIZE{ 1024ULL * 1024 * 1024 };
+// texture/material pools and geometry buffers are big and randomly accessed
+static const bool  MAIN_ALLOCATOR_HUGE_PAGES{ true };
+static const usize FRAME_ALLOCATOR_FRAME_CAPACITY{ 64ULL * 1024 * 1024 };
+
+static_assert(FrameAllocator::FRAME_COUNT == VulkanSwapchain::MAX_FRAMES_IN_FLIGHT, "Frame allocator should have a region for every frame in flight");
 
 static ApplicationState state;
 
 ApplicationState::ApplicationState()
-    : temp_allocator{ get_mem_page_size() * TEMP_ALLOCATOR_INIT_PAGES }
+    : main_allocator{ MAIN_ALLOCATOR_RESERVE_SIZE, MAIN_ALLOCATOR_HUGE_PAGES }
+    , temp_allocator{ get_mem_page_size() * TEMP_ALLOCATOR_INIT_PAGES }
+    , frame_allocator{ FRAME_ALLOCATOR_FRAME_CAPACITY }
 {
-    main_allocator.reserve(TextureSystem::get_memory_requirement() + MaterialSystem::get_memory_requirement() + GeometrySystem::get_memory_requirement() + get_mem_page_size());
+    main_allocator.set_memory_tag(MemoryTag::MAIN);
+    temp_allocator.set_memory_tag(MemoryTag::TEMP);
+    if (!main_allocator.is_virtual()) {
+        main_allocator.reserve(GeometrySystem::get_memory_requirement() + get_mem_page_size());
+    }
 }
 
 void application_init_internal_state(const VulkanDevice& device) {
     EventSystem::create(state.event_system);
-    TextureSystem::create(state.main_allocator, device, state.texture_system);
-    MaterialSystem::create(state.main_allocator, state.material_system);
+    TextureSystem::create(device, state.job_system, state.texture_system);
+    MaterialSystem::create(state.material_system);
     GeometrySystem::create(state.main_allocator, state.temp_allocator, state.geometry_system);
 }
 
@@ -38,6 +53,19 @@ bool application_create(GameInstance* game_inst) {
     state.config = game_inst->app_config;
     state.is_running = true;
     state.is_suspended = false;
+    memory_tracker_expect_zero_frame_allocs(state.config.expect_zero_frame_allocs);
+
+    // first, every loader reads files through it
+    if (!AsyncIoSystem::create(AsyncIoBackend::IO_URING, state.async_io)) {
+        LOG_WARN("Failed to start async I/O, files are read synchronously");
+    }
+
+    // before game init, so the game can spread its own startup over the workers
+    if (!JobSystem::create(state.gpa, 0, state.job_system)) {
+        LOG_FATAL("Failed to start the job system");
+        return false;
+    }
+    game_inst->job_system = &state.job_system;
 
     bool platform_init_success = PlatformState::create(game_inst->app_config, state.platform_state);
 
@@ -120,9 +148,14 @@ void application_run() {
             state.frame_count++;
             input_update();
             renderer_end_frame(delta_time);
+            memory_tracker_end_frame();
         }
     }
 
+    state.job_system.destroy();
+    state.async_io.destroy();
+    renderer_shutdown();
+    memory_tracker_log_report();
     state.is_running = false;
 }
 
@@ -177,8 +210,16 @@ StackAllocator& application_get_temp_allocator() {
     return state.temp_allocator;
 }
 
+FrameAllocator& application_get_frame_allocator() {
+    return state.frame_allocator;
+}
+
 GeneralPurposeAllocator& application_get_gpa() {
     return state.gpa;
 }
 
+JobSystem& application_get_job_system() {
+    return state.job_system;
+}
+
 } // sf
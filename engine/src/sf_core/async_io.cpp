@@ -0,0 +1,679 @@
+#include "sf_core/async_io.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_platform/defines.hpp"
+#include <cerrno>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(SF_PLATFORM_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(SF_PLATFORM_LINUX)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace sf {
+
+static AsyncIoSystem* state_ptr{ nullptr };
+
+IoRequest::IoRequest() noexcept
+    : IoRequest(nullptr, nullptr, 0)
+{}
+
+IoRequest::IoRequest(const char* path, void* buffer, u32 size, u64 offset, IoPriority priority) noexcept
+    : path{ path }
+    , buffer{ buffer }
+    , offset{ offset }
+    , size{ size }
+    , priority{ priority }
+    , callback{ nullptr }
+    , user_data{ nullptr }
+    , status{ IoStatus::PENDING }
+    , bytes_read{ 0 }
+    , error{ 0 }
+    , next{ nullptr }
+    , fd{ -1 }
+    , stage{ 0 }
+{}
+
+bool IoRequest::wait() const noexcept {
+    status.wait(IoStatus::PENDING, std::memory_order_acquire);
+    return status.load(std::memory_order_acquire) == IoStatus::DONE;
+}
+
+// FIFO per priority class, linked through 'IoRequest::next'
+struct IoQueue {
+    static constexpr u32 CLASS_COUNT{ static_cast<u32>(IoPriority::COUNT) };
+
+    IoRequest* heads[CLASS_COUNT]{};
+    IoRequest* tails[CLASS_COUNT]{};
+
+    void push(IoRequest* request) noexcept {
+        const u32 priority = static_cast<u32>(request->priority);
+        request->next = nullptr;
+        if (tails[priority]) {
+            tails[priority]->next = request;
+        } else {
+            heads[priority] = request;
+        }
+        tails[priority] = request;
+    }
+
+    // highest class first, nullptr if empty
+    IoRequest* pop() noexcept {
+        for (u32 priority{0}; priority < CLASS_COUNT; ++priority) {
+            if (IoRequest* request = heads[priority]) {
+                heads[priority] = request->next;
+                if (!heads[priority]) {
+                    tails[priority] = nullptr;
+                }
+                request->next = nullptr;
+                return request;
+            }
+        }
+        return nullptr;
+    }
+
+    bool is_empty() const noexcept {
+        for (u32 priority{0}; priority < CLASS_COUNT; ++priority) {
+            if (heads[priority]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+static void close_request_file(IoRequest& request) noexcept {
+    if (request.fd >= 0) {
+    #if defined(SF_PLATFORM_WINDOWS)
+        _close(request.fd);
+    #else
+        close(request.fd);
+    #endif
+        request.fd = -1;
+    }
+}
+
+// callback sees the request still pending, it may be freed by its owner right after the status is stored
+static void complete_request(IoRequest& request, i32 error) noexcept {
+    close_request_file(request);
+    request.error = error;
+    if (request.callback) {
+        request.callback(request);
+    }
+    request.status.store(error == 0 ? IoStatus::DONE : IoStatus::FAILED, std::memory_order_release);
+    request.status.notify_all();
+}
+
+static void reset_request(IoRequest& request) noexcept {
+    request.status.store(IoStatus::PENDING, std::memory_order_relaxed);
+    request.bytes_read = 0;
+    request.error = 0;
+    request.fd = -1;
+}
+
+// blocking open + positional reads, used by the pool and when there is no I/O system
+static void execute_request_sync(IoRequest& request) noexcept {
+#if defined(SF_PLATFORM_WINDOWS)
+    request.fd = _open(request.path, _O_RDONLY | _O_BINARY);
+#else
+    request.fd = open(request.path, O_RDONLY | O_CLOEXEC);
+#endif
+    if (request.fd < 0) {
+        complete_request(request, errno);
+        return;
+    }
+
+    u8* dst = static_cast<u8*>(request.buffer);
+    while (request.bytes_read < request.size) {
+    #if defined(SF_PLATFORM_WINDOWS)
+        // every request has its own descriptor, so seek + read is not racy
+        _lseeki64(request.fd, static_cast<i64>(request.offset + request.bytes_read), SEEK_SET);
+        const i64 result = _read(request.fd, dst + request.bytes_read, request.size - request.bytes_read);
+    #else
+        const i64 result = pread(request.fd, dst + request.bytes_read, request.size - request.bytes_read, static_cast<off_t>(request.offset + request.bytes_read));
+    #endif
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            complete_request(request, errno);
+            return;
+        }
+        if (result == 0) {
+            break;
+        }
+        request.bytes_read += static_cast<u32>(result);
+    }
+    complete_request(request, 0);
+}
+
+// Thread pool backend
+
+struct IoPoolState {
+    std::mutex                  mutex;
+    std::condition_variable     has_work;
+    IoQueue                     queue;
+    bool                        is_stopping{ false };
+    std::thread                 threads[AsyncIoSystem::POOL_THREAD_COUNT];
+};
+
+static void io_pool_thread_loop(IoPoolState* pool) noexcept {
+    while (true) {
+        IoRequest* request;
+        {
+            std::unique_lock lock{ pool->mutex };
+            pool->has_work.wait(lock, [pool] { return pool->is_stopping || !pool->queue.is_empty(); });
+            request = pool->queue.pop();
+            if (!request) {
+                return;
+            }
+        }
+        execute_request_sync(*request);
+    }
+}
+
+static IoPoolState* io_pool_create() noexcept {
+    IoPoolState* pool = sf_mem_construct<IoPoolState>();
+    if (!pool) {
+        return nullptr;
+    }
+    for (std::thread& thread : pool->threads) {
+        thread = std::thread(io_pool_thread_loop, pool);
+    }
+    return pool;
+}
+
+// queued requests are finished before threads exit
+static void io_pool_destroy(IoPoolState* pool) noexcept {
+    {
+        std::lock_guard lock{ pool->mutex };
+        pool->is_stopping = true;
+    }
+    pool->has_work.notify_all();
+    for (std::thread& thread : pool->threads) {
+        thread.join();
+    }
+    delete pool;
+}
+
+static void io_pool_submit(IoPoolState* pool, std::span<IoRequest* const> requests) noexcept {
+    {
+        std::lock_guard lock{ pool->mutex };
+        for (IoRequest* request : requests) {
+            pool->queue.push(request);
+        }
+    }
+    if (requests.size() == 1) {
+        pool->has_work.notify_one();
+    } else {
+        pool->has_work.notify_all();
+    }
+}
+
+// io_uring backend, raw syscalls so there is no liburing dependency
+
+#if defined(SF_PLATFORM_LINUX)
+
+enum IoUringStage : u8 {
+    STAGE_OPEN,
+    STAGE_READ
+};
+
+// ioprio layout from linux/ioprio.h
+static constexpr u16 IOPRIO_CLASS_SHIFT{ 13 };
+static constexpr u16 IOPRIO_CLASS_BEST_EFFORT{ 2 };
+static constexpr u16 IOPRIO_CLASS_IDLE_ONLY{ 3 };
+
+static u16 io_priority_to_ioprio(IoPriority priority) noexcept {
+    switch (priority) {
+        case IoPriority::HIGH: return (IOPRIO_CLASS_BEST_EFFORT << IOPRIO_CLASS_SHIFT) | 0;
+        case IoPriority::NORMAL: return (IOPRIO_CLASS_BEST_EFFORT << IOPRIO_CLASS_SHIFT) | 4;
+        default: return IOPRIO_CLASS_IDLE_ONLY << IOPRIO_CLASS_SHIFT;
+    }
+}
+
+struct IoUringState {
+    i32                 ring_fd{ -1 };
+    void*               sq_ring{ nullptr };
+    usize               sq_ring_size{ 0 };
+    void*               cq_ring{ nullptr };
+    usize               cq_ring_size{ 0 };
+    io_uring_sqe*       sqes{ nullptr };
+    usize               sqes_size{ 0 };
+
+    u32*                sq_head;
+    u32*                sq_tail;
+    u32*                sq_array;
+    u32                 sq_mask;
+    u32                 sq_entry_count;
+    u32*                cq_head;
+    u32*                cq_tail;
+    io_uring_cqe*       cqes;
+    u32                 cq_mask;
+
+    // submission queue, priority queues and counters
+    std::mutex          mutex;
+    IoQueue             queue;
+    u32                 in_flight_count{ 0 };
+    u32                 to_submit_count{ 0 };
+    bool                is_stopping{ false };
+    std::thread         completion_thread;
+};
+
+static i32 io_uring_setup_syscall(u32 entry_count, io_uring_params* params) noexcept {
+    return static_cast<i32>(syscall(__NR_io_uring_setup, entry_count, params));
+}
+
+static i32 io_uring_enter_syscall(i32 ring_fd, u32 to_submit, u32 min_complete, u32 flags) noexcept {
+    return static_cast<i32>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+// caller holds the mutex, ring has room for every request in flight plus the wake up entry
+static void io_uring_push_sqe(IoUringState& ring, IoRequest* request) noexcept {
+    const u32 tail = *ring.sq_tail;
+    SF_ASSERT_MSG(tail - std::atomic_ref<u32>(*ring.sq_head).load(std::memory_order_acquire) < ring.sq_entry_count, "io_uring: submission queue is full");
+    const u32 index = tail & ring.sq_mask;
+    io_uring_sqe& sqe = ring.sqes[index];
+    sf_mem_zero(&sqe, sizeof(sqe));
+
+    if (!request) {
+        sqe.opcode = IORING_OP_NOP;
+    } else if (request->stage == STAGE_OPEN) {
+        sqe.opcode = IORING_OP_OPENAT;
+        sqe.fd = AT_FDCWD;
+        sqe.addr = reinterpret_cast<u64>(request->path);
+        sqe.open_flags = O_RDONLY | O_CLOEXEC;
+    } else {
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = request->fd;
+        sqe.ioprio = io_priority_to_ioprio(request->priority);
+        sqe.addr = reinterpret_cast<u64>(static_cast<u8*>(request->buffer) + request->bytes_read);
+        sqe.len = request->size - request->bytes_read;
+        sqe.off = request->offset + request->bytes_read;
+    }
+    sqe.user_data = reinterpret_cast<u64>(request);
+
+    ring.sq_array[index] = index;
+    std::atomic_ref<u32>(*ring.sq_tail).store(tail + 1, std::memory_order_release);
+    ++ring.to_submit_count;
+}
+
+// caller holds the mutex, finished requests are linked into 'completed_head',
+// their callbacks run after the mutex is released
+static void io_uring_reap(IoUringState& ring, IoRequest*& completed_head) noexcept {
+    u32 head = *ring.cq_head;
+    const u32 tail = std::atomic_ref<u32>(*ring.cq_tail).load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = ring.cqes[head & ring.cq_mask];
+        IoRequest* request = reinterpret_cast<IoRequest*>(cqe.user_data);
+        if (!request) {
+            // wake up from destroy
+            continue;
+        }
+
+        const i32 result = cqe.res;
+        bool is_finished{ false };
+        if (result == -EINTR || result == -EAGAIN) {
+            io_uring_push_sqe(ring, request);
+        } else if (result < 0) {
+            request->error = -result;
+            is_finished = true;
+        } else if (request->stage == STAGE_OPEN) {
+            request->fd = result;
+            request->stage = STAGE_READ;
+            if (request->size == 0) {
+                is_finished = true;
+            } else {
+                io_uring_push_sqe(ring, request);
+            }
+        } else {
+            request->bytes_read += static_cast<u32>(result);
+            if (result == 0 || request->bytes_read == request->size) {
+                is_finished = true;
+            } else {
+                // short read, continue from where it stopped
+                io_uring_push_sqe(ring, request);
+            }
+        }
+
+        if (is_finished) {
+            --ring.in_flight_count;
+            request->next = completed_head;
+            completed_head = request;
+        }
+    }
+    std::atomic_ref<u32>(*ring.cq_head).store(head, std::memory_order_release);
+}
+
+// caller holds the mutex, entries the kernel didn't take are taken back and their requests fail with 'error'
+static void io_uring_fail_unsubmitted(IoUringState& ring, i32 error, IoRequest*& completed_head) noexcept {
+    const u32 head = std::atomic_ref<u32>(*ring.sq_head).load(std::memory_order_acquire);
+    const u32 tail = *ring.sq_tail;
+    for (u32 i = head; i != tail; ++i) {
+        IoRequest* request = reinterpret_cast<IoRequest*>(ring.sqes[ring.sq_array[i & ring.sq_mask]].user_data);
+        if (!request) {
+            continue;
+        }
+        request->error = error;
+        --ring.in_flight_count;
+        request->next = completed_head;
+        completed_head = request;
+    }
+    std::atomic_ref<u32>(*ring.sq_tail).store(head, std::memory_order_release);
+    ring.to_submit_count = 0;
+}
+
+// caller holds the mutex, requests finished on the way are linked into 'completed_head' like in 'io_uring_reap'
+static void io_uring_fill_and_submit(IoUringState& ring, IoRequest*& completed_head) noexcept {
+    while (ring.in_flight_count < AsyncIoSystem::MAX_IN_FLIGHT_COUNT) {
+        IoRequest* request = ring.queue.pop();
+        if (!request) {
+            break;
+        }
+        ++ring.in_flight_count;
+        io_uring_push_sqe(ring, request);
+    }
+
+    while (ring.to_submit_count > 0) {
+        const i32 submitted = io_uring_enter_syscall(ring.ring_fd, ring.to_submit_count, 0, 0);
+        if (submitted >= 0) {
+            ring.to_submit_count -= static_cast<u32>(submitted);
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EBUSY) {
+            // completion queue is full or kernel is short on resources, completion thread can't reap while
+            // the mutex is held, so completions are reaped here, waiting for one if the kernel has any
+            if (ring.in_flight_count > ring.to_submit_count) {
+                io_uring_enter_syscall(ring.ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+            } else {
+                std::this_thread::yield();
+            }
+            io_uring_reap(ring, completed_head);
+            continue;
+        }
+        const i32 error = errno;
+        LOG_ERROR("io_uring: submit failed with errno {}", error);
+        io_uring_fail_unsubmitted(ring, error, completed_head);
+        return;
+    }
+}
+
+// callbacks may submit, so they run without the lock
+static void io_uring_complete_many(IoRequest* completed_head) noexcept {
+    while (completed_head) {
+        IoRequest* request = completed_head;
+        completed_head = request->next;
+        complete_request(*request, request->error);
+    }
+}
+
+static void io_uring_completion_loop(IoUringState* ring) noexcept {
+    while (true) {
+        const i32 enter_result = io_uring_enter_syscall(ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+        if (enter_result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            LOG_ERROR("io_uring: waiting for completions failed with errno {}", errno);
+        }
+
+        IoRequest* completed_head{ nullptr };
+        bool should_exit{ false };
+        {
+            std::lock_guard lock{ ring->mutex };
+            io_uring_reap(*ring, completed_head);
+            io_uring_fill_and_submit(*ring, completed_head);
+            should_exit = ring->is_stopping && ring->in_flight_count == 0 && ring->queue.is_empty();
+        }
+        io_uring_complete_many(completed_head);
+
+        if (should_exit) {
+            return;
+        }
+    }
+}
+
+static void io_uring_release(IoUringState* ring) noexcept {
+    if (ring->sqes) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    if (ring->sq_ring) {
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    }
+    if (ring->ring_fd >= 0) {
+        close(ring->ring_fd);
+    }
+    delete ring;
+}
+
+// nullptr if the kernel doesn't have io_uring, doesn't allow it or lacks async open/read
+static IoUringState* io_uring_create() noexcept {
+    IoUringState* ring = sf_mem_construct<IoUringState>();
+    if (!ring) {
+        return nullptr;
+    }
+
+    io_uring_params params{};
+    ring->ring_fd = io_uring_setup_syscall(AsyncIoSystem::RING_ENTRY_COUNT, &params);
+    if (ring->ring_fd < 0) {
+        LOG_INFO("io_uring: setup failed with errno {}", errno);
+        io_uring_release(ring);
+        return nullptr;
+    }
+    // IORING_OP_OPENAT and IORING_OP_READ came together with this flag (5.6)
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        LOG_INFO("io_uring: kernel is too old for async open/read");
+        io_uring_release(ring);
+        return nullptr;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool is_single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (is_single_mmap) {
+        ring->sq_ring_size = ring->cq_ring_size = std::max(ring->sq_ring_size, ring->cq_ring_size);
+    }
+
+    void* sq_ring = mmap(nullptr, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        io_uring_release(ring);
+        return nullptr;
+    }
+    ring->sq_ring = sq_ring;
+
+    if (is_single_mmap) {
+        ring->cq_ring = sq_ring;
+    } else {
+        void* cq_ring = mmap(nullptr, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            io_uring_release(ring);
+            return nullptr;
+        }
+        ring->cq_ring = cq_ring;
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        io_uring_release(ring);
+        return nullptr;
+    }
+    ring->sqes = static_cast<io_uring_sqe*>(sqes);
+
+    u8* sq_base = static_cast<u8*>(ring->sq_ring);
+    ring->sq_head = reinterpret_cast<u32*>(sq_base + params.sq_off.head);
+    ring->sq_tail = reinterpret_cast<u32*>(sq_base + params.sq_off.tail);
+    ring->sq_array = reinterpret_cast<u32*>(sq_base + params.sq_off.array);
+    ring->sq_mask = *reinterpret_cast<u32*>(sq_base + params.sq_off.ring_mask);
+    ring->sq_entry_count = params.sq_entries;
+
+    u8* cq_base = static_cast<u8*>(ring->cq_ring);
+    ring->cq_head = reinterpret_cast<u32*>(cq_base + params.cq_off.head);
+    ring->cq_tail = reinterpret_cast<u32*>(cq_base + params.cq_off.tail);
+    ring->cqes = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+    ring->cq_mask = *reinterpret_cast<u32*>(cq_base + params.cq_off.ring_mask);
+
+    ring->completion_thread = std::thread(io_uring_completion_loop, ring);
+    return ring;
+}
+
+static void io_uring_submit(IoUringState* ring, std::span<IoRequest* const> requests) noexcept {
+    IoRequest* completed_head{ nullptr };
+    {
+        std::lock_guard lock{ ring->mutex };
+        for (IoRequest* request : requests) {
+            request->stage = STAGE_OPEN;
+            ring->queue.push(request);
+        }
+        io_uring_fill_and_submit(*ring, completed_head);
+    }
+    io_uring_complete_many(completed_head);
+}
+
+// requests in flight and queued are finished first
+static void io_uring_destroy(IoUringState* ring) noexcept {
+    IoRequest* completed_head{ nullptr };
+    {
+        std::lock_guard lock{ ring->mutex };
+        ring->is_stopping = true;
+        // completion thread may sleep with nothing in flight
+        io_uring_push_sqe(*ring, nullptr);
+        io_uring_fill_and_submit(*ring, completed_head);
+    }
+    io_uring_complete_many(completed_head);
+    ring->completion_thread.join();
+    io_uring_release(ring);
+}
+
+#endif // SF_PLATFORM_LINUX
+
+AsyncIoSystem::AsyncIoSystem() noexcept
+    : _uring{ nullptr }
+    , _pool{ nullptr }
+    , _backend{ AsyncIoBackend::THREAD_POOL }
+{}
+
+AsyncIoSystem::~AsyncIoSystem() noexcept
+{
+    destroy();
+}
+
+bool AsyncIoSystem::create(AsyncIoBackend preferred, AsyncIoSystem& out_system) {
+    SF_ASSERT_MSG(!out_system._uring && !out_system._pool, "AsyncIoSystem: should be created once");
+#if defined(SF_PLATFORM_LINUX)
+    if (preferred == AsyncIoBackend::IO_URING) {
+        out_system._uring = io_uring_create();
+    }
+#endif
+    if (out_system._uring) {
+        out_system._backend = AsyncIoBackend::IO_URING;
+    } else {
+        out_system._pool = io_pool_create();
+        if (!out_system._pool) {
+            LOG_ERROR("AsyncIoSystem: failed to start the thread pool");
+            return false;
+        }
+        out_system._backend = AsyncIoBackend::THREAD_POOL;
+    }
+
+    state_ptr = &out_system;
+    LOG_INFO("AsyncIoSystem: using {}", out_system._backend == AsyncIoBackend::IO_URING ? "io_uring" : "thread pool");
+    return true;
+}
+
+void AsyncIoSystem::destroy() noexcept {
+#if defined(SF_PLATFORM_LINUX)
+    if (_uring) {
+        io_uring_destroy(_uring);
+        _uring = nullptr;
+    }
+#endif
+    if (_pool) {
+        io_pool_destroy(_pool);
+        _pool = nullptr;
+    }
+    if (state_ptr == this) {
+        state_ptr = nullptr;
+    }
+}
+
+void AsyncIoSystem::submit(IoRequest& request) noexcept {
+    IoRequest* requests[]{ &request };
+    submit_batch(requests);
+}
+
+void AsyncIoSystem::submit_batch(std::span<IoRequest* const> requests) noexcept {
+    if (requests.empty()) {
+        return;
+    }
+    for (IoRequest* request : requests) {
+        reset_request(*request);
+    }
+
+#if defined(SF_PLATFORM_LINUX)
+    if (_uring) {
+        io_uring_submit(_uring, requests);
+        return;
+    }
+#endif
+    if (_pool) {
+        io_pool_submit(_pool, requests);
+        return;
+    }
+    for (IoRequest* request : requests) {
+        execute_request_sync(*request);
+    }
+}
+
+Option<u64> io_file_size(const char* path) noexcept {
+#if defined(SF_PLATFORM_WINDOWS)
+    struct _stat64 file_stat;
+    if (_stat64(path, &file_stat) != 0) {
+        return None::VALUE;
+    }
+#else
+    struct stat file_stat;
+    if (stat(path, &file_stat) != 0) {
+        return None::VALUE;
+    }
+#endif
+    return static_cast<u64>(file_stat.st_size);
+}
+
+void io_submit(IoRequest& request) noexcept {
+    IoRequest* requests[]{ &request };
+    io_submit_batch(requests);
+}
+
+void io_submit_batch(std::span<IoRequest* const> requests) noexcept {
+    if (state_ptr) {
+        state_ptr->submit_batch(requests);
+        return;
+    }
+    for (IoRequest* request : requests) {
+        reset_request(*request);
+        execute_request_sync(*request);
+    }
+}
+
+bool io_read_blocking(IoRequest& request) noexcept {
+    io_submit(request);
+    return request.wait();
+}
+
+} // sf
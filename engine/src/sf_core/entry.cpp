@@ -12,6 +12,7 @@ i32 main() {
     test_manager.run_all_tests();
 #endif
     sf::LinearAllocator game_allocator(sf::get_mem_page_size() * 10);
+    game_allocator.set_memory_tag(sf::MemoryTag::GAME);
     sf::GameInstance game_inst{ std::move(game_allocator) };
 
     if (!create_game(&game_inst)) {
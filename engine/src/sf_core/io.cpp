@@ -83,35 +83,4 @@ std::string_view trim_dir_and_extension_from_path(std::string_view file_path) {
     return file_path.substr(from, to - from);
 }
 
-std::string_view strip_part_from_start_and_extension(std::string_view file_path, std::string_view part) {
-    u32 part_sz{static_cast<u32>(part.size())};
-    u32 file_path_sz{static_cast<u32>(file_path.size())};
-
-    if (part_sz > file_path_sz) {
-        return file_path;
-    }
-
-    u32 from{0};
-
-    while (from < part_sz && file_path[from] == part[from]) {
-        ++from;
-    }
-
-    u32 curr{from};
-    u32 to{from};
-
-    while (curr < file_path_sz) {
-        if (file_path[curr] == '.') {
-            to = curr;   
-        }
-        ++curr;
-    }
-
-    if (to == from) {
-        to = file_path_sz;
-    }
-
-    return file_path.substr(from, to - from);
-}
-
 } // sf
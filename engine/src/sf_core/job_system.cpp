@@ -0,0 +1,306 @@
+#include "sf_core/job_system.hpp"
+#include "sf_allocators/allocator_scope.hpp"
+#include "sf_allocators/thread_cache_allocator.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_core/memory_sf.hpp"
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace sf {
+
+static_assert(std::has_single_bit(JobSystem::DEQUE_CAPACITY), "Deque capacity should be a power of 2");
+
+struct QueuedJob {
+    JobFn       fn;
+    void*       data;
+    JobCounter* counter;
+};
+
+// fields are relaxed atomics: a thief may read a slot the owner is refilling, its CAS on 'top' fails then
+struct JobSlot {
+    std::atomic<JobFn>          fn;
+    std::atomic<void*>          data;
+    std::atomic<JobCounter*>    counter;
+
+    void store(const QueuedJob& job) noexcept {
+        fn.store(job.fn, std::memory_order_relaxed);
+        data.store(job.data, std::memory_order_relaxed);
+        counter.store(job.counter, std::memory_order_relaxed);
+    }
+
+    QueuedJob load() const noexcept {
+        return { fn.load(std::memory_order_relaxed), data.load(std::memory_order_relaxed), counter.load(std::memory_order_relaxed) };
+    }
+};
+
+// Chase-Lev deque with fixed capacity (Lê et al. 2013), 'top' and 'bottom' run freely.
+// Fences of the paper are folded into seq_cst operations on the indices.
+struct JobDeque {
+    static constexpr i64 MASK{ JobSystem::DEQUE_CAPACITY - 1 };
+
+    // thieves
+    alignas(CACHE_LINE_SIZE) std::atomic<i64>   top{ 0 };
+    // owner
+    alignas(CACHE_LINE_SIZE) std::atomic<i64>   bottom{ 0 };
+    JobSlot*                                    slots{ nullptr };
+
+    // owner only, false if full
+    bool push(const QueuedJob& job) noexcept {
+        const i64 b = bottom.load(std::memory_order_relaxed);
+        const i64 t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<i64>(JobSystem::DEQUE_CAPACITY)) {
+            return false;
+        }
+        slots[b & MASK].store(job);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // owner only, newest job
+    bool pop(QueuedJob& out_job) noexcept {
+        const i64 b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_seq_cst);
+        i64 t = top.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out_job = slots[b & MASK].load();
+        if (t == b) {
+            // last job, race the thieves for it
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // any thread, oldest job, false if empty or another thread took it first
+    bool steal(QueuedJob& out_job) noexcept {
+        i64 t = top.load(std::memory_order_seq_cst);
+        const i64 b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b) {
+            return false;
+        }
+        out_job = slots[t & MASK].load();
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+};
+
+struct JobWorker {
+    JobDeque    deque;
+    std::thread thread;
+    u32         index;
+    // next victim, spreads thieves over the workers
+    u32         steal_cursor;
+};
+
+static thread_local JobSystem* t_job_system{ nullptr };
+static thread_local JobWorker* t_job_worker{ nullptr };
+
+static void execute_job(const QueuedJob& job) noexcept {
+    {
+        AllocatorScope scope{ thread_scratch_allocator() };
+        job.fn(job.data);
+    }
+    if (job.counter) {
+        job.counter->value.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+JobSystem::JobSystem() noexcept
+    : _allocator{ nullptr }
+    , _workers{ nullptr }
+    , _worker_count{ 0 }
+    , _is_running{ false }
+    , _wake_epoch{ 0 }
+    , _sleeping_count{ 0 }
+{}
+
+JobSystem::~JobSystem() noexcept
+{
+    destroy();
+}
+
+bool JobSystem::create(GeneralPurposeAllocator& allocator, u32 worker_count, JobSystem& out_system) {
+    SF_ASSERT_MSG(!out_system._workers, "JobSystem: should be created once");
+    if (worker_count == 0) {
+        worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    worker_count = std::min(worker_count, MAX_WORKER_COUNT);
+
+    out_system._allocator = &allocator;
+    out_system._workers = static_cast<JobWorker*>(allocator.allocate(worker_count * sizeof(JobWorker), alignof(JobWorker)));
+    JobSlot* slots = static_cast<JobSlot*>(allocator.allocate(worker_count * DEQUE_CAPACITY * sizeof(JobSlot), alignof(JobSlot)));
+    if (!out_system._workers || !slots) {
+        if (out_system._workers) {
+            allocator.free(out_system._workers);
+            out_system._workers = nullptr;
+        }
+        if (slots) {
+            allocator.free(slots);
+        }
+        LOG_ERROR("JobSystem: failed to allocate {} workers", worker_count);
+        return false;
+    }
+
+    for (u32 i{0}; i < worker_count * DEQUE_CAPACITY; ++i) {
+        sf_mem_place(&slots[i]);
+    }
+    for (u32 i{0}; i < worker_count; ++i) {
+        JobWorker* worker = sf_mem_place(&out_system._workers[i]);
+        worker->deque.slots = slots + i * DEQUE_CAPACITY;
+        worker->index = i;
+        worker->steal_cursor = i + 1;
+    }
+
+    out_system._worker_count = worker_count;
+    out_system._is_running.store(true, std::memory_order_release);
+
+    t_job_system = &out_system;
+    t_job_worker = &out_system._workers[0];
+    for (u32 i{1}; i < worker_count; ++i) {
+        out_system._workers[i].thread = std::thread(worker_loop, &out_system, &out_system._workers[i]);
+    }
+
+    LOG_INFO("JobSystem: started with {} workers", worker_count);
+    return true;
+}
+
+void JobSystem::destroy() noexcept {
+    if (!_workers) {
+        return;
+    }
+
+    _is_running.store(false, std::memory_order_release);
+    _wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    _wake_epoch.notify_all();
+    for (u32 i{1}; i < _worker_count; ++i) {
+        if (_workers[i].thread.joinable()) {
+            _workers[i].thread.join();
+        }
+    }
+
+    // nobody else touches the deques now
+    JobWorker& self = _workers[0];
+    if (t_job_system != this) {
+        t_job_system = this;
+        t_job_worker = &self;
+    }
+    while (try_run_one(self)) {}
+
+    if (t_job_system == this) {
+        t_job_system = nullptr;
+        t_job_worker = nullptr;
+    }
+
+    JobSlot* slots = _workers[0].deque.slots;
+    for (u32 i{0}; i < _worker_count; ++i) {
+        _workers[i].~JobWorker();
+    }
+    _allocator->free(slots);
+    _allocator->free(_workers);
+    _workers = nullptr;
+    _worker_count = 0;
+}
+
+void JobSystem::run(std::span<const Job> jobs, JobCounter* counter) noexcept {
+    if (jobs.empty()) {
+        return;
+    }
+    if (counter) {
+        counter->value.fetch_add(static_cast<u32>(jobs.size()), std::memory_order_relaxed);
+    }
+
+    if (t_job_system != this) {
+        for (const Job& job : jobs) {
+            execute_job({ job.fn, job.data, counter });
+        }
+        return;
+    }
+
+    for (const Job& job : jobs) {
+        const QueuedJob queued{ job.fn, job.data, counter };
+        if (!t_job_worker->deque.push(queued)) {
+            execute_job(queued);
+        }
+    }
+    wake_workers();
+}
+
+void JobSystem::run(const Job& job, JobCounter* counter) noexcept {
+    run({ &job, 1 }, counter);
+}
+
+void JobSystem::wait(JobCounter& counter) noexcept {
+    while (!counter.is_done()) {
+        if (t_job_system != this || !try_run_one(*t_job_worker)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+u32 JobSystem::worker_index() noexcept {
+    return t_job_worker ? t_job_worker->index : INVALID_ID;
+}
+
+StackAllocator& JobSystem::scratch_allocator() noexcept {
+    return thread_scratch_allocator();
+}
+
+bool JobSystem::try_run_one(JobWorker& worker) noexcept {
+    QueuedJob job;
+    if (worker.deque.pop(job)) {
+        execute_job(job);
+        return true;
+    }
+
+    for (u32 i{0}; i < _worker_count; ++i) {
+        const u32 victim = worker.steal_cursor++ % _worker_count;
+        if (victim != worker.index && _workers[victim].deque.steal(job)) {
+            execute_job(job);
+            return true;
+        }
+    }
+    return false;
+}
+
+// push is published by the epoch bump, worker which read the old epoch before its search fails doesn't sleep on it
+void JobSystem::wake_workers() noexcept {
+    _wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleeping_count.load(std::memory_order_seq_cst) > 0) {
+        _wake_epoch.notify_all();
+    }
+}
+
+void JobSystem::worker_loop(JobSystem* system, JobWorker* worker) noexcept {
+    t_job_system = system;
+    t_job_worker = worker;
+
+    u32 idle_count{0};
+    while (system->_is_running.load(std::memory_order_acquire)) {
+        const u32 epoch = system->_wake_epoch.load(std::memory_order_acquire);
+        if (system->try_run_one(*worker)) {
+            idle_count = 0;
+            continue;
+        }
+
+        if (++idle_count < IDLE_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        system->_sleeping_count.fetch_add(1, std::memory_order_seq_cst);
+        system->_wake_epoch.wait(epoch, std::memory_order_acquire);
+        system->_sleeping_count.fetch_sub(1, std::memory_order_relaxed);
+        idle_count = 0;
+    }
+
+    t_job_system = nullptr;
+    t_job_worker = nullptr;
+}
+
+} // sf
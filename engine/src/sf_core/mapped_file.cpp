@@ -0,0 +1,149 @@
+#include "sf_core/mapped_file.hpp"
+#include "sf_core/logger.hpp"
+#include "sf_platform/defines.hpp"
+
+#if defined(SF_PLATFORM_WINDOWS)
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sf {
+
+MappedFile::MappedFile() noexcept
+    : _data{ nullptr }
+    , _size{ 0 }
+{}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : _data{ rhs._data }
+    , _size{ rhs._size }
+{
+    rhs._data = nullptr;
+    rhs._size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        _data = rhs._data;
+        _size = rhs._size;
+        rhs._data = nullptr;
+        rhs._size = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() noexcept {
+    close();
+}
+
+#if defined(SF_PLATFORM_WINDOWS)
+
+bool MappedFile::open(std::string_view file_path, MappedFile& out_file, FileAccessHint hint) noexcept {
+    out_file.close();
+
+    const DWORD flags = hint == FileAccessHint::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+    HANDLE file = CreateFileA(file_path.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+
+    // view keeps the mapping and the file alive, both handles can go right away
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        LOG_ERROR("MappedFile: failed to map {}", file_path);
+        return false;
+    }
+
+    if (hint == FileAccessHint::SEQUENTIAL) {
+        WIN32_MEMORY_RANGE_ENTRY range{ data, static_cast<SIZE_T>(file_size.QuadPart) };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    out_file._data = static_cast<const u8*>(data);
+    out_file._size = static_cast<u64>(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() noexcept {
+    if (_data) {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    _size = 0;
+}
+
+#else
+
+bool MappedFile::open(std::string_view file_path, MappedFile& out_file, FileAccessHint hint) noexcept {
+    out_file.close();
+
+    const i32 fd = ::open(file_path.data(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (file_stat.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    const u64 size = static_cast<u64>(file_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // mapping holds its own reference to the file
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        LOG_ERROR("MappedFile: failed to map {}, errno: {}", file_path, errno);
+        return false;
+    }
+
+    if (hint == FileAccessHint::SEQUENTIAL) {
+        madvise(data, size, MADV_SEQUENTIAL);
+        // starts readahead of the whole file now, so the first pass doesn't fault page by page
+        madvise(data, size, MADV_WILLNEED);
+    } else {
+        madvise(data, size, MADV_RANDOM);
+    }
+
+    out_file._data = static_cast<const u8*>(data);
+    out_file._size = size;
+    return true;
+}
+
+void MappedFile::close() noexcept {
+    if (_data) {
+        munmap(const_cast<u8*>(_data), _size);
+        _data = nullptr;
+    }
+    _size = 0;
+}
+
+#endif
+
+} // sf
@@ -4,7 +4,6 @@
 #include "sf_core/logger.hpp"
 #include "sf_core/utility.hpp"
 #include "sf_platform/platform.hpp"
-#include <cstdlib>
 #include <new>
 #include <cstring>
 
@@ -19,17 +18,18 @@ SF_EXPORT void* sf_mem_alloc(usize byte_size, u16 alignment) {
     return block;
 }
 
-SF_EXPORT void* sf_mem_realloc(void* ptr, usize byte_size) {
-    void* block = std::realloc(ptr, byte_size);
-    if (!block) {
-        LOG_FATAL("Out of memory, requested size: {}", byte_size);
-        panic("Ending the program");
+// blocks come from operator new, so std::realloc can't be used on them
+SF_EXPORT void* sf_mem_realloc(void* ptr, usize old_byte_size, usize new_byte_size, u16 alignment) {
+    void* block = sf_mem_alloc(new_byte_size, alignment);
+    if (ptr) {
+        std::memcpy(block, ptr, old_byte_size < new_byte_size ? old_byte_size : new_byte_size);
+        sf_mem_free(ptr, alignment);
     }
     return block;
 }
 
 SF_EXPORT void sf_mem_free(void* block, u16 alignment) {
-    ::operator delete(block, static_cast<std::align_val_t>(alignment), std::nothrow);
+    platform_mem_free(block, alignment);
 }
 
 SF_EXPORT void sf_mem_set(void* block, usize byte_size, i32 value) {
@@ -40,15 +40,15 @@ SF_EXPORT void sf_mem_zero(void* block, usize byte_size) {
     sf_mem_set(block, byte_size, 0);
 }
 
-SF_EXPORT void sf_mem_copy(void* dest, void* src, usize byte_size) {
+SF_EXPORT void sf_mem_copy(void* dest, const void* src, usize byte_size) {
     std::memcpy(dest, src, byte_size);
 }
 
-SF_EXPORT void sf_mem_move(void* dest, void* src, usize byte_size) {
+SF_EXPORT void sf_mem_move(void* dest, const void* src, usize byte_size) {
     std::memmove(dest, src, byte_size);
 }
 
-SF_EXPORT bool sf_mem_cmp(void* first, void* second, usize byte_size) {
+SF_EXPORT bool sf_mem_cmp(const void* first, const void* second, usize byte_size) {
     return std::memcmp(first, second, byte_size) == 0;
 }
 
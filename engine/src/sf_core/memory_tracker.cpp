@@ -0,0 +1,117 @@
+#ifdef SF_MEMORY_TRACKING
+
+#include "sf_core/memory_tracker.hpp"
+#include "sf_core/logger.hpp"
+#include <atomic>
+
+namespace sf {
+
+struct MemoryTagCounters {
+    std::atomic<usize> current_bytes;
+    std::atomic<usize> peak_bytes;
+    std::atomic<u64>   alloc_count;
+    std::atomic<u64>   free_count;
+    std::atomic<u32>   frame_alloc_count;
+    u32                last_frame_alloc_count;
+};
+
+struct MemoryTrackerState {
+    MemoryTagCounters tags[static_cast<u8>(MemoryTag::COUNT)];
+    u32               frame_index;
+    u32               warmup_frames;
+    u32               violation_count;
+    bool              expect_zero_frame_allocs;
+};
+
+static MemoryTrackerState state;
+
+void memory_track_alloc(MemoryTag tag, usize byte_size) {
+    if (byte_size == 0) {
+        return;
+    }
+    MemoryTagCounters& counters = state.tags[static_cast<u8>(tag)];
+    usize current = counters.current_bytes.fetch_add(byte_size, std::memory_order_relaxed) + byte_size;
+    counters.alloc_count.fetch_add(1, std::memory_order_relaxed);
+    counters.frame_alloc_count.fetch_add(1, std::memory_order_relaxed);
+
+    usize peak = counters.peak_bytes.load(std::memory_order_relaxed);
+    while (current > peak && !counters.peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+}
+
+void memory_track_free(MemoryTag tag, usize byte_size) {
+    if (byte_size == 0) {
+        return;
+    }
+    MemoryTagCounters& counters = state.tags[static_cast<u8>(tag)];
+    counters.current_bytes.fetch_sub(byte_size, std::memory_order_relaxed);
+    counters.free_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void memory_tracker_end_frame() {
+    u32 frame_alloc_count{0};
+
+    for (u8 i{0}; i < static_cast<u8>(MemoryTag::COUNT); ++i) {
+        MemoryTagCounters& counters = state.tags[i];
+        counters.last_frame_alloc_count = counters.frame_alloc_count.exchange(0, std::memory_order_relaxed);
+        // frame scratch memory is a pointer bump which is reset every frame, it's not a violation
+        if (i != static_cast<u8>(MemoryTag::FRAME)) {
+            frame_alloc_count += counters.last_frame_alloc_count;
+        }
+    }
+
+    if (state.expect_zero_frame_allocs && state.frame_index >= state.warmup_frames && frame_alloc_count > 0) {
+        state.violation_count++;
+        LOG_ERROR("Frame {} made {} allocations in steady state", state.frame_index, frame_alloc_count);
+        for (u8 i{0}; i < static_cast<u8>(MemoryTag::COUNT); ++i) {
+            if (state.tags[i].last_frame_alloc_count > 0 && i != static_cast<u8>(MemoryTag::FRAME)) {
+                LOG_ERROR("\t{}: {} allocations", memory_tag_names[i], state.tags[i].last_frame_alloc_count);
+            }
+        }
+    }
+
+    state.frame_index++;
+}
+
+MemoryTagStats memory_tracker_get_stats(MemoryTag tag) {
+    const MemoryTagCounters& counters = state.tags[static_cast<u8>(tag)];
+    return MemoryTagStats{
+        .current_bytes = counters.current_bytes.load(std::memory_order_relaxed),
+        .peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed),
+        .alloc_count = counters.alloc_count.load(std::memory_order_relaxed),
+        .free_count = counters.free_count.load(std::memory_order_relaxed),
+        .frame_alloc_count = counters.last_frame_alloc_count,
+    };
+}
+
+u32 memory_tracker_get_frame_alloc_count() {
+    u32 frame_alloc_count{0};
+    for (const MemoryTagCounters& counters : state.tags) {
+        frame_alloc_count += counters.last_frame_alloc_count;
+    }
+    return frame_alloc_count;
+}
+
+void memory_tracker_expect_zero_frame_allocs(bool enable, u32 warmup_frames) {
+    state.expect_zero_frame_allocs = enable;
+    state.warmup_frames = state.frame_index + warmup_frames;
+    state.violation_count = 0;
+}
+
+u32 memory_tracker_get_violation_count() {
+    return state.violation_count;
+}
+
+void memory_tracker_log_report() {
+    LOG_INFO("Memory usage by tag (current / peak bytes, allocs / frees, allocs in last frame):");
+    for (u8 i{0}; i < static_cast<u8>(MemoryTag::COUNT); ++i) {
+        MemoryTagStats stats = memory_tracker_get_stats(static_cast<MemoryTag>(i));
+        if (stats.alloc_count == 0) {
+            continue;
+        }
+        LOG_INFO("\t{}: {} / {}, {} / {}, {}", memory_tag_names[i], stats.current_bytes, stats.peak_bytes, stats.alloc_count, stats.free_count, stats.frame_alloc_count);
+    }
+}
+
+} // sf
+
+#endif // SF_MEMORY_TRACKING
@@ -7,18 +7,103 @@
 #include "sf_containers/dynamic_array.hpp"
 #include "sf_containers/fixed_array.hpp"
 #include "sf_core/asserts_sf.hpp"
+#include "sf_core/async_io.hpp"
 #include "sf_core/io.hpp"
 #include "sf_core/logger.hpp"
+#include "sf_core/mapped_file.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_platform/defines.hpp"
 #include "sf_vulkan/material.hpp"
 #include "sf_vulkan/mesh.hpp"
 #include "sf_vulkan/pipeline.hpp"
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <algorithm>
 #include <string_view>
 
 namespace sf {
 
+// Mapped view of the file, assimp reads from the page cache without an intermediate heap copy
+class MappedFileStream : public Assimp::IOStream {
+public:
+    MappedFile  file;
+    usize       cursor;
+
+public:
+    MappedFileStream(MappedFile&& file) noexcept
+        : file{ std::move(file) }
+        , cursor{ 0 }
+    {}
+
+    size_t Read(void* out_buffer, size_t item_size, size_t item_count) override {
+        if (item_size == 0) {
+            return 0;
+        }
+        const usize read_count = std::min(item_count, (file.size() - cursor) / item_size);
+        sf_mem_copy(out_buffer, file.bytes().data() + cursor, read_count * item_size);
+        cursor += read_count * item_size;
+        return read_count;
+    }
+
+    size_t Write(const void* buffer, size_t item_size, size_t item_count) override {
+        return 0;
+    }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override {
+        usize new_cursor;
+        switch (origin) {
+            case aiOrigin_SET: new_cursor = offset; break;
+            case aiOrigin_CUR: new_cursor = cursor + offset; break;
+            case aiOrigin_END: new_cursor = file.size() - offset; break;
+            default: return aiReturn_FAILURE;
+        }
+        if (new_cursor > file.size()) {
+            return aiReturn_FAILURE;
+        }
+        cursor = new_cursor;
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override { return cursor; }
+    size_t FileSize() const override { return file.size(); }
+    void Flush() override {}
+};
+
+// Read-only, external files of a model (.bin buffers of gltf) go through it as well
+class MappedFileSystem : public Assimp::IOSystem {
+public:
+    bool Exists(const char* file_path) const override {
+        return io_file_size(file_path).is_some();
+    }
+
+    char getOsSeparator() const override {
+#if defined(SF_PLATFORM_WINDOWS)
+        return '\\';
+#else
+        return '/';
+#endif
+    }
+
+    Assimp::IOStream* Open(const char* file_path, const char* mode) override {
+        if (!mode || mode[0] != 'r') {
+            return nullptr;
+        }
+
+        MappedFile file;
+        if (!MappedFile::open(file_path, file)) {
+            return nullptr;
+        }
+        return sf_mem_construct<MappedFileStream>(std::move(file));
+    }
+
+    void Close(Assimp::IOStream* stream) override {
+        delete stream;
+    }
+};
+
 Assimp::Importer importer;
 
 static void process_ai_node(
@@ -43,7 +128,7 @@ static void process_ai_mesh(
     Mesh& out_mesh
 );
 
-static Material& acquire_mesh_material(
+static MaterialHandle acquire_mesh_material(
     aiMaterial* ai_mat,
     std::string_view texture_base_path,
     const VulkanDevice& device,
@@ -67,6 +152,7 @@ bool Model::load(
     Model::create(main_alloc, out_model);
     std::string_view model_name = strip_extension_from_file_name(model_file_name);
     std::string_view model_ext = extract_extension_from_file_name(model_file_name);
+    out_model.name = string_intern(model_name);
     u32 model_name_cnt = model_name.size();
     
 #ifdef SF_DEBUG
@@ -74,7 +160,7 @@ bool Model::load(
 #else
     std::string_view init_path = "build/release/engine/assets/models/";
 #endif
-    String<StackAllocator> model_path(init_path.size() + model_name_cnt + 1 + model_name_cnt + 1 + model_ext.size() + 1, &temp_alloc);
+    AssetPath model_path(init_path.size() + model_name_cnt + 1 + model_name_cnt + 1 + model_ext.size() + 1, &temp_alloc);
     model_path.append_sv(init_path);
     model_path.append_sv(model_name);
     model_path.append('/');
@@ -85,6 +171,11 @@ bool Model::load(
 
     std::string_view texture_base_path = strip_file_name_from_path(model_path.to_sv());
 
+    // importer owns the handler
+    if (importer.IsDefaultIOHandler()) {
+        importer.SetIOHandler(sf_mem_construct<MappedFileSystem>());
+    }
+
     const aiScene* scene = importer.ReadFile(model_path.data(), aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_OptimizeMeshes);
     if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode) {
         LOG_ERROR("Failed to load model with name: {}\nError Message: {}", model_name, importer.GetErrorString());
@@ -172,17 +263,13 @@ static void process_ai_mesh(
         }
     }
 
-    GeometryView& geometry_view = GeometrySystem::create_geometry_and_get_view(std::move(vertices), std::move(indices));
-    out_mesh.set_geometry_view(&geometry_view);
-
-    // NOTE: not a stack memory reference (safe)
-    Material& mesh_material = acquire_mesh_material(scene->mMaterials[ai_mesh->mMaterialIndex], texture_base_path, device, cmd_buffer, alloc);
-    out_mesh.set_material(&mesh_material);
+    out_mesh.set_geometry_view(GeometrySystem::create_geometry_and_get_view(std::move(vertices), std::move(indices)));
+    out_mesh.set_material(acquire_mesh_material(scene->mMaterials[ai_mesh->mMaterialIndex], texture_base_path, device, cmd_buffer, alloc));
 
     out_mesh.descriptor_state_index = shader.acquire_resouces(device);
 }
 
-static Material& acquire_mesh_material(
+static MaterialHandle acquire_mesh_material(
     aiMaterial* ai_mat,
     std::string_view texture_base_path,
     const VulkanDevice& device,
@@ -205,7 +292,7 @@ static Material& acquire_mesh_material(
             continue;
         }
         
-        String<StackAllocator> tex_path(texture_base_path.size() + tex_file_name.length + 1, &alloc);
+        AssetPath tex_path(texture_base_path.size() + tex_file_name.length + 1, &alloc);
         tex_path.append_sv(texture_base_path);
         tex_path.append_sv(std::string_view(tex_file_name.C_Str(), tex_file_name.length));
         tex_path.ensure_null_terminated();
@@ -0,0 +1,131 @@
+#include "sf_core/string_id.hpp"
+#include "sf_allocators/arena_allocator.hpp"
+#include "sf_allocators/general_purpose_allocator.hpp"
+#include "sf_containers/swiss_hashmap.hpp"
+#include "sf_core/asserts_sf.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+namespace sf {
+
+// address space only, pages are committed as strings arrive
+static constexpr usize STRING_ARENA_RESERVE{ 64 * 1024 * 1024 };
+static constexpr u32 ENTRY_CHUNK_SIZE{ 4096 };
+static constexpr u32 MAX_ENTRY_CHUNKS{ 1024 };
+static constexpr u32 INIT_LOOKUP_CAPACITY{ 1024 };
+
+// hash is computed once per intern call, table probes compare it before the bytes
+struct InternKey {
+    std::string_view str;
+    u64              hash;
+};
+
+static u64 intern_key_hash(ConstLRefOrValType<InternKey> key) noexcept {
+    return key.hash;
+}
+
+static bool intern_key_equal(ConstLRefOrValType<InternKey> first, ConstLRefOrValType<InternKey> second) {
+    return first.hash == second.hash && equal_fn_default<std::string_view>(first.str, second.str);
+}
+
+struct StringInterner {
+    std::shared_mutex                                                   mutex;
+    ArenaAllocator                                                      arena;
+    GeneralPurposeAllocator                                             gpa;
+    SwissHashMap<InternKey, StringId, GeneralPurposeAllocator, false>   lookup;
+    // id -> string, chunks never move, so readers don't need the lock
+    std::string_view*                                                   chunks[MAX_ENTRY_CHUNKS];
+    std::atomic<u32>                                                    count;
+
+    StringInterner()
+        : arena(STRING_ARENA_RESERVE)
+        , gpa{}
+        , lookup(INIT_LOOKUP_CAPACITY, &gpa, HashMapConfig<InternKey>{ intern_key_hash, intern_key_equal })
+        , chunks{}
+        , count{ 0 }
+    {
+        arena.set_memory_tag(MemoryTag::STRING);
+        gpa.set_memory_tag(MemoryTag::STRING);
+    }
+};
+
+static StringInterner& get_interner() {
+    static StringInterner interner;
+    return interner;
+}
+
+static Option<StringId> find_locked(StringInterner& interner, const InternKey& key) {
+    Option<StringId*> found = interner.lookup.get(key);
+    if (found.is_none()) {
+        return None::VALUE;
+    }
+    return *found.unwrap_copy();
+}
+
+StringId string_intern(std::string_view str) {
+    return string_intern_hashed(str, hash_str(str));
+}
+
+StringId string_intern_hashed(std::string_view str, u64 hash) {
+    SF_ASSERT_MSG(hash == hash_str(str), "Hash doesn't belong to the string");
+    StringInterner& interner = get_interner();
+    const InternKey key{ str, hash };
+
+    {
+        std::shared_lock lock{ interner.mutex };
+        Option<StringId> found = find_locked(interner, key);
+        if (found.is_some()) {
+            return found.unwrap_copy();
+        }
+    }
+
+    std::unique_lock lock{ interner.mutex };
+    // other thread could intern it between the locks
+    Option<StringId> found = find_locked(interner, key);
+    if (found.is_some()) {
+        return found.unwrap_copy();
+    }
+
+    const u32 id = interner.count.load(std::memory_order_relaxed);
+    SF_ASSERT_MSG(id < ENTRY_CHUNK_SIZE * MAX_ENTRY_CHUNKS, "String interner is full");
+
+    std::string_view*& chunk = interner.chunks[id / ENTRY_CHUNK_SIZE];
+    if (!chunk) {
+        chunk = static_cast<std::string_view*>(interner.arena.allocate(ENTRY_CHUNK_SIZE * sizeof(std::string_view), alignof(std::string_view)));
+    }
+
+    char* bytes = static_cast<char*>(interner.arena.allocate(str.size() + 1, alignof(char)));
+    if (!str.empty()) {
+        sf_mem_copy(bytes, str.data(), str.size());
+    }
+    bytes[str.size()] = '\0';
+
+    const std::string_view interned{ bytes, str.size() };
+    chunk[id % ENTRY_CHUNK_SIZE] = interned;
+    interner.lookup.put(InternKey{ interned, hash }, StringId{ id });
+    interner.count.store(id + 1, std::memory_order_release);
+
+    return StringId{ id };
+}
+
+StringId string_id_find(std::string_view str) {
+    StringInterner& interner = get_interner();
+    std::shared_lock lock{ interner.mutex };
+    Option<StringId> found = find_locked(interner, InternKey{ str, hash_str(str) });
+    return found.is_some() ? found.unwrap_copy() : StringId{};
+}
+
+std::string_view string_id_to_sv(StringId id) {
+    StringInterner& interner = get_interner();
+    SF_ASSERT_MSG(id.is_valid() && id.id < interner.count.load(std::memory_order_acquire), "Invalid string id");
+    return interner.chunks[id.id / ENTRY_CHUNK_SIZE][id.id % ENTRY_CHUNK_SIZE];
+}
+
+u32 string_interner_count() {
+    return get_interner().count.load(std::memory_order_acquire);
+}
+
+} // sf
@@ -13,6 +13,7 @@
 #include <X11/Xlib.h>
 #include <X11/Xlib-xcb.h>
 #include <sys/time.h>
+#include <sys/mman.h>
 #include <xcb/xproto.h>
 #include <time.h> // nanosleep
 #include <unistd.h> // usleep
@@ -40,6 +41,15 @@ void* platform_mem_alloc(u64 byte_size, u16 alignment = 0) {
     }
 }
 
+// has to mirror platform_mem_alloc, aligned and unaligned operator new need the matching delete
+void platform_mem_free(void* block, u16 alignment = 0) {
+    if (alignment) {
+        ::operator delete(block, static_cast<std::align_val_t>(alignment), std::nothrow);
+    } else {
+        ::operator delete(block, std::nothrow);
+    }
+}
+
 static const FixedArray<std::string_view, 6> color_strings = {"0;41", "1;31", "1;33", "1;32", "1;34", "1;30"};
 
 void platform_console_write(char* message_buff, u16 written_count, u8 color) {
@@ -80,6 +90,105 @@ u32 platform_get_mem_page_size() {
     return static_cast<u32>(sysconf(_SC_PAGESIZE));
 }
 
+void* platform_mem_reserve(u64 byte_size) {
+    void* ptr = mmap(nullptr, byte_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED) {
+        LOG_ERROR("Failed to reserve {} bytes of virtual memory", byte_size);
+        return nullptr;
+    }
+    return ptr;
+}
+
+bool platform_mem_commit(void* addr, u64 byte_size) {
+    return mprotect(addr, byte_size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void platform_mem_decommit(void* addr, u64 byte_size) {
+    // give physical pages back to the os, address range stays reserved
+    madvise(addr, byte_size, MADV_DONTNEED);
+    mprotect(addr, byte_size, PROT_NONE);
+}
+
+void platform_mem_release(void* addr, u64 byte_size) {
+    munmap(addr, byte_size);
+}
+
+void* platform_mem_remap(void* addr, u64 old_size, u64 new_size) {
+    // page table entries are moved, no bytes are copied
+    void* ptr = mremap(addr, old_size, new_size, MREMAP_MAYMOVE);
+    if (ptr == MAP_FAILED) {
+        LOG_ERROR("Failed to remap {} bytes of virtual memory to {} bytes", old_size, new_size);
+        return nullptr;
+    }
+    return ptr;
+}
+
+// x86-64 and aarch64 with 4 KiB base pages both use 2 MiB huge pages
+static constexpr u64 HUGE_PAGE_SIZE{ 2 * 1024 * 1024 };
+
+static u64 align_to_huge_page(u64 byte_size) {
+    return (byte_size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+// maps one huge page more than needed and cuts the ends off, so the range starts at huge page boundary
+static void* mmap_huge_aligned(u64 byte_size, int prot) {
+    const u64 map_size = byte_size + HUGE_PAGE_SIZE;
+    u8* ptr = static_cast<u8*>(mmap(nullptr, map_size, prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    u8* aligned = reinterpret_cast<u8*>((reinterpret_cast<usize>(ptr) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+    if (aligned > ptr) {
+        munmap(ptr, aligned - ptr);
+    }
+    u8* end = aligned + byte_size;
+    if (end < ptr + map_size) {
+        munmap(end, ptr + map_size - end);
+    }
+    return aligned;
+}
+
+u64 platform_get_huge_page_size() {
+    return HUGE_PAGE_SIZE;
+}
+
+void* platform_mem_reserve_huge(u64 byte_size) {
+    void* ptr = mmap_huge_aligned(align_to_huge_page(byte_size), PROT_NONE);
+    if (!ptr) {
+        LOG_ERROR("Failed to reserve {} bytes of virtual memory", byte_size);
+        return nullptr;
+    }
+    // flag sticks to the range, pages committed later are backed by transparent huge pages when possible
+    madvise(ptr, align_to_huge_page(byte_size), MADV_HUGEPAGE);
+    return ptr;
+}
+
+void* platform_mem_alloc_huge(u64 byte_size, bool& out_huge) {
+    byte_size = align_to_huge_page(byte_size);
+
+    // explicit huge pages, only when the admin has set up the pool (vm.nr_hugepages)
+    void* ptr = mmap(nullptr, byte_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        out_huge = true;
+        return ptr;
+    }
+
+    // transparent huge pages, kernel may still fall back to regular pages
+    ptr = mmap_huge_aligned(byte_size, PROT_READ | PROT_WRITE);
+    if (!ptr) {
+        LOG_ERROR("Failed to allocate {} bytes of huge page memory", byte_size);
+        out_huge = false;
+        return nullptr;
+    }
+    out_huge = madvise(ptr, byte_size, MADV_HUGEPAGE) == 0;
+    return ptr;
+}
+
+void platform_mem_free_huge(void* addr, u64 byte_size) {
+    munmap(addr, align_to_huge_page(byte_size));
+}
+
 void platform_get_required_extensions(FixedArray<const char*, VK_MAX_EXTENSION_COUNT>& required_extensions) {
     required_extensions.append("VK_KHR_xcb_surface");
 }
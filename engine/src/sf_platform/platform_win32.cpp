@@ -8,18 +8,42 @@
 #include "sf_containers/fixed_array.hpp"
 #include <Windows.h>
 #include <windowsx.h>
+#include <cstring>
 #include <vulkan/vulkan_core.h>
 #include <vulkan/vulkan_win32.h>
 
 namespace sf {
 
 void* platform_mem_alloc(u64 byte_size, u16 alignment = 0) {
-    HANDLE heap_handle = GetProcessHeap();
-    void* ptr = HeapAlloc(heap_handle, HEAP_ZERO_MEMORY, byte_size);
-    if (!ptr) {
-        panic("Out of memory");
+    if (alignment) {
+        SF_ASSERT_MSG(is_power_of_two(alignment), "alignment should be a power of two");
+        void* ptr = _aligned_malloc(byte_size, alignment);
+        if (!ptr) {
+            panic("Out of memory");
+        }
+        // heap path hands out zeroed blocks, aligned ones shouldn't differ
+        std::memset(ptr, 0, byte_size);
+        return ptr;
+    } else {
+        HANDLE heap_handle = GetProcessHeap();
+        void* ptr = HeapAlloc(heap_handle, HEAP_ZERO_MEMORY, byte_size);
+        if (!ptr) {
+            panic("Out of memory");
+        }
+        return ptr;
+    }
+}
+
+// has to mirror platform_mem_alloc, heap and aligned blocks come from different allocators
+void platform_mem_free(void* block, u16 alignment = 0) {
+    if (!block) {
+        return;
+    }
+    if (alignment) {
+        _aligned_free(block);
+    } else {
+        HeapFree(GetProcessHeap(), 0, block);
     }
-    return ptr;
 }
 
 f64 platform_get_abs_time() {
@@ -58,6 +82,72 @@ u32 platform_get_mem_page_size() {
     return static_cast<u32>(si.dwPageSize);
 }
 
+void* platform_mem_reserve(u64 byte_size) {
+    void* ptr = VirtualAlloc(nullptr, byte_size, MEM_RESERVE, PAGE_NOACCESS);
+    if (!ptr) {
+        LOG_ERROR("Failed to reserve {} bytes of virtual memory", byte_size);
+    }
+    return ptr;
+}
+
+bool platform_mem_commit(void* addr, u64 byte_size) {
+    return VirtualAlloc(addr, byte_size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void platform_mem_decommit(void* addr, u64 byte_size) {
+    VirtualFree(addr, byte_size, MEM_DECOMMIT);
+}
+
+void platform_mem_release(void* addr, u64 byte_size) {
+    VirtualFree(addr, 0, MEM_RELEASE);
+}
+
+void* platform_mem_remap(void* addr, u64 old_size, u64 new_size) {
+    // no mremap on windows, pages are copied into the new range
+    void* ptr = VirtualAlloc(nullptr, new_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!ptr) {
+        LOG_ERROR("Failed to remap {} bytes of virtual memory to {} bytes", old_size, new_size);
+        return nullptr;
+    }
+    std::memcpy(ptr, addr, old_size < new_size ? old_size : new_size);
+    VirtualFree(addr, 0, MEM_RELEASE);
+    return ptr;
+}
+
+u64 platform_get_huge_page_size() {
+    static const u64 large_page_size = GetLargePageMinimum();
+    return large_page_size;
+}
+
+void* platform_mem_reserve_huge(u64 byte_size) {
+    // windows has no transparent huge pages, large pages are committed all at once by platform_mem_alloc_huge
+    return platform_mem_reserve(byte_size);
+}
+
+void* platform_mem_alloc_huge(u64 byte_size, bool& out_huge) {
+    const u64 large_page_size = platform_get_huge_page_size();
+    if (large_page_size) {
+        // needs SeLockMemoryPrivilege, fails without it
+        const u64 aligned_size = (byte_size + large_page_size - 1) & ~(large_page_size - 1);
+        void* ptr = VirtualAlloc(nullptr, aligned_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (ptr) {
+            out_huge = true;
+            return ptr;
+        }
+    }
+
+    out_huge = false;
+    void* ptr = VirtualAlloc(nullptr, byte_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!ptr) {
+        LOG_ERROR("Failed to allocate {} bytes of huge page memory", byte_size);
+    }
+    return ptr;
+}
+
+void platform_mem_free_huge(void* addr, u64 byte_size) {
+    VirtualFree(addr, 0, MEM_RELEASE);
+}
+
 void platform_get_required_extensions(FixedArray<const char*, VK_MAX_EXTENSION_COUNT>& required_extensions) {
     required_extensions.append("VK_KHR_win32_surface");
 }
@@ -1,18 +1,47 @@
 #ifdef SF_TESTS
 
 #include "sf_core/io.hpp"
+#include "sf_core/async_io.hpp"
+#include "sf_core/mapped_file.hpp"
+#include "sf_core/parsing.hpp"
 #include "sf_containers/bitset.hpp"
+#include "sf_containers/concurrent_hashmap.hpp"
+#include "sf_allocators/allocator_scope.hpp"
+#include "sf_allocators/arena_allocator.hpp"
 #include "sf_allocators/general_purpose_allocator.hpp"
 #include "sf_allocators/linear_allocator.hpp"
 #include "sf_containers/hashmap.hpp"
+#include "sf_containers/mpmc_queue.hpp"
+#include "sf_containers/swiss_hashmap.hpp"
+#include "sf_containers/paged_array.hpp"
+#include "sf_containers/slot_map.hpp"
+#include "sf_containers/small_array.hpp"
+#include "sf_containers/soa_array.hpp"
+#include "sf_containers/spsc_queue.hpp"
 #include "sf_containers/dynamic_array.hpp"
 #include "sf_core/logger.hpp"
 #include "sf_tests/test_manager.hpp"
 #include "sf_containers/fixed_array.hpp"
 #include "sf_allocators/free_list_allocator.hpp"
+#include "sf_allocators/frame_allocator.hpp"
+#include "sf_allocators/pool_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
+#include "sf_allocators/thread_cache_allocator.hpp"
+#include "sf_allocators/tlsf_allocator.hpp"
 #include "sf_core/clock.hpp"
+#include "sf_core/hash.hpp"
+#include "sf_core/job_system.hpp"
+#include "sf_core/parallel.hpp"
+#include "sf_core/memory_tracker.hpp"
+#include "sf_core/string_id.hpp"
+#include "sf_platform/platform.hpp"
+#include "sf_vulkan/shared_types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdio>
 #include <string_view>
+#include <thread>
 
 namespace sf {
 
@@ -103,6 +132,29 @@ void stack_allocator_test() {
         arr3.reserve(300);
         expect(alloc.count() >= 700 * sizeof(u8) + sizeof(StackAllocatorHeader), counter);
     }
+
+    // growth chains a new block, old pointers stay valid
+    alloc.clear();
+    u64* first = static_cast<u64*>(alloc.allocate(sizeof(u64), alignof(u64)));
+    *first = 42;
+    void* big = alloc.allocate(100'000, 64);
+    expect(big != nullptr && reinterpret_cast<usize>(big) % 64 == 0, counter);
+    expect(*first == 42 && alloc.handle_to_ptr(alloc.ptr_to_handle(first)) == first, counter);
+
+    // LIFO free returns to the previous block
+    alloc.free(big);
+    alloc.free(first);
+    expect(alloc.count() == 0, counter);
+
+    // scope rewinds everything allocated inside of it
+    alloc.allocate(16, 8);
+    const usize count_before_scope = alloc.count();
+    {
+        AllocatorScope scope{ alloc };
+        alloc.allocate(200, 8);
+        alloc.allocate(5000, 16);
+    }
+    expect(alloc.count() == count_before_scope, counter);
 }
 
 void freelist_allocator_test() {
@@ -125,6 +177,49 @@ void freelist_allocator_test() {
     }
 }
 
+void general_purpose_allocator_test() {
+    TestCounter counter("General Purpose Allocator");
+    GeneralPurposeAllocator gpa;
+
+    void* aligned = gpa.allocate(100, 64);
+    expect(reinterpret_cast<usize>(aligned) % 64 == 0, counter);
+    sf_mem_set(aligned, 100, 3);
+    ReallocReturn realloc_res = gpa.reallocate(aligned, 1000, 64);
+    expect(reinterpret_cast<usize>(realloc_res.ptr) % 64 == 0 && static_cast<u8*>(realloc_res.ptr)[99] == 3, counter);
+    gpa.free(realloc_res.ptr);
+
+    // heap block grows into a large one, content survives
+    u32* values = static_cast<u32*>(gpa.allocate(1024 * sizeof(u32), alignof(u32)));
+    for (u32 i{0}; i < 1024; ++i) {
+        values[i] = i;
+    }
+    u32 count = 1024;
+    bool content_valid = true;
+    while (count < 4 * 1024 * 1024) {
+        realloc_res = gpa.reallocate(values, count * 2 * sizeof(u32), alignof(u32));
+        values = static_cast<u32*>(realloc_res.ptr);
+        content_valid &= values[count - 1] == count - 1;
+        for (u32 i{count}; i < count * 2; ++i) {
+            values[i] = i;
+        }
+        count *= 2;
+    }
+    expect(content_valid && values[count - 1] == count - 1, counter);
+
+    // large block shrinks back to heap
+    realloc_res = gpa.reallocate(values, 64 * sizeof(u32), alignof(u32));
+    values = static_cast<u32*>(realloc_res.ptr);
+    expect(values[63] == 63, counter);
+    gpa.free(values);
+
+    // page aligned large block
+    void* page_aligned = gpa.allocate(GeneralPurposeAllocator::LARGE_BLOCK_SIZE, 4096);
+    expect(reinterpret_cast<usize>(page_aligned) % 4096 == 0, counter);
+    realloc_res = gpa.reallocate(page_aligned, GeneralPurposeAllocator::LARGE_BLOCK_SIZE * 4, 4096);
+    expect(reinterpret_cast<usize>(realloc_res.ptr) % 4096 == 0, counter);
+    gpa.free(realloc_res.ptr);
+}
+
 void linear_allocator_test() {
     TestCounter counter("Linear Allocator");
     LinearAllocator alloc{500};
@@ -142,6 +237,19 @@ void linear_allocator_test() {
         arr3.reserve(300);
         expect(alloc.count() >= 700 * sizeof(u8), counter);
     }
+
+    // growth chains a new block, old pointers stay valid
+    u64* first = static_cast<u64*>(alloc.allocate(sizeof(u64), alignof(u64)));
+    *first = 42;
+    void* big = alloc.allocate(100'000, 64);
+    expect(big != nullptr && reinterpret_cast<usize>(big) % 64 == 0 && *first == 42, counter);
+
+    const usize count_before_scope = alloc.count();
+    {
+        AllocatorScope scope{ alloc };
+        alloc.allocate(200, 8);
+    }
+    expect(alloc.count() == count_before_scope, counter);
 }
 
 void hashmap_test() {
@@ -172,6 +280,396 @@ void hashmap_test() {
     expect(del3, counter);
 }
 
+void swiss_hashmap_test() {
+    TestCounter counter("SwissHashMap");
+    constexpr u64 KEY_COUNT{ 10000 };
+
+    GeneralPurposeAllocator gpa;
+    SwissHashMap<u64, u64, GeneralPurposeAllocator, false> map(&gpa);
+
+    for (u64 i{0}; i < KEY_COUNT; ++i) {
+        map.put(i, i * 3);
+    }
+    expect(map.count() == KEY_COUNT, counter);
+    expect(std::has_single_bit(map.capacity()), counter);
+
+    bool all_found{ true };
+    for (u64 i{0}; i < KEY_COUNT; ++i) {
+        Option<u64*> val = map.get(i);
+        all_found &= val.is_some() && *val.unwrap_copy() == i * 3;
+    }
+    expect(all_found, counter);
+    expect(map.get(KEY_COUNT).is_none(), counter);
+
+    map.put(7ull, 1ull);
+    expect(*map.get(7).unwrap_copy() == 1, counter);
+    expect(!map.put_if_empty(7ull, 2ull), counter);
+    expect(*map.get(7).unwrap_copy() == 1, counter);
+
+    for (u64 i{0}; i < KEY_COUNT; i += 2) {
+        map.remove(i);
+    }
+    bool removed_ok{ true };
+    for (u64 i{0}; i < KEY_COUNT; ++i) {
+        removed_ok &= map.get(i).is_some() == (i % 2 == 1);
+    }
+    expect(removed_ok, counter);
+    expect(!map.remove(0), counter);
+    expect(map.count() == KEY_COUNT / 2, counter);
+
+    u32 iterated_count{0};
+    for (auto& bucket : map) {
+        iterated_count += bucket.key % 2 == 1;
+    }
+    expect(iterated_count == KEY_COUNT / 2, counter);
+
+    // tombstones are purged in place, churn with few live keys doesn't grow the map
+    SwissHashMap<u64, u64, GeneralPurposeAllocator, false> churn_map(64, &gpa);
+    const u32 churn_capacity = churn_map.capacity();
+    for (u64 i{0}; i < 100000; ++i) {
+        churn_map.put(i, i);
+        if (i >= 32) {
+            churn_map.remove(i - 32);
+        }
+    }
+    expect(churn_map.capacity() == churn_capacity, counter);
+    expect(churn_map.count() == 32, counter);
+    expect(churn_map.get(100000 - 1).is_some() && churn_map.get(100000 - 33).is_none(), counter);
+
+    // handles survive the buffer moving on FreeList resize
+    FreeList<true> free_list(256);
+    SwissHashMap<std::string_view, u32, FreeList<true>> str_map(&free_list);
+    constexpr std::string_view names[]{ "albedo", "normal", "roughness", "metallic", "emissive", "occlusion", "height", "specular" };
+    for (u32 round{0}; round < 8; ++round) {
+        for (u32 i{0}; i < 8; ++i) {
+            str_map.put(names[i], round * 8 + i);
+        }
+        free_list.allocate(512, 8);
+    }
+    expect(str_map.count() == 8, counter);
+    expect(*str_map.get("roughness").unwrap_copy() == 7 * 8 + 2, counter);
+    str_map.clear();
+    expect(str_map.is_empty() && str_map.get("albedo").is_none(), counter);
+}
+
+void paged_array_test() {
+    TestCounter counter("PagedArray");
+
+    GeneralPurposeAllocator gpa;
+    PagedArray<u64, 64, GeneralPurposeAllocator> array(&gpa);
+    expect(array.page_count() == 0 && array.capacity() == 0, counter);
+
+    // pages are allocated only when elements reach them
+    array.append(0);
+    expect(array.page_count() == 1 && array.capacity() == 64, counter);
+    u64* first = &array[0];
+
+    for (u64 i{1}; i < 1000; ++i) {
+        array.append(i * 2);
+    }
+    expect(array.count() == 1000 && array.page_count() == 16, counter);
+    // addresses don't change when array grows
+    expect(first == &array[0], counter);
+
+    bool values_ok{ true };
+    array.for_each([&values_ok](u64& item, u32 index) {
+        values_ok &= item == index * 2;
+    });
+    expect(values_ok, counter);
+    expect(array.page_span(15).size() == 1000 - 15 * 64, counter);
+
+    // shrinking keeps pages for reuse
+    array.resize(10);
+    expect(array.count() == 10 && array.page_count() == 16 && array.last() == 18, counter);
+    array.clear();
+    array.append(7);
+    expect(&array[0] == first && array[0] == 7, counter);
+
+    // failed page allocation is reported and doesn't construct anything
+    FrameAllocator small_alloc(4 * 1024);
+    PagedArray<u64, 1024, FrameAllocator> bounded(&small_alloc);
+    u32 appended{0};
+    while (appended < 1024 * 1024 && bounded.append(appended)) {
+        ++appended;
+    }
+    expect(appended < 1024 * 1024 && bounded.count() == appended && bounded[appended - 1] == appended - 1, counter);
+    expect(!bounded.resize(appended + 1) && bounded.count() == appended, counter);
+}
+
+void small_array_test() {
+    TestCounter counter("SmallArray");
+
+    StackAllocator alloc(1024);
+    SmallArray<u32, 8, StackAllocator> array(&alloc);
+
+    // allocator is not touched while count fits inline
+    for (u32 i{0}; i < 8; ++i) {
+        array.append(i);
+    }
+    expect(array.is_inline() && array.capacity() == 8 && alloc.count() == 0, counter);
+
+    // inline array is copied on move
+    SmallArray<u32, 8, StackAllocator> moved{ std::move(array) };
+    expect(moved.is_inline() && moved.count() == 8 && moved.last() == 7 && array.is_empty(), counter);
+
+    // spilled elements keep their values
+    moved.append(8);
+    expect(!moved.is_inline() && moved.count() == 9 && alloc.count() > 0, counter);
+    bool values_ok{ true };
+    for (u32 i{0}; i < moved.count(); ++i) {
+        values_ok &= moved[i] == i;
+    }
+    expect(values_ok, counter);
+
+    // spilled array gives its buffer on move
+    const u32* heap_data = moved.data();
+    array = std::move(moved);
+    expect(array.data() == heap_data && moved.is_inline() && moved.is_empty(), counter);
+
+    SmallString<16, StackAllocator> str(&alloc);
+    str.append_sv("assets/");
+    str.append_sv("box.png");
+    str.ensure_null_terminated();
+    expect(str.is_inline() && str.to_sv_not_null_terminated() == "assets/box.png" && str.count() == 15, counter);
+    str.pop();
+    str.append_sv(".bak");
+    str.ensure_null_terminated();
+    expect(!str.is_inline() && str.to_sv_not_null_terminated() == "assets/box.png.bak", counter);
+
+    // slice of own storage is still valid when appending it moves the buffer
+    GeneralPurposeAllocator gpa;
+    SmallArray<u32, 4, GeneralPurposeAllocator> doubled(&gpa);
+    for (u32 i{0}; i < 16; ++i) {
+        doubled.append(i);
+    }
+    doubled.append_slice(doubled.to_span());
+    doubled.append_slice(doubled.to_span().subspan(30));
+    bool doubled_ok{ doubled.count() == 34 };
+    for (u32 i{0}; doubled_ok && i < 34; ++i) {
+        doubled_ok = doubled[i] == (i < 32 ? i % 16 : i - 18);
+    }
+    expect(doubled_ok, counter);
+}
+
+void soa_array_test() {
+    TestCounter counter("SoaArray");
+
+    GeneralPurposeAllocator gpa;
+    SoaArray<GeneralPurposeAllocator, u64, u8, f32> array(&gpa);
+
+    for (u32 i{0}; i < 100; ++i) {
+        array.append(i * 3, static_cast<u8>(i), static_cast<f32>(i) * 0.5f);
+    }
+    expect(array.count() == 100 && array.capacity() >= 100, counter);
+
+    // every column is aligned and keeps its values after growth
+    std::span<u64> ids = array.column<0>();
+    std::span<u8> tags = array.column<1>();
+    std::span<f32> weights = array.column<2>();
+    expect(ids.size() == 100 && tags.size() == 100 && weights.size() == 100, counter);
+    expect(reinterpret_cast<usize>(tags.data()) % decltype(array)::COLUMN_ALIGNMENT == 0, counter);
+    expect(reinterpret_cast<usize>(weights.data()) % decltype(array)::COLUMN_ALIGNMENT == 0, counter);
+    expect(ids[99] == 297 && tags[42] == 42 && weights[10] == 5.0f, counter);
+
+    bool rows_ok{ true };
+    array.for_each([&rows_ok](u64& id, u8& tag, f32& weight, u32 index) {
+        rows_ok &= id == index * 3 && tag == static_cast<u8>(index) && weight == static_cast<f32>(index) * 0.5f;
+    });
+    expect(rows_ok, counter);
+
+    // last row fills the hole in every column
+    array.remove_unordered_at(0);
+    expect(array.count() == 99 && array.get<0>(0) == 297 && array.get<1>(0) == 99 && array.get<2>(0) == 49.5f, counter);
+
+    expect(array.resize(120), counter);
+    expect(array.get<0>(119) == 0 && array.get<2>(110) == 0.0f && array.get<0>(98) == 98 * 3, counter);
+
+    // failed grow adds nothing and keeps existing rows
+    FrameAllocator small_alloc(4 * 1024);
+    SoaArray<FrameAllocator, u64, u8, f32> bounded(&small_alloc);
+    expect(bounded.append(7, 1, 1.0f) == 0, counter);
+    expect(!bounded.reserve(1u << 20) && bounded.capacity() == 1, counter);
+    expect(bounded.append(8, 2, 2.0f) == 1 && bounded.append(9, 3, 3.0f) == 2, counter);
+    expect(!bounded.resize(1u << 20) && bounded.count() == 3, counter);
+    expect(bounded.get<0>(0) == 7 && bounded.get<0>(2) == 9 && bounded.get<2>(1) == 2.0f, counter);
+}
+
+void slot_map_test() {
+    TestCounter counter("SlotMap");
+
+    struct Item {
+        u64 value;
+        u32 tag;
+    };
+
+    SlotMap<Item> map;
+
+    SlotHandle<Item> first = map.insert(Item{ 1, 10 });
+    SlotHandle<Item> second = map.insert(Item{ 2, 20 });
+    SlotHandle<Item> third = map.insert(Item{ 3, 30 });
+    expect(!first.is_null() && map.count() == 3, counter);
+    expect(map.get(second) && map.get(second)->value == 2, counter);
+    expect(!map.contains(SlotHandle<Item>{}), counter);
+
+    // values are not moved on erase, pointers to the others stay valid
+    Item* third_ptr = map.get(third);
+    expect(map.erase(first), counter);
+    expect(!map.erase(first) && map.get(first) == nullptr, counter);
+    expect(map.get(third) == third_ptr && third_ptr->value == 3 && map.get(second)->value == 2, counter);
+
+    // slot is reused with a new generation, old handle stays stale
+    SlotHandle<Item> reused = map.insert(Item{ 4, 40 });
+    expect(reused.index() == first.index() && reused.generation() != first.generation(), counter);
+    expect(map.get(first) == nullptr && map.get(reused)->value == 4, counter);
+
+    // handles and pointers survive growth of storage
+    GeneralPurposeAllocator gpa;
+    DynamicArray<SlotHandle<Item>, GeneralPurposeAllocator, false> handles(&gpa);
+    for (u64 i{0}; i < 1000; ++i) {
+        handles.append(map.insert(Item{ i + 100, 0 }));
+    }
+    expect(map.get(second)->value == 2 && map.get(reused)->value == 4 && map.get(third) == third_ptr, counter);
+
+    // iteration only touches live values
+    for (u32 i{0}; i < handles.count(); i += 2) {
+        map.erase(handles[i]);
+    }
+    u32 iterated_count{0};
+    bool handles_match{ true };
+    map.for_each([&](Item& item, SlotHandle<Item> handle) {
+        ++iterated_count;
+        handles_match &= map.get(handle) == &item;
+    });
+    expect(iterated_count == map.count() && handles_match, counter);
+
+    map.clear();
+    expect(map.is_empty() && map.get(second) == nullptr, counter);
+
+    // 32-bit handle, generation wraps around without reaching zero
+    SlotMap<u32, SlotHandle<u32, u32>> small_map;
+    SlotHandle<u32, u32> small_handle = small_map.insert(5u);
+    expect(sizeof(small_handle) == 4 && *small_map.get(small_handle) == 5, counter);
+    for (u32 i{0}; i < SlotHandle<u32, u32>::GENERATION_MASK; ++i) {
+        small_map.erase(small_handle);
+        small_handle = small_map.insert(i);
+    }
+    expect(small_handle.generation() == 1 && !small_handle.is_null(), counter);
+
+    // slot limit is reported with a null handle
+    SlotMap<u64, SlotHandle<u64>, 64, 1> bounded;
+    for (u64 i{0}; i < 64; ++i) {
+        bounded.insert(i);
+    }
+    expect(bounded.insert(64).is_null() && bounded.count() == 64, counter);
+
+    // reads don't lock, reader checks published handles while the writer grows storage and reuses erased slots
+    SlotMap<u64> shared_map;
+    const SlotHandle<u64> kept = shared_map.insert(7);
+    const u64* kept_ptr = shared_map.get(kept);
+    std::atomic<u64> published_bits{0};
+    std::atomic<bool> is_done{ false };
+    std::atomic<bool> reads_ok{ true };
+    std::thread reader([&] {
+        while (!is_done.load(std::memory_order_acquire)) {
+            const SlotHandle<u64> published{ published_bits.load(std::memory_order_acquire) };
+            const u64* value = published.is_null() ? nullptr : shared_map.get(published);
+            if ((!published.is_null() && (!value || *value != published.index())) || shared_map.get(kept) != kept_ptr) {
+                reads_ok.store(false, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (u32 i{0}; i < 2048; ++i) {
+        shared_map.erase(shared_map.insert(0));
+        const SlotHandle<u64> handle = shared_map.insert(0);
+        *shared_map.get(handle) = handle.index();
+        published_bits.store(handle.bits, std::memory_order_release);
+    }
+    is_done.store(true, std::memory_order_release);
+    reader.join();
+    expect(reads_ok.load() && *shared_map.get(kept) == 7 && shared_map.count() == 2049, counter);
+}
+
+void hash_test() {
+    TestCounter counter("Hash");
+
+    // compile time hash of a name written in source matches the runtime one
+    constexpr u64 ct_hash = hash_str_ct("default_mat.sfmt");
+    char runtime_name[]{ "default_mat.sfmt" };
+    expect(ct_hash == hash_bytes(runtime_name, sizeof(runtime_name) - 1), counter);
+    expect(ct_hash == hashfn_default<std::string_view>(std::string_view{ runtime_name }), counter);
+    expect(hash_str_ct("default_mat.sfmt") != hash_str_ct("default_mat.sfmu"), counter);
+    expect(hash_str("abc", 1) != hash_str("abc", 2), counter);
+
+    // every length path (short, 16 byte steps, 48 byte steps) gives distinct hashes
+    char buffer[200];
+    for (u32 i{0}; i < sizeof(buffer); ++i) {
+        buffer[i] = static_cast<char>('a' + i % 26);
+    }
+    GeneralPurposeAllocator gpa;
+    SwissHashMap<u64, u32, GeneralPurposeAllocator, false> seen(sizeof(buffer) * 2, &gpa);
+    bool all_unique{ true };
+    for (u32 len{0}; len <= sizeof(buffer); ++len) {
+        all_unique &= seen.put_if_empty(hash_bytes(buffer, len), len);
+    }
+    for (u32 len{0}; len < 16; ++len) {
+        all_unique &= seen.put_if_empty(hash_u64(len), len);
+    }
+    expect(all_unique, counter);
+
+    // single bit flip of an integer key changes about half of the bits
+    u32 changed_bits{0};
+    for (u32 bit{0}; bit < 64; ++bit) {
+        changed_bits += std::popcount(hash_u64(0x1234'5678ull) ^ hash_u64(0x1234'5678ull ^ (1ull << bit)));
+    }
+    expect(changed_bits > 64 * 24 && changed_bits < 64 * 40, counter);
+}
+
+void string_interner_test() {
+    TestCounter counter("String Interner");
+
+    const StringId grass = string_intern("grass");
+    char grass_copy[]{ "grass" };
+    expect(grass.is_valid() && string_intern(grass_copy) == grass, counter);
+    expect(string_intern("grass_2") != grass, counter);
+    expect(string_id_to_sv(grass) == "grass" && string_id_to_sv(grass).data()[5] == '\0', counter);
+    expect(string_id_to_sv(grass).data() != grass_copy, counter);
+    expect(string_id_find("never_interned_name").is_valid() == false, counter);
+    expect(string_id_find("grass") == grass, counter);
+    expect(string_intern_hashed("grass", hash_str_ct("grass")) == grass, counter);
+    expect(string_intern("").is_valid() && string_id_to_sv(string_intern("")).empty(), counter);
+
+    // threads intern overlapping names, every name still gets exactly one id
+    constexpr u32 THREAD_COUNT = 8;
+    constexpr u32 NAME_COUNT = 2000;
+    const u32 count_before = string_interner_count();
+    StringId ids[THREAD_COUNT][NAME_COUNT];
+    std::thread threads[THREAD_COUNT];
+    for (u32 t{0}; t < THREAD_COUNT; ++t) {
+        threads[t] = std::thread([&ids, t] {
+            char name[32];
+            for (u32 i{0}; i < NAME_COUNT; ++i) {
+                // every thread walks the names in different order
+                const u32 name_index = (i * 7 + t * 131) % NAME_COUNT;
+                const i32 len = snprintf(name, sizeof(name), "interner_test_%u", name_index);
+                ids[t][name_index] = string_intern(std::string_view{ name, static_cast<usize>(len) });
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    bool same_ids{ true };
+    for (u32 t{1}; t < THREAD_COUNT; ++t) {
+        for (u32 i{0}; i < NAME_COUNT; ++i) {
+            same_ids &= ids[t][i] == ids[0][i];
+        }
+    }
+    expect(same_ids, counter);
+    expect(string_interner_count() - count_before == NAME_COUNT, counter);
+    expect(string_id_to_sv(ids[0][42]) == "interner_test_42", counter);
+}
+
 void bitset_test() {
     TestCounter counter{"BitSet"};
     BitSet<256> bitset{};
@@ -221,6 +719,296 @@ void bitset_test() {
     expect(bitset.is_bit(56), counter);
     expect(bitset.is_bit(112), counter);
     expect(bitset.is_bit(213), counter);
+
+    // unset keeps other bits of the word
+    bitset.unset_bit(18);
+    expect(bitset.is_bit(2) && bitset.is_bit(34) && bitset.is_bit(56), counter);
+    expect(bitset.count() == 5 && bitset.find_first_set(3) == 34 && bitset.find_first_unset() == 0, counter);
+}
+
+void dynamic_bitset_test() {
+    TestCounter counter{"DynamicBitSet"};
+
+    GeneralPurposeAllocator gpa;
+    DynamicBitSet<GeneralPurposeAllocator> bitset(200, &gpa);
+    expect(bitset.count() == 0 && bitset.find_first_set() == INVALID_ID && bitset.find_first_unset() == 0, counter);
+
+    // range crosses word borders
+    bitset.set_range(10, 120);
+    expect(bitset.count() == 120 && bitset.is_bit(10) && bitset.is_bit(129) && !bitset.is_bit(130) && !bitset.is_bit(9), counter);
+    expect(bitset.find_first_set() == 10 && bitset.find_first_unset(10) == 130, counter);
+    bitset.unset_range(64, 2);
+    expect(bitset.find_first_unset(10) == 64 && bitset.count() == 118, counter);
+
+    // free slot search stops at the bit count
+    bitset.set_all();
+    expect(bitset.count() == 200 && bitset.find_first_unset() == INVALID_ID, counter);
+    bitset.unset_bit(150);
+    expect(bitset.find_first_unset() == 150, counter);
+
+    DynamicBitSet<GeneralPurposeAllocator> mask(200, &gpa);
+    mask.set_bit(3);
+    mask.set_bit(150);
+    mask.set_bit(199);
+    bitset.and_with(mask);
+    expect(bitset.count() == 2 && bitset.is_bit(3) && bitset.is_bit(199), counter);
+    bitset.or_with(mask);
+    bitset.and_not_with(mask);
+    expect(bitset.count() == 0, counter);
+
+    u32 visited{0};
+    bool order_ok{ true };
+    u32 prev{0};
+    mask.for_each_set([&](u32 bit) {
+        order_ok &= visited == 0 || bit > prev;
+        prev = bit;
+        ++visited;
+    });
+    expect(visited == 3 && order_ok && prev == 199, counter);
+
+    // shrinking drops bits past the new end
+    mask.resize(150);
+    mask.resize(200);
+    expect(mask.count() == 1 && mask.find_first_set(4) == INVALID_ID, counter);
+}
+
+void spsc_queue_test() {
+    TestCounter counter{"SpscQueue"};
+
+    GeneralPurposeAllocator gpa;
+    SpscQueue<u32, GeneralPurposeAllocator> queue(100, &gpa);
+    expect(queue.capacity() == 128, counter);
+
+    // batch is cut at capacity and wraps around the end of the buffer
+    u32 items[200];
+    for (u32 i{0}; i < 200; ++i) {
+        items[i] = i;
+    }
+    expect(queue.push_batch({ items, 100 }) == 100, counter);
+    u32 out[100];
+    expect(queue.pop_batch({ out, 90 }) == 90 && out[89] == 89, counter);
+    expect(queue.push_batch({ items + 100, 100 }) == 100 && queue.count() == 110, counter);
+    expect(queue.pop_batch(out) == 100 && out[0] == 90 && out[99] == 189, counter);
+    expect(queue.pop_batch(out) == 10 && out[9] == 199 && queue.count() == 0, counter);
+
+    // items arrive in order across threads
+    constexpr u32 ITEM_COUNT{ 1'000'000 };
+    bool order_ok{ true };
+    std::thread consumer([&queue, &order_ok] {
+        u32 expected{0};
+        u32 batch[32];
+        while (expected < ITEM_COUNT) {
+            const u32 popped = queue.pop_batch(batch);
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+            for (u32 i{0}; i < popped; ++i) {
+                order_ok &= batch[i] == expected++;
+            }
+        }
+    });
+    u32 next{0};
+    while (next < ITEM_COUNT) {
+        u32 batch[16];
+        const u32 batch_count = std::min<u32>(16, ITEM_COUNT - next);
+        for (u32 i{0}; i < batch_count; ++i) {
+            batch[i] = next + i;
+        }
+        const u32 pushed = queue.push_batch({ batch, batch_count });
+        next += pushed;
+        if (pushed == 0) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    expect(order_ok && queue.count() == 0, counter);
+}
+
+void mpmc_queue_test() {
+    TestCounter counter{"MpmcQueue"};
+
+    GeneralPurposeAllocator gpa;
+    MpmcQueue<u64, GeneralPurposeAllocator> queue(64, &gpa);
+
+    u64 items[80];
+    for (u64 i{0}; i < 80; ++i) {
+        items[i] = i;
+    }
+    expect(queue.push_batch({ items, 80 }) == 64 && !queue.push(1), counter);
+    u64 out[64];
+    expect(queue.pop_batch({ out, 10 }) == 10 && out[9] == 9 && queue.count() == 54, counter);
+    expect(queue.pop_batch(out) == 54 && out[53] == 63 && !queue.pop(out[0]), counter);
+
+    // every item is received exactly once, producer order is kept per producer
+    constexpr u32 PRODUCER_COUNT{4};
+    constexpr u32 CONSUMER_COUNT{4};
+    constexpr u64 ITEMS_PER_PRODUCER{ 200'000 };
+    std::atomic<u64> received_count{0};
+    std::atomic<u64> received_sum{0};
+    std::atomic<bool> order_ok{ true };
+    {
+        std::thread threads[PRODUCER_COUNT + CONSUMER_COUNT];
+        for (u32 t{0}; t < PRODUCER_COUNT; ++t) {
+            threads[t] = std::thread([&queue, t] {
+                u64 batch[8];
+                u64 next{0};
+                while (next < ITEMS_PER_PRODUCER) {
+                    const u32 batch_count = static_cast<u32>(std::min<u64>(1 + (next & 7), ITEMS_PER_PRODUCER - next));
+                    for (u32 i{0}; i < batch_count; ++i) {
+                        // producer in the high bits
+                        batch[i] = (static_cast<u64>(t) << 32) | (next + i);
+                    }
+                    const u32 pushed = queue.push_batch({ batch, batch_count });
+                    next += pushed;
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (u32 t{0}; t < CONSUMER_COUNT; ++t) {
+            threads[PRODUCER_COUNT + t] = std::thread([&] {
+                u64 last_seen[PRODUCER_COUNT];
+                for (u64& last : last_seen) {
+                    last = UINT64_MAX;
+                }
+                u64 batch[8];
+                u64 sum{0};
+                bool local_order_ok{ true };
+                while (received_count.load(std::memory_order_relaxed) < PRODUCER_COUNT * ITEMS_PER_PRODUCER) {
+                    const u32 popped = queue.pop_batch(batch);
+                    if (popped == 0) {
+                        std::this_thread::yield();
+                    }
+                    for (u32 i{0}; i < popped; ++i) {
+                        const u32 producer = static_cast<u32>(batch[i] >> 32);
+                        const u64 value = batch[i] & 0xFFFFFFFF;
+                        local_order_ok &= last_seen[producer] == UINT64_MAX || value > last_seen[producer];
+                        last_seen[producer] = value;
+                        sum += value;
+                    }
+                    received_count.fetch_add(popped, std::memory_order_relaxed);
+                }
+                received_sum.fetch_add(sum);
+                if (!local_order_ok) {
+                    order_ok.store(false);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    const u64 expected_sum = PRODUCER_COUNT * (ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER - 1) / 2);
+    expect(received_count.load() == PRODUCER_COUNT * ITEMS_PER_PRODUCER, counter);
+    expect(received_sum.load() == expected_sum && order_ok.load(), counter);
+    expect(queue.count() == 0, counter);
+}
+
+void concurrent_hashmap_test() {
+    TestCounter counter{"ConcurrentHashMap"};
+
+    struct Entry {
+        std::atomic<u32> ref_count{0};
+        u32              value{0};
+    };
+
+    GeneralPurposeAllocator gpa;
+    ConcurrentHashMap<u32, Entry, GeneralPurposeAllocator> map(1000, &gpa);
+    expect(map.capacity() >= 1000 * 8 / 7 && map.get(5).is_none(), counter);
+
+    ConcurrentPutResult<Entry> first = map.get_or_emplace(5);
+    first.value->value = 50;
+    ConcurrentPutResult<Entry> again = map.get_or_emplace(5);
+    expect(first.inserted && !again.inserted && again.value == first.value && map.count() == 1, counter);
+
+    // tombstone of a removed key is the first free slot on its probe path, reinsert claims it again
+    expect(map.remove(5) && !map.remove(5) && map.get(5).is_none() && map.count() == 0, counter);
+    ConcurrentPutResult<Entry> reinserted = map.get_or_emplace(5);
+    expect(reinserted.inserted && reinserted.value == first.value && reinserted.value->value == 0, counter);
+    map.clear();
+
+    // insert/remove churn reuses tombstones instead of running the table out
+    {
+        ConcurrentHashMap<u32, Entry, GeneralPurposeAllocator> small_map(16, &gpa);
+        bool churn_ok{ true };
+        for (u32 i{0}; i < 10'000; ++i) {
+            const u32 key = i % 8;
+            ConcurrentPutResult<Entry> res = small_map.get_or_emplace(key);
+            churn_ok &= res.value != nullptr && small_map.remove(key);
+        }
+        expect(churn_ok && small_map.count() == 0 && small_map.get_or_emplace(100).value != nullptr, counter);
+    }
+
+    // every key is inserted by exactly one thread while others look it up
+    constexpr u32 THREAD_COUNT{4};
+    constexpr u32 KEY_COUNT{800};
+    std::atomic<u32> inserted_count{0};
+    std::atomic<bool> values_ok{ true };
+    {
+        std::thread threads[THREAD_COUNT];
+        for (u32 t{0}; t < THREAD_COUNT; ++t) {
+            threads[t] = std::thread([&map, &inserted_count, &values_ok, t] {
+                for (u32 i{0}; i < KEY_COUNT; ++i) {
+                    // threads walk keys in different order
+                    const u32 key = (i * 7 + t * 131) % KEY_COUNT;
+                    ConcurrentPutResult<Entry> res = map.get_or_emplace(key);
+                    if (res.inserted) {
+                        inserted_count.fetch_add(1);
+                    }
+                    res.value->ref_count.fetch_add(1);
+
+                    // published entry is always constructed
+                    Option<Entry*> found = map.get((key * 13) % KEY_COUNT);
+                    if (found.is_some() && found.unwrap_copy()->value != 0) {
+                        values_ok.store(false);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    bool ref_counts_ok{ true };
+    for (u32 key{0}; key < KEY_COUNT; ++key) {
+        Option<Entry*> found = map.get(key);
+        ref_counts_ok &= found.is_some() && found.unwrap_copy()->ref_count.load() == THREAD_COUNT;
+    }
+    expect(inserted_count.load() == KEY_COUNT && map.count() == KEY_COUNT, counter);
+    expect(ref_counts_ok && values_ok.load(), counter);
+
+    // map which starts small grows while threads insert, values never move
+    {
+        constexpr u32 GROW_KEY_COUNT{ 5000 };
+        ConcurrentHashMap<u32, Entry, GeneralPurposeAllocator> growing_map(16, &gpa);
+        Entry* first_value = growing_map.get_or_emplace(GROW_KEY_COUNT).value;
+        first_value->value = 7;
+        std::thread threads[THREAD_COUNT];
+        for (u32 t{0}; t < THREAD_COUNT; ++t) {
+            threads[t] = std::thread([&growing_map, t] {
+                for (u32 key = t; key < GROW_KEY_COUNT; key += THREAD_COUNT) {
+                    growing_map.get_or_emplace(key).value->value = key + 1;
+                    if (key % 64 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        bool grown_ok{ true };
+        for (u32 key{0}; key < GROW_KEY_COUNT; ++key) {
+            Option<Entry*> found = growing_map.get(key);
+            grown_ok &= found.is_some() && found.unwrap_copy()->value == key + 1;
+        }
+        expect(grown_ok && growing_map.count() == GROW_KEY_COUNT + 1 && growing_map.table_count() > 1, counter);
+        expect(growing_map.get(GROW_KEY_COUNT).unwrap_copy() == first_value && first_value->value == 7, counter);
+    }
 }
 
 void filesystem_test() {
@@ -258,14 +1046,794 @@ void filesystem_test() {
     }
 }
 
+void arena_allocator_virtual_test() {
+    TestCounter counter("Arena Allocator (virtual)");
+    constexpr usize RESERVE_SIZE = 64 * 1024 * 1024;
+    ArenaAllocator alloc(RESERVE_SIZE);
+
+    expect(alloc.is_virtual(), counter);
+    expect(alloc.committed_size() == 0, counter);
+
+    u8* first = static_cast<u8*>(alloc.allocate(128, 8));
+    u8* second = static_cast<u8*>(alloc.allocate(128, 8));
+    expect(first != nullptr && second > first, counter);
+    expect(alloc.committed_size() > 0 && alloc.committed_size() < RESERVE_SIZE, counter);
+
+    ArenaAllocator::Snapshot snapshot = alloc.make_snapshot();
+
+    // touch a few megabytes, pages should be committed lazily
+    constexpr usize BIG_SIZE = 8 * 1024 * 1024;
+    u8* big = static_cast<u8*>(alloc.allocate(BIG_SIZE, 16));
+    sf_mem_set(big, BIG_SIZE, 0xAB);
+    expect(big[BIG_SIZE - 1] == 0xAB, counter);
+    expect(alloc.committed_size() >= BIG_SIZE, counter);
+
+    // rewinding gives pages back
+    alloc.rewind(snapshot);
+    expect(alloc.committed_size() < BIG_SIZE, counter);
+
+    u8* after_rewind = static_cast<u8*>(alloc.allocate(64, 8));
+    expect(after_rewind != nullptr && after_rewind < big + BIG_SIZE, counter);
+
+    alloc.clear();
+    expect(alloc.committed_size() == 0, counter);
+    expect(alloc.allocate(64, 8) == first, counter);
+
+    // huge page arena commits whole huge pages, range starts at huge page boundary
+    ArenaAllocator huge_alloc(RESERVE_SIZE, true);
+    const usize huge_page_size = platform_get_huge_page_size();
+    u8* huge_first = static_cast<u8*>(huge_alloc.allocate(128, 8));
+    expect(huge_alloc.uses_huge_pages() && huge_first != nullptr, counter);
+    expect(reinterpret_cast<usize>(huge_first) / huge_page_size * huge_page_size == reinterpret_cast<usize>(huge_first) - 8, counter);
+    expect(huge_alloc.committed_size() == huge_page_size, counter);
+}
+
+void pool_allocator_test() {
+    TestCounter counter("Pool Allocator");
+
+    struct Item {
+        u64 value;
+        u32 id;
+    };
+
+    PoolAllocator<Item, 64> pool;
+
+    // slots are given out starting from the lowest index
+    u32 first = pool.acquire_slot();
+    u32 second = pool.acquire_slot();
+    expect(first == 0 && second == 1, counter);
+
+    // released slot is reused first
+    pool.release_slot(first);
+    expect(pool.acquire_slot() == first, counter);
+
+    Item* item = pool.construct(Item{ 42, 7 });
+    expect(item != nullptr && item->value == 42, counter);
+    u32 item_index = static_cast<u32>(pool.ptr_to_handle(item));
+    expect(&pool[item_index] == item, counter);
+
+    // growing adds a chunk, old pointers stay valid
+    for (u32 i{0}; i < 100; ++i) {
+        pool.acquire_slot();
+    }
+    expect(pool.chunk_count() == 2, counter);
+    expect(item->value == 42 && &pool[item_index] == item, counter);
+    expect(pool.count() == 103, counter);
+
+    u32 live_count = 0;
+    pool.for_each([&live_count](Item&, u32) { ++live_count; });
+    expect(live_count == pool.count(), counter);
+
+    // handle is computed from the address, pointers outside of committed slots are rejected
+    expect(pool.ptr_to_handle(&pool[100]) == 100 && pool.ptr_to_handle(pool.handle_to_ptr(70)) == 70, counter);
+    expect(pool.ptr_to_handle(reinterpret_cast<u8*>(item) + 1) == item_index, counter);
+    Item outside{};
+    expect(pool.ptr_to_handle(&outside) == INVALID_ID, counter);
+    expect(pool.ptr_to_handle(reinterpret_cast<u8*>(pool.handle_to_ptr(0)) - 1) == INVALID_ID, counter);
+    expect(pool.ptr_to_handle(reinterpret_cast<u8*>(pool.handle_to_ptr(127)) + sizeof(decltype(pool)::Slot)) == INVALID_ID, counter);
+
+    pool.destroy(item);
+    expect(!pool.is_occupied(item_index), counter);
+
+    pool.clear();
+    expect(pool.count() == 0 && pool.acquire_slot() == 0, counter);
+}
+
+void frame_allocator_test() {
+    TestCounter counter("Frame Allocator");
+    FrameAllocator alloc(64 * 1024);
+
+    u64* first = static_cast<u64*>(alloc.allocate(sizeof(u64), alignof(u64)));
+    *first = 42;
+    void* aligned = alloc.allocate(100, 64);
+    expect(reinterpret_cast<usize>(aligned) % 64 == 0, counter);
+
+    // handles round trip
+    usize handle = alloc.ptr_to_handle(aligned);
+    expect(alloc.handle_to_ptr(handle) == aligned, counter);
+
+    // last allocation grows in place
+    ReallocReturn realloc_res = alloc.reallocate(aligned, 1000, 64);
+    expect(realloc_res.ptr == aligned && !realloc_res.should_mem_copy, counter);
+    realloc_res = alloc.reallocate(first, 16, alignof(u64));
+    expect(realloc_res.ptr != first && realloc_res.should_mem_copy, counter);
+
+    // data of the previous frame survives one end_frame
+    const usize count_before = alloc.count();
+    alloc.end_frame();
+    expect(alloc.count() == 0 && *first == 42, counter);
+    void* next_frame_ptr = alloc.allocate(sizeof(u64), alignof(u64));
+    expect(next_frame_ptr != first, counter);
+
+    // region is reused after every frame in flight has passed
+    for (u32 i{0}; i < FrameAllocator::FRAME_COUNT - 1; ++i) {
+        alloc.end_frame();
+    }
+    expect(alloc.allocate(sizeof(u64), alignof(u64)) == first, counter);
+    expect(alloc.peak_count() >= count_before, counter);
+
+    // requests bigger than frame capacity fail instead of growing
+    expect(alloc.allocate(alloc.frame_capacity() + 1, 8) == nullptr, counter);
+}
+
+void thread_cache_allocator_test() {
+    TestCounter counter("Thread Cache Allocator");
+    ThreadCacheAllocator alloc;
+
+    void* small = alloc.allocate(24, 8);
+    expect(ThreadCacheAllocator::block_size(small) == 32, counter);
+    void* medium = alloc.allocate(1000, 8);
+    expect(ThreadCacheAllocator::block_size(medium) >= 1000 && ThreadCacheAllocator::block_size(medium) < 1200, counter);
+    void* large = alloc.allocate(100 * 1024, 8);
+    expect(ThreadCacheAllocator::block_size(large) == 100 * 1024, counter);
+    void* aligned = alloc.allocate(100, 256);
+    expect(reinterpret_cast<usize>(aligned) % 256 == 0, counter);
+
+    // freed block goes to the thread cache and is handed out again
+    alloc.free(small);
+    expect(alloc.allocate(24, 8) == small, counter);
+
+    // realloc keeps content
+    sf_mem_set(small, 24, 7);
+    ReallocReturn realloc_res = alloc.reallocate(small, 500, 8);
+    expect(!realloc_res.should_mem_copy && static_cast<u8*>(realloc_res.ptr)[23] == 7, counter);
+    alloc.free(realloc_res.ptr);
+    alloc.free(medium);
+    alloc.free(large);
+    alloc.free(aligned);
+
+    // every thread fills its blocks, half is freed by owner, the rest by the main thread
+    constexpr u32 THREAD_COUNT{4};
+    constexpr u32 BLOCK_COUNT{2000};
+    FixedArray<void*, THREAD_COUNT * BLOCK_COUNT> blocks(THREAD_COUNT * BLOCK_COUNT);
+    bool content_valid[THREAD_COUNT]{};
+    {
+        std::thread threads[THREAD_COUNT];
+        for (u32 t{0}; t < THREAD_COUNT; ++t) {
+            threads[t] = std::thread([&blocks, &content_valid, t] {
+                ThreadCacheAllocator thread_alloc;
+                void** thread_blocks = blocks.data() + t * BLOCK_COUNT;
+                for (u32 i{0}; i < BLOCK_COUNT; ++i) {
+                    const usize size = 8 + (i * 37) % 3000;
+                    thread_blocks[i] = thread_alloc.allocate(size, 8);
+                    sf_mem_set(thread_blocks[i], size, static_cast<u8>(t));
+                }
+                bool valid = true;
+                for (u32 i{0}; i < BLOCK_COUNT; ++i) {
+                    const usize size = 8 + (i * 37) % 3000;
+                    valid &= static_cast<u8*>(thread_blocks[i])[size - 1] == static_cast<u8>(t);
+                }
+                for (u32 i{0}; i < BLOCK_COUNT; i += 2) {
+                    thread_alloc.free(thread_blocks[i]);
+                }
+                content_valid[t] = valid;
+
+                // scratch stack of the thread
+                StackAllocator& scratch = thread_scratch_allocator();
+                {
+                    AllocatorScope scope{ scratch };
+                    scratch.allocate(1024, 16);
+                }
+                content_valid[t] &= scratch.count() == 0;
+            });
+        }
+        for (u32 t{0}; t < THREAD_COUNT; ++t) {
+            threads[t].join();
+        }
+    }
+
+    for (u32 t{0}; t < THREAD_COUNT; ++t) {
+        expect(content_valid[t], counter);
+        for (u32 i{1}; i < BLOCK_COUNT; i += 2) {
+            alloc.free(blocks[t * BLOCK_COUNT + i]);
+        }
+    }
+    ThreadCacheAllocator::flush_thread_cache();
+    expect(ThreadCacheAllocator::thread_cache_size() == 0, counter);
+}
+
+void tlsf_allocator_test() {
+    TestCounter counter("TLSF Allocator");
+    TLSFAllocator alloc(4096, false);
+    const usize initial_space = alloc.get_remain_space();
+
+    {
+        FixedArray<void*, 16> ptrs;
+        for (u32 i{0}; i < ptrs.capacity(); ++i) {
+            ptrs.append(alloc.allocate(64 + i * 8, 8));
+            expect(ptrs[i] != nullptr, counter);
+        }
+
+        // free every second block, then the rest, all neighbours should be coalesced back
+        for (u32 i{0}; i < ptrs.count(); i += 2) {
+            alloc.free(ptrs[i]);
+        }
+        for (u32 i{1}; i < ptrs.count(); i += 2) {
+            alloc.free(ptrs[i]);
+        }
+        expect(alloc.get_remain_space() == initial_space, counter);
+        expect(alloc.get_largest_free_block() == initial_space, counter);
+    }
+
+    {
+        void* aligned = alloc.allocate(100, 256);
+        expect((reinterpret_cast<usize>(aligned) & 255) == 0, counter);
+        alloc.free(aligned);
+        expect(alloc.get_remain_space() == initial_space, counter);
+    }
+
+    {
+        u8* ptr = static_cast<u8*>(alloc.allocate(32, 8));
+        for (u8 i{0}; i < 32; ++i) {
+            ptr[i] = i;
+        }
+        // next block is free -> grow in place
+        ReallocReturn res = alloc.reallocate(ptr, 512, 8);
+        expect(res.ptr == ptr, counter);
+        expect(ptr[31] == 31, counter);
+        alloc.free(res.ptr);
+    }
+
+    {
+        // non resizable allocator returns nullptr when out of memory
+        expect(alloc.allocate(8192, 8) == nullptr, counter);
+
+        TLSFAllocator growing(1024, true);
+        void* big = growing.allocate(8192, 8);
+        expect(big != nullptr, counter);
+        expect(growing.pool_count() == 2, counter);
+        growing.free(big);
+    }
+}
+
+#ifdef SF_MEMORY_TRACKING
+void memory_tracker_test() {
+    TestCounter counter("Memory Tracker");
+    const MemoryTagStats init_stats = memory_tracker_get_stats(MemoryTag::TEST);
+    memory_tracker_end_frame();
+
+    GeneralPurposeAllocator gpa;
+    gpa.set_memory_tag(MemoryTag::TEST);
+    void* first = gpa.allocate(100, 8);
+    void* second = gpa.allocate(50, 32);
+    expect(reinterpret_cast<usize>(second) % 32 == 0, counter);
+
+    MemoryTagStats stats = memory_tracker_get_stats(MemoryTag::TEST);
+    expect(stats.current_bytes - init_stats.current_bytes == 150, counter);
+    expect(stats.alloc_count - init_stats.alloc_count == 2, counter);
+
+    first = gpa.reallocate(first, 200, 8).ptr;
+    gpa.free(second);
+    stats = memory_tracker_get_stats(MemoryTag::TEST);
+    expect(stats.current_bytes - init_stats.current_bytes == 200, counter);
+
+    gpa.free(first);
+    stats = memory_tracker_get_stats(MemoryTag::TEST);
+    expect(stats.current_bytes == init_stats.current_bytes, counter);
+    expect(stats.peak_bytes >= init_stats.current_bytes + 250, counter);
+
+    // clear gives back everything at once
+    LinearAllocator linear(256);
+    linear.set_memory_tag(MemoryTag::TEST);
+    linear.allocate(64, 8);
+    linear.allocate(64, 8);
+    expect(memory_tracker_get_stats(MemoryTag::TEST).current_bytes - init_stats.current_bytes == 128, counter);
+    linear.clear();
+    expect(memory_tracker_get_stats(MemoryTag::TEST).current_bytes == init_stats.current_bytes, counter);
+
+    // allocation count of the frame is published at the end of frame
+    memory_tracker_end_frame();
+    expect(memory_tracker_get_stats(MemoryTag::TEST).frame_alloc_count == 5, counter);
+    memory_tracker_end_frame();
+    expect(memory_tracker_get_stats(MemoryTag::TEST).frame_alloc_count == 0, counter);
+
+    // frames which allocate after warmup are reported
+    memory_tracker_expect_zero_frame_allocs(true, 1);
+    gpa.free(gpa.allocate(16, 8));
+    memory_tracker_end_frame();
+    expect(memory_tracker_get_violation_count() == 0, counter);
+    gpa.free(gpa.allocate(16, 8));
+    memory_tracker_end_frame();
+    expect(memory_tracker_get_violation_count() == 1, counter);
+    memory_tracker_expect_zero_frame_allocs(false);
+
+    // containers with their own storage are tracked under their own tag
+    {
+        SlotMap<u64> map;
+        map.set_memory_tag(MemoryTag::TEST);
+        map.insert(1);
+        expect(memory_tracker_get_stats(MemoryTag::TEST).current_bytes - init_stats.current_bytes == sizeof(SlotMap<u64>::Entry), counter);
+    }
+    expect(memory_tracker_get_stats(MemoryTag::TEST).current_bytes == init_stats.current_bytes, counter);
+}
+#endif
+
+struct JobTestState {
+    JobSystem*          system;
+    std::atomic<u64>    sum{0};
+    std::atomic<u32>    bad_worker_count{0};
+    std::atomic<u32>    leaked_scratch_count{0};
+    u64                 values[256];
+    u64                 stage_sum;
+};
+
+struct JobTestItem {
+    JobTestState*   state;
+    u32             index;
+};
+
+void job_system_test() {
+    TestCounter counter{"JobSystem"};
+
+    GeneralPurposeAllocator gpa;
+    JobSystem system;
+    expect(JobSystem::create(gpa, 4, system) && system.worker_count() == 4 && JobSystem::worker_index() == 0, counter);
+
+    JobTestState state;
+    state.system = &system;
+    JobTestItem items[256];
+    Job jobs[256];
+    for (u32 i{0}; i < 256; ++i) {
+        items[i] = { &state, i };
+    }
+
+    // every job runs once, scratch is rewound between jobs
+    for (u32 i{0}; i < 256; ++i) {
+        jobs[i] = { [](void* data) {
+            JobTestItem& item = *static_cast<JobTestItem*>(data);
+            if (JobSystem::worker_index() >= item.state->system->worker_count()) {
+                item.state->bad_worker_count.fetch_add(1);
+            }
+            StackAllocator& scratch = JobSystem::scratch_allocator();
+            if (scratch.count() != 0) {
+                item.state->leaked_scratch_count.fetch_add(1);
+            }
+            scratch.allocate(64, 16);
+            item.state->sum.fetch_add(item.index + 1);
+        }, &items[i] };
+    }
+    JobCounter sum_counter;
+    system.run({ jobs, 128 }, &sum_counter);
+    system.run({ jobs + 128, 128 }, &sum_counter);
+    system.wait(sum_counter);
+    expect(state.sum.load() == 256 * 257 / 2 && state.bad_worker_count.load() == 0 && state.leaked_scratch_count.load() == 0, counter);
+
+    // second stage depends on the first one through its counter
+    for (u32 i{0}; i < 256; ++i) {
+        jobs[i] = { [](void* data) {
+            JobTestItem& item = *static_cast<JobTestItem*>(data);
+            item.state->values[item.index] = item.index * 3;
+        }, &items[i] };
+    }
+    JobCounter stage_counter;
+    system.run(jobs, &stage_counter);
+    const Job reduce_job{ [](void* data) {
+        JobTestState& state = *static_cast<JobTestState*>(data);
+        state.stage_sum = 0;
+        for (u64 value : state.values) {
+            state.stage_sum += value;
+        }
+    }, &state };
+    system.wait(stage_counter);
+    JobCounter reduce_counter;
+    system.run(reduce_job, &reduce_counter);
+    system.wait(reduce_counter);
+    expect(state.stage_sum == 3 * 255 * 256 / 2, counter);
+
+    // jobs spawn and wait for their own jobs, waiting workers keep running others
+    state.sum.store(0);
+    for (u32 i{0}; i < 16; ++i) {
+        jobs[i] = { [](void* data) {
+            JobTestItem& item = *static_cast<JobTestItem*>(data);
+            JobTestItem children[16];
+            Job child_jobs[16];
+            for (u32 c{0}; c < 16; ++c) {
+                children[c] = { item.state, c };
+                child_jobs[c] = { [](void* child_data) {
+                    static_cast<JobTestItem*>(child_data)->state->sum.fetch_add(1);
+                }, &children[c] };
+            }
+            JobCounter children_counter;
+            item.state->system->run(child_jobs, &children_counter);
+            item.state->system->wait(children_counter);
+        }, &items[i] };
+    }
+    JobCounter parent_counter;
+    system.run({ jobs, 16 }, &parent_counter);
+    system.wait(parent_counter);
+    expect(state.sum.load() == 16 * 16 && parent_counter.is_done(), counter);
+
+    // threads outside of the system run jobs inline
+    state.values[16] = 0;
+    std::thread outsider([&] {
+        JobCounter outsider_counter;
+        system.run({ jobs + 16, 1 }, &outsider_counter);
+        if (!outsider_counter.is_done() || JobSystem::worker_index() != INVALID_ID) {
+            state.bad_worker_count.fetch_add(1);
+        }
+    });
+    outsider.join();
+    expect(state.values[16] == 48 && state.bad_worker_count.load() == 0, counter);
+
+    system.destroy();
+    expect(system.worker_count() == 0 && JobSystem::worker_index() == INVALID_ID, counter);
+}
+
+void parallel_test() {
+    TestCounter counter{"Parallel algorithms"};
+
+    GeneralPurposeAllocator gpa;
+    JobSystem system;
+    JobSystem::create(gpa, 4, system);
+
+    constexpr u32 COUNT{ 100'003 };
+    DynamicArray<u64, GeneralPurposeAllocator, false> items(COUNT, &gpa);
+    DynamicArray<u64, GeneralPurposeAllocator, false> scratch(COUNT, &gpa);
+    DynamicArray<u64, GeneralPurposeAllocator, false> expected(COUNT, &gpa);
+    items.resize(COUNT);
+    scratch.resize(COUNT);
+    expected.resize(COUNT);
+
+    parallel_for(system, COUNT, [&items](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i) {
+            items[i] = static_cast<u64>(i) * i;
+        }
+    });
+    bool is_ok{ true };
+    for (u32 i{0}; i < COUNT; ++i) {
+        is_ok &= items[i] == static_cast<u64>(i) * i;
+    }
+    expect(is_ok, counter);
+
+    parallel_for_each(system, items.to_span(), [](u64& item) { item = 1; });
+    const u64 sum = parallel_reduce(system, items.to_span(), 0ULL, [](u64 item) { return item * 2; }, [](u64 lhs, u64 rhs) { return lhs + rhs; });
+    expect(sum == 2ULL * COUNT, counter);
+
+    for (u32 i{0}; i < COUNT; ++i) {
+        items[i] = i % 7;
+    }
+    u64 running{0};
+    for (u32 i{0}; i < COUNT; ++i) {
+        expected[i] = running;
+        running += items[i];
+    }
+    const u64 total = parallel_exclusive_scan<u64>(system, items.to_span(), items.to_span());
+    expect(total == running && std::equal(items.data(), items.data() + COUNT, expected.data()), counter);
+    for (u32 i{0}; i < COUNT; ++i) {
+        items[i] = i % 7;
+    }
+    parallel_inclusive_scan<u64>(system, items.to_span(), scratch.to_span());
+    expect(scratch[0] == 0 && scratch[COUNT - 1] == running, counter);
+
+    // stable: both groups keep ascending order
+    for (u32 i{0}; i < COUNT; ++i) {
+        items[i] = i;
+    }
+    const u32 even_count = parallel_partition(system, items.to_span(), scratch.to_span(), [](u64 item) { return item % 2 == 0; });
+    is_ok = even_count == (COUNT + 1) / 2;
+    for (u32 i{0}; i < COUNT; ++i) {
+        is_ok &= (i < even_count) ? items[i] == 2ULL * i : items[i] == 2ULL * (i - even_count) + 1;
+    }
+    expect(is_ok, counter);
+
+    u64 seed{ 0x9E3779B97F4A7C15ULL };
+    auto next_random = [&seed] {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    for (u32 i{0}; i < COUNT; ++i) {
+        items[i] = next_random();
+        expected[i] = items[i];
+    }
+    std::sort(expected.data(), expected.data() + COUNT);
+    parallel_radix_sort(system, items.to_span(), scratch.to_span());
+    expect(std::equal(items.data(), items.data() + COUNT, expected.data()), counter);
+
+    for (u32 i{0}; i < COUNT; ++i) {
+        items[i] = next_random();
+        expected[i] = items[i];
+    }
+    std::sort(expected.data(), expected.data() + COUNT);
+    parallel_merge_sort(system, items.to_span(), scratch.to_span());
+    expect(std::equal(items.data(), items.data() + COUNT, expected.data()), counter);
+    parallel_merge_sort(system, items.to_span(), scratch.to_span(), std::greater<>{});
+    expect(std::is_sorted(items.data(), items.data() + COUNT, std::greater<>{}), counter);
+
+    // radix sort by a narrow key keeps the order of equal keys
+    struct DrawItem {
+        u32 key;
+        u32 order;
+    };
+    DynamicArray<DrawItem, GeneralPurposeAllocator, false> draws(COUNT, &gpa);
+    DynamicArray<DrawItem, GeneralPurposeAllocator, false> draws_scratch(COUNT, &gpa);
+    draws.resize(COUNT);
+    draws_scratch.resize(COUNT);
+    for (u32 i{0}; i < COUNT; ++i) {
+        draws[i] = { static_cast<u32>(next_random() % 300), i };
+    }
+    parallel_radix_sort(system, draws.to_span(), draws_scratch.to_span(), [](const DrawItem& draw) { return draw.key; });
+    is_ok = true;
+    for (u32 i{1}; i < COUNT; ++i) {
+        is_ok &= draws[i - 1].key < draws[i].key || (draws[i - 1].key == draws[i].key && draws[i - 1].order < draws[i].order);
+    }
+    expect(is_ok, counter);
+
+    // small and empty inputs stay on the calling thread
+    u64 small[5]{ 5, 3, 4, 1, 2 };
+    u64 small_scratch[5];
+    parallel_merge_sort(system, std::span<u64>{ small }, std::span<u64>{ small_scratch });
+    expect(std::is_sorted(small, small + 5), counter);
+    parallel_radix_sort(system, std::span<u64>{ small, 0 }, std::span<u64>{ small_scratch, 0 });
+    expect(parallel_partition(system, std::span<u64>{ small, 0 }, std::span<u64>{ small_scratch, 0 }, [](u64) { return true; }) == 0, counter);
+
+    system.destroy();
+}
+
+void async_io_test() {
+    TestCounter counter{"AsyncIo"};
+
+    constexpr u32 FILE_SIZE{ 1024 * 1024 + 123 };
+    constexpr u32 CHUNK_SIZE{ 64 * 1024 };
+    constexpr u32 CHUNK_COUNT{ FILE_SIZE / CHUNK_SIZE };
+    const char* file_path = "sf_async_io_test.bin";
+    const char* missing_path = "sf_async_io_test_missing.bin";
+
+    GeneralPurposeAllocator gpa;
+    u8* file_data = static_cast<u8*>(gpa.allocate(FILE_SIZE, 16));
+    for (u32 i{0}; i < FILE_SIZE; ++i) {
+        file_data[i] = static_cast<u8>((i * 31) % 251);
+    }
+    std::FILE* file = std::fopen(file_path, "wb");
+    expect(file && std::fwrite(file_data, 1, FILE_SIZE, file) == FILE_SIZE, counter);
+    if (file) {
+        std::fclose(file);
+    }
+    Option<u64> file_size = io_file_size(file_path);
+    expect(file_size.is_some() && file_size.unwrap_copy() == FILE_SIZE && io_file_size(missing_path).is_none(), counter);
+
+    u8* read_data = static_cast<u8*>(gpa.allocate(FILE_SIZE, 16));
+    const AsyncIoBackend backends[]{ AsyncIoBackend::IO_URING, AsyncIoBackend::THREAD_POOL };
+    for (AsyncIoBackend backend : backends) {
+        AsyncIoSystem system;
+        expect(AsyncIoSystem::create(backend, system), counter);
+        if (backend == AsyncIoBackend::THREAD_POOL) {
+            expect(system.backend() == AsyncIoBackend::THREAD_POOL, counter);
+        }
+
+        // one batch of chunks with mixed priorities, each chunk is read in place
+        sf_mem_zero(read_data, FILE_SIZE);
+        std::atomic<u32> callback_count{ 0 };
+        IoRequest requests[CHUNK_COUNT];
+        IoRequest* request_ptrs[CHUNK_COUNT];
+        for (u32 i{0}; i < CHUNK_COUNT; ++i) {
+            IoRequest* request = sf_mem_place(&requests[i], file_path, read_data + i * CHUNK_SIZE, CHUNK_SIZE, static_cast<u64>(i) * CHUNK_SIZE, static_cast<IoPriority>(i % static_cast<u32>(IoPriority::COUNT)));
+            request->user_data = &callback_count;
+            request->callback = [](IoRequest& request) {
+                static_cast<std::atomic<u32>*>(request.user_data)->fetch_add(1, std::memory_order_relaxed);
+            };
+            request_ptrs[i] = request;
+        }
+        system.submit_batch({ request_ptrs, CHUNK_COUNT });
+
+        bool is_ok{ true };
+        for (u32 i{0}; i < CHUNK_COUNT; ++i) {
+            is_ok &= requests[i].wait() && requests[i].bytes_read == CHUNK_SIZE;
+        }
+        expect(is_ok && callback_count.load() == CHUNK_COUNT, counter);
+        expect(sf_mem_cmp(read_data, file_data, CHUNK_COUNT * CHUNK_SIZE), counter);
+
+        // tail of the file is shorter than the request
+        IoRequest tail(file_path, read_data, CHUNK_SIZE, CHUNK_COUNT * CHUNK_SIZE, IoPriority::HIGH);
+        system.submit(tail);
+        expect(tail.wait() && tail.bytes_read == FILE_SIZE - CHUNK_COUNT * CHUNK_SIZE, counter);
+        expect(sf_mem_cmp(read_data, file_data + CHUNK_COUNT * CHUNK_SIZE, tail.bytes_read), counter);
+
+        IoRequest missing(missing_path, read_data, CHUNK_SIZE);
+        system.submit(missing);
+        expect(!missing.wait() && missing.status.load() == IoStatus::FAILED && missing.error != 0, counter);
+
+        // read_file goes through the created system
+        AllocatorScope scope{ thread_scratch_allocator() };
+        Result<String<StackAllocator>> contents = read_file(file_path, thread_scratch_allocator());
+        expect(!contents.is_err() && contents.unwrap_ref().count() == FILE_SIZE && sf_mem_cmp(contents.unwrap_ref().data(), file_data, FILE_SIZE), counter);
+
+        system.destroy();
+    }
+
+    // no system: requests run on the calling thread
+    IoRequest sync_request(file_path, read_data, FILE_SIZE);
+    expect(io_read_blocking(sync_request) && sync_request.bytes_read == FILE_SIZE && sf_mem_cmp(read_data, file_data, FILE_SIZE), counter);
+
+    std::remove(file_path);
+    gpa.free(read_data);
+    gpa.free(file_data);
+}
+
+void mapped_file_test() {
+    TestCounter counter{"MappedFile"};
+
+    const char* file_path = "sf_mapped_file_test.txt";
+    const char* empty_path = "sf_mapped_file_test_empty.txt";
+    constexpr std::string_view CONTENTS = "name=test_material\ndiffuse_color=1.0 0.5 0.25 1.0\n";
+
+    std::FILE* file = std::fopen(file_path, "wb");
+    expect(file && std::fwrite(CONTENTS.data(), 1, CONTENTS.size(), file) == CONTENTS.size(), counter);
+    if (file) {
+        std::fclose(file);
+    }
+    file = std::fopen(empty_path, "wb");
+    if (file) {
+        std::fclose(file);
+    }
+
+    {
+        MappedFile view;
+        expect(MappedFile::open(file_path, view) && view.size() == CONTENTS.size() && view.to_sv() == CONTENTS, counter);
+        expect(reinterpret_cast<usize>(view.bytes().data()) % get_mem_page_size() == 0, counter);
+
+        // parser works on the mapping in place
+        Parser parser{ view.to_sv() };
+        FixedString<64> line_buff;
+        expect(parser.parse_until('=', line_buff) && line_buff.to_string_view() == "name", counter);
+
+        MappedFile moved{ std::move(view) };
+        expect(view.size() == 0 && view.bytes().empty() && moved.to_sv() == CONTENTS, counter);
+
+        MappedFile random_view;
+        expect(MappedFile::open(file_path, random_view, FileAccessHint::RANDOM) && random_view.bytes()[5] == static_cast<u8>(CONTENTS[5]), counter);
+        random_view = std::move(moved);
+        expect(random_view.to_sv() == CONTENTS && moved.size() == 0, counter);
+
+        random_view.close();
+        expect(random_view.size() == 0, counter);
+    }
+
+    {
+        MappedFile empty_view;
+        expect(MappedFile::open(empty_path, empty_view) && empty_view.size() == 0 && empty_view.bytes().empty(), counter);
+
+        MappedFile missing_view;
+        expect(!MappedFile::open("sf_mapped_file_test_missing.txt", missing_view) && missing_view.size() == 0, counter);
+    }
+
+    std::remove(file_path);
+    std::remove(empty_path);
+}
+
+void resource_ref_state_test() {
+    TestCounter counter{"ResourceRefState"};
+
+    {
+        ResourceRefState state;
+        expect(state.acquire() == ResourceAcquireResult::SHOULD_LOAD && !state.try_claim_load() && state.state() == ResourceLoadState::LOADING, counter);
+        state.finish_load(true);
+        expect(state.state() == ResourceLoadState::READY && state.ref_count() == 1, counter);
+        expect(state.acquire() == ResourceAcquireResult::ACQUIRED && state.ref_count() == 2, counter);
+        expect(state.release(true) == ResourceReleaseResult::RELEASED && state.release(true) == ResourceReleaseResult::SHOULD_DESTROY, counter);
+        expect(state.state() == ResourceLoadState::RELEASING && state.release(true) == ResourceReleaseResult::NOT_HELD, counter);
+        state.finish_release();
+        expect(state.state() == ResourceLoadState::UNLOADED && state.release(false) == ResourceReleaseResult::NOT_HELD, counter);
+
+        // entry which isn't auto released keeps its resource with zero references
+        expect(state.try_claim_load(), counter);
+        state.finish_load(true);
+        expect(state.release(false) == ResourceReleaseResult::RELEASED && state.ref_count() == 0 && state.acquire() == ResourceAcquireResult::ACQUIRED, counter);
+    }
+
+    {
+        // thread which waited for a failed load gets the failure, later calls load again
+        ResourceRefState state;
+        expect(state.try_claim_load(), counter);
+        std::atomic<ResourceAcquireResult> waiter_result{ ResourceAcquireResult::ACQUIRED };
+        std::thread waiter([&state, &waiter_result] {
+            waiter_result.store(state.acquire());
+        });
+        std::this_thread::yield();
+        state.finish_load(false);
+        waiter.join();
+        expect(waiter_result.load() == ResourceAcquireResult::FAILED && state.acquire() == ResourceAcquireResult::SHOULD_LOAD, counter);
+        state.finish_load(true);
+    }
+
+    {
+        // references are never taken from an entry which is being destroyed
+        constexpr u32 THREAD_COUNT{ 4 };
+        constexpr u32 ITERATION_COUNT{ 2000 };
+        ResourceRefState state;
+        std::atomic<u32> is_alive{ 0 };
+        std::atomic<u32> load_count{ 0 };
+        std::atomic<bool> is_ok{ true };
+        std::thread threads[THREAD_COUNT];
+        for (std::thread& thread : threads) {
+            thread = std::thread([&] {
+                for (u32 i{0}; i < ITERATION_COUNT; ++i) {
+                    switch (state.acquire()) {
+                        case ResourceAcquireResult::SHOULD_LOAD: {
+                            if (is_alive.exchange(1) != 0) {
+                                is_ok.store(false);
+                            }
+                            load_count.fetch_add(1);
+                            state.finish_load(true);
+                        } break;
+                        case ResourceAcquireResult::ACQUIRED: {
+                            if (is_alive.load() != 1) {
+                                is_ok.store(false);
+                            }
+                        } break;
+                        case ResourceAcquireResult::FAILED: {
+                            is_ok.store(false);
+                        } continue;
+                    }
+                    std::this_thread::yield();
+                    if (state.release(true) == ResourceReleaseResult::SHOULD_DESTROY) {
+                        is_alive.store(0);
+                        state.finish_release();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        expect(is_ok.load() && is_alive.load() == 0 && state.state() == ResourceLoadState::UNLOADED && load_count.load() > 0, counter);
+    }
+}
+
 void TestManager::collect_all_tests() {
     module_tests.append(hashmap_test);
+    module_tests.append(swiss_hashmap_test);
+    module_tests.append(paged_array_test);
+    module_tests.append(slot_map_test);
+    module_tests.append(general_purpose_allocator_test);
     module_tests.append(linear_allocator_test);
     module_tests.append(stack_allocator_test);
     module_tests.append(freelist_allocator_test);
+    module_tests.append(arena_allocator_virtual_test);
+    module_tests.append(pool_allocator_test);
+    module_tests.append(frame_allocator_test);
+    module_tests.append(thread_cache_allocator_test);
+    module_tests.append(tlsf_allocator_test);
+#ifdef SF_MEMORY_TRACKING
+    module_tests.append(memory_tracker_test);
+#endif
+    module_tests.append(hash_test);
+    module_tests.append(string_interner_test);
     module_tests.append(fixed_array_test);
     module_tests.append(dyn_array_test);
+    module_tests.append(small_array_test);
+    module_tests.append(soa_array_test);
     module_tests.append(bitset_test);
+    module_tests.append(dynamic_bitset_test);
+    module_tests.append(spsc_queue_test);
+    module_tests.append(mpmc_queue_test);
+    module_tests.append(concurrent_hashmap_test);
+    module_tests.append(resource_ref_state_test);
+    module_tests.append(job_system_test);
+    module_tests.append(parallel_test);
+    module_tests.append(async_io_test);
+    module_tests.append(mapped_file_test);
     module_tests.append(filesystem_test);
 }
 
@@ -1,6 +1,7 @@
 #include "sf_vulkan/buffer.hpp"
 #include "sf_core/logger.hpp"
 #include "sf_core/memory_sf.hpp"
+#include "sf_core/memory_tracker.hpp"
 #include "sf_vulkan/command_buffer.hpp"
 #include "sf_vulkan/device.hpp"
 #include "sf_vulkan/pipeline.hpp"
@@ -43,6 +44,7 @@ void VulkanBuffer::create(
 
     // TODO: custom allocator
     sf_vk_check(vkAllocateMemory(device.logical_device, &alloc_info, nullptr, &out_buffer.memory.handle));
+    memory_track_alloc(MemoryTag::VULKAN, out_buffer.memory.requirements.size);
     sf_vk_check(vkBindBufferMemory(device.logical_device, out_buffer.handle, out_buffer.memory.handle, 0));
 }
 
@@ -67,6 +69,7 @@ void VulkanBuffer::destroy(const VulkanDevice& device) {
     if (memory.handle) {
         // TODO: custom allocator
         vkFreeMemory(device.logical_device, memory.handle, nullptr);
+        memory_track_free(MemoryTag::VULKAN, memory.requirements.size);
         memory.handle = nullptr;
     }
 }
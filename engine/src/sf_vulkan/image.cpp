@@ -1,6 +1,7 @@
 #include "sf_vulkan/image.hpp"
 #include "sf_containers/optional.hpp"
 #include "sf_core/logger.hpp"
+#include "sf_core/memory_tracker.hpp"
 #include "sf_vulkan/command_buffer.hpp"
 #include "sf_vulkan/device.hpp"
 #include "sf_vulkan/renderer.hpp"
@@ -59,6 +60,8 @@ bool VulkanImage::create(
     allocate_info.memoryTypeIndex = memory_type.unwrap_copy();
     // TODO: custom allocator
     sf_vk_check(vkAllocateMemory(device.logical_device, &allocate_info, nullptr, &out_image.memory));
+    out_image.memory_size = memory_requirements.size;
+    memory_track_alloc(MemoryTag::VULKAN, out_image.memory_size);
 
     sf_vk_check(vkBindImageMemory(device.logical_device, out_image.handle, out_image.memory, 0));
 
@@ -142,6 +145,7 @@ void VulkanImage::destroy(const VulkanDevice& device) {
     if (memory) {
         // TODO: custom allocator
         vkFreeMemory(device.logical_device, memory, nullptr);
+        memory_track_free(MemoryTag::VULKAN, memory_size);
         memory = nullptr;
     }
     if (handle) {
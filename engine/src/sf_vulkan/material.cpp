@@ -1,5 +1,6 @@
 #include "sf_vulkan/material.hpp"
 #include "glm/ext/vector_float4.hpp"
+#include "sf_allocators/allocator_scope.hpp"
 #include "sf_allocators/arena_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_containers/fixed_array.hpp"
@@ -9,12 +10,16 @@
 #include "sf_core/logger.hpp"
 #include "sf_core/io.hpp"
 #include "sf_core/application.hpp"
+#include "sf_core/async_io.hpp"
+#include "sf_core/mapped_file.hpp"
 #include "sf_core/memory_sf.hpp"
 #include "sf_core/parsing.hpp"
+#include "sf_core/string_id.hpp"
 #include "sf_vulkan/command_buffer.hpp"
 #include "sf_vulkan/device.hpp"
 #include "sf_vulkan/pipeline.hpp"
 #include "sf_vulkan/texture.hpp"
+#include <limits>
 #include <span>
 #include <string_view>
 
@@ -22,15 +27,9 @@ namespace sf {
 
 static MaterialSystem* state_ptr{nullptr};
 
-void Material::create_empty(u32 id, Material& mat) {
-    sf_mem_zero(&mat, sizeof(Material));
-    mat.id = id;
-    mat.generation = INVALID_ID;
-}
-
 void Material::destroy() {
-    id = INVALID_ID;
-    generation = INVALID_ID;
+    texture_maps.clear();
+    config.set_none();
 }
 
 // NOTE: must be ordered as in MaterialConfig struct
@@ -38,74 +37,74 @@ FixedArray<std::string_view, MaterialConfig::PROP_COUNT> config_property_names{
     "name", "diffuse_texture_name", "diffuse_color", "auto_release"
 };
 
-void MaterialSystem::create(ArenaAllocator& system_allocator, MaterialSystem& out_system) {
+void MaterialSystem::create(MaterialSystem& out_system) {
     state_ptr = &out_system;
-    out_system.materials.set_allocator(&system_allocator);
-    out_system.material_lookup_table.set_allocator(&system_allocator);
-    out_system.materials.resize(INIT_MATERIAL_AMOUNT);
-    out_system.material_lookup_table.reserve(INIT_MATERIAL_AMOUNT);
-
-    u32 count = out_system.materials.count();
-    for (u32 i{0}; i < count; ++i) {
-        auto& mat = out_system.materials[i];
-        Material::create_empty(i, mat);
-    }
+    out_system.materials.set_memory_tag(MemoryTag::MATERIAL);
+    out_system.lookup_allocator.set_memory_tag(MemoryTag::MATERIAL);
+    out_system.material_lookup_table.create(INIT_MATERIAL_AMOUNT, &out_system.lookup_allocator);
 }
 
 void MaterialSystem::create_default_material(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc) {
-    MaterialSystem::load_and_get_material_from_file(MaterialSystem::DEFAULT_FILE_NAME, device, cmd_buffer, alloc);
+    state_ptr->default_material = MaterialSystem::load_and_get_material_from_file(MaterialSystem::DEFAULT_FILE_NAME, device, cmd_buffer, alloc);
 }
 
-Material& MaterialSystem::get_default_material() {
-    SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
-    return state_ptr->materials[0];
+MaterialHandle MaterialSystem::get_default_material() {
+    SF_ASSERT_MSG(state_ptr && state_ptr->materials.contains(state_ptr->default_material), "Should have the default material");
+    return state_ptr->default_material;
 }
 
-Material& MaterialSystem::get_empty_slot() {
+Material* MaterialSystem::get_material(MaterialHandle handle) {
     SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
+    return state_ptr->materials.get(handle);
+}
 
-    auto& materials = state_ptr->materials;
-    u32 count{ materials.count() };
-    
-    for (u32 i{0}; i < count; ++i) {
-        if (materials[i].generation == INVALID_ID) {
-            materials[i].generation = 0;
-            return materials[i];
-        }
-    }
-    // empty slot not found, do resizing
-    u32 free_slot = materials.count();
-    materials.resize_exponent(materials.count() + 1);
+MaterialHandle MaterialSystem::get_empty_slot() {
+    SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
 
-    Material::create_empty(free_slot, materials[free_slot]);
-    count = materials.count();
+    // slot is constructed in place with sf_mem_place, so the material starts from its member defaults
+    MaterialHandle handle = state_ptr->materials.emplace();
+    SF_ASSERT_MSG(!handle.is_null(), "Material slot map is exhausted");
+    return handle;
+}
 
-    for (u32 i{free_slot + 1}; i < count; ++i) {
-        Material::create_empty(i, materials[i]);
+void MaterialSystem::release_slot(MaterialHandle handle) {
+    SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
+    Material* material = state_ptr->materials.get(handle);
+    if (!material) {
+        return;
     }
-
-    return materials[free_slot];
+    material->destroy();
+    state_ptr->materials.erase(handle);
 }
 
 MaterialSystem::~MaterialSystem()
 {
-    for (auto& m : materials) {
+    materials.for_each([](Material& m, MaterialHandle) {
         m.destroy();
-    }
+    });
 }
 
+static AssetPath material_file_path(std::string_view file_name, StackAllocator& alloc);
 static bool material_parse_config(std::string_view file_name, MaterialConfig& out_config, StackAllocator& alloc);
+static bool material_parse_config_text(std::string_view config_text, MaterialConfig& out_config);
 static bool is_all_config_parsed(u8 parsed_state);
 
-Material& MaterialSystem::create_material_from_textures(
+MaterialHandle MaterialSystem::create_material_from_textures(
     const VulkanDevice& device,
     VulkanCommandBuffer& cmd_buffer,
     StackAllocator& alloc,
     std::span<TextureInputConfig> tex_configs
 ) {
-    Material& new_mat = MaterialSystem::get_empty_slot();
-    new_mat.texture_maps.resize(tex_configs.size());
-    TextureSystem::get_or_load_textures_many(device, cmd_buffer, alloc, tex_configs, new_mat.texture_maps.textures.to_span());
+    FixedArray<TextureHandle, VulkanShaderPipeline::TEXTURE_COUNT> textures(tex_configs.size());
+    TextureSystem::get_or_load_textures_many(device, cmd_buffer, alloc, tex_configs, textures.to_span());
+
+    std::lock_guard lock{ state_ptr->slot_mutex };
+    const MaterialHandle handle = MaterialSystem::get_empty_slot();
+    Material& new_mat = *MaterialSystem::get_material(handle);
+    new_mat.texture_maps.resize(textures.count());
+    for (u32 i{0}; i < textures.count(); ++i) {
+        new_mat.texture_maps.textures[i] = textures[i];
+    }
     u32 loaded_count = new_mat.texture_maps.count();
     
     if (loaded_count < VulkanShaderPipeline::TEXTURE_COUNT && loaded_count > 0) {
@@ -114,7 +113,7 @@ Material& MaterialSystem::create_material_from_textures(
         }
     }
 
-    return new_mat;
+    return handle;
 }
 
 void MaterialSystem::preload_material_from_file_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<std::string_view> file_names) {
@@ -128,93 +127,162 @@ void MaterialSystem::preload_material_from_config_many(const VulkanDevice& devic
     }
 }
 
-void MaterialSystem::load_and_get_material_from_file_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<std::string_view> file_names, std::span<Material*> out_materials) {
+void MaterialSystem::load_and_get_material_from_file_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<std::string_view> file_names, std::span<MaterialHandle> out_materials) {
     SF_ASSERT(file_names.size() == out_materials.size());
-    for (u32 i{0}; i < file_names.size(); ++i) {
-       out_materials[i] = MaterialSystem::load_and_get_material_from_file(file_names[i], device, cmd_buffer, alloc);
+    const u32 count = static_cast<u32>(file_names.size());
+    if (count == 0) {
+        return;
+    }
+
+    // buffers and requests are freed on return, after every read is waited for
+    AllocatorScope scope{ alloc };
+    AssetPath* paths = static_cast<AssetPath*>(alloc.allocate(count * sizeof(AssetPath), alignof(AssetPath)));
+    IoRequest** file_reads = static_cast<IoRequest**>(alloc.allocate(count * sizeof(IoRequest*), alignof(IoRequest*)));
+    IoRequest** reads = static_cast<IoRequest**>(alloc.allocate(count * sizeof(IoRequest*), alignof(IoRequest*)));
+    u32 read_count{0};
+
+    for (u32 i{0}; i < count; ++i) {
+        file_reads[i] = nullptr;
+        const char* path = sf_mem_place(&paths[i], material_file_path(file_names[i], alloc))->to_sv_not_null_terminated().data();
+        Option<u64> file_size = io_file_size(path);
+        if (file_size.is_none() || file_size.unwrap_copy() > std::numeric_limits<u32>::max()) {
+            continue;
+        }
+        const u32 size = static_cast<u32>(file_size.unwrap_copy());
+        void* buffer = alloc.allocate(size, alignof(u64));
+        void* request_memory = alloc.allocate(sizeof(IoRequest), alignof(IoRequest));
+        if (!buffer || !request_memory) {
+            continue;
+        }
+        file_reads[i] = sf_mem_place(static_cast<IoRequest*>(request_memory), path, buffer, size);
+        reads[read_count++] = file_reads[i];
+    }
+
+    // every file is queued at once, so later files are read while earlier materials parse and load their textures
+    io_submit_batch({ reads, read_count });
+
+    for (u32 i{0}; i < count; ++i) {
+        out_materials[i] = {};
+        IoRequest* read = file_reads[i];
+        if (!read || !read->wait() || read->bytes_read != read->size) {
+            LOG_ERROR("Material System: can't read file from path: {}", paths[i].to_sv_not_null_terminated());
+            continue;
+        }
+        MaterialConfig config;
+        if (material_parse_config_text({ static_cast<const char*>(read->buffer), read->size }, config)) {
+            out_materials[i] = MaterialSystem::load_and_get_material_from_config(std::move(config), device, cmd_buffer, alloc);
+        }
     }
 }
 
-void MaterialSystem::load_and_get_material_from_config_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<MaterialConfig> configs, std::span<Material*> out_materials) {
+void MaterialSystem::load_and_get_material_from_config_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc, std::span<MaterialConfig> configs, std::span<MaterialHandle> out_materials) {
     SF_ASSERT(configs.size() == out_materials.size());
     for (u32 i{0}; i < configs.size(); ++i) {
        out_materials[i] = MaterialSystem::load_and_get_material_from_config(std::move(configs[i]), device, cmd_buffer, alloc);
     }
 }
 
-Material* MaterialSystem::load_and_get_material_from_file(std::string_view file_name, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc) {
+MaterialHandle MaterialSystem::load_and_get_material_from_file(std::string_view file_name, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc) {
     MaterialConfig config;
     bool parse_res = material_parse_config(file_name, config, alloc);
     if (!parse_res) {
-        return nullptr;
+        return {};
     }
     return MaterialSystem::load_and_get_material_from_config(std::move(config), device, cmd_buffer, alloc);
 }
 
-Material* MaterialSystem::load_and_get_material_from_config(MaterialConfig&& config, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc) {
-    Option<MaterialRef*> maybe_existing_material_ref = state_ptr->material_lookup_table.get(config.name.to_string_view());
-    if (maybe_existing_material_ref.is_some()) {
-        MaterialRef* existing_material = maybe_existing_material_ref.unwrap_copy();
-        existing_material->ref_count++;
-        return &state_ptr->materials[existing_material->handle];
+MaterialHandle MaterialSystem::load_and_get_material_from_config(MaterialConfig&& config, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc) {
+    const StringId name = config.name;
+    ConcurrentPutResult<MaterialRef> entry = state_ptr->material_lookup_table.get_or_emplace(name);
+    if (!entry.value) {
+        return {};
     }
+    MaterialRef& material_ref{ *entry.value };
 
-    Material& new_mat = MaterialSystem::get_empty_slot();
-    new_mat.config.set_some(std::move(config));
-
-    TextureInputConfig texture_conf{ TextureSystem::acquire_default_texture_path(config.diffuse_texture_name.to_string_view(), alloc) };
-    new_mat.texture_maps.append(TextureMap{ TextureSystem::get_or_load_texture(device, cmd_buffer, std::move(texture_conf), alloc) });
+    switch (material_ref.state.acquire()) {
+        case ResourceAcquireResult::ACQUIRED: return material_ref.handle;
+        case ResourceAcquireResult::FAILED: return {};
+        case ResourceAcquireResult::SHOULD_LOAD: break;
+    }
 
-    MaterialRef ref{
-        .handle = new_mat.id,
-        .ref_count = 0,
-        .auto_release = config.auto_release,    
-    };
+    // this thread owns the load, others wait on the state
+    TextureInputConfig texture_conf{ TextureSystem::acquire_default_texture_path(string_id_to_sv(config.diffuse_texture_name), alloc) };
+    const TextureHandle diffuse_texture = TextureSystem::get_or_load_texture(device, cmd_buffer, std::move(texture_conf));
+    material_ref.auto_release = config.auto_release;
+    {
+        std::lock_guard lock{ state_ptr->slot_mutex };
+        material_ref.handle = MaterialSystem::get_empty_slot();
+        Material& new_mat = *MaterialSystem::get_material(material_ref.handle);
+        new_mat.config.set_some(std::move(config));
+        new_mat.texture_maps.append(TextureMap{ diffuse_texture });
+    }
 
-    state_ptr->material_lookup_table.put(new_mat.config.unwrap_ref().name.to_string_view(), ref);
-    return &new_mat;
+    material_ref.state.finish_load(true);
+    return material_ref.handle;
 }
 
 void MaterialSystem::free_material(std::string_view name_input) {
-    auto name = strip_extension_from_file_name(name_input);
+    const StringId name = string_id_find(strip_extension_from_file_name(name_input));
+    if (!name.is_valid()) {
+        LOG_WARN("Trying to delete non-existing material: {}", name_input);
+        return;
+    }
+    free_material(name);
+}
+
+void MaterialSystem::free_material(StringId name) {
     Option<MaterialRef*> maybe_material_ref = state_ptr->material_lookup_table.get(name);
     if (maybe_material_ref.is_none()) {
-        LOG_WARN("Trying to delete non-existing material: {}", name);
+        LOG_WARN("Trying to delete non-existing material: {}", string_id_to_sv(name));
         return;
     }
 
     MaterialRef* material_ref = maybe_material_ref.unwrap_copy();
-    Material& material = state_ptr->materials[maybe_material_ref.unwrap_copy()->handle];
-    material_ref->ref_count--;
-
-    if (material_ref->ref_count == 0 && material_ref->auto_release) {
-        material_ref->handle = INVALID_ID;
-        material.destroy();
-        state_ptr->material_lookup_table.remove(name);
+    switch (material_ref->state.release(material_ref->auto_release)) {
+        case ResourceReleaseResult::RELEASED: break;
+        case ResourceReleaseResult::SHOULD_DESTROY: {
+            {
+                std::lock_guard lock{ state_ptr->slot_mutex };
+                MaterialSystem::release_slot(material_ref->handle);
+            }
+            material_ref->state.finish_release();
+        } break;
+        case ResourceReleaseResult::NOT_HELD: {
+            LOG_WARN("Trying to delete material which is not held: {}", string_id_to_sv(name));
+        } break;
     }
 }
 
-static bool material_parse_config(std::string_view file_name, MaterialConfig& out_config, StackAllocator& alloc) {
+// null terminated
+static AssetPath material_file_path(std::string_view file_name, StackAllocator& alloc) {
 #ifdef SF_DEBUG
     std::string_view init_path = "build/debug/engine/assets/materials/";
 #else
     std::string_view init_path = "build/release/engine/assets/materials/";
 #endif
-    String<StackAllocator> material_path(init_path.size() + file_name.size() + 1, &alloc);
+    AssetPath material_path(init_path.size() + file_name.size() + 1, &alloc);
     material_path.append_sv(init_path);
     material_path.append_sv(file_name);
     material_path.append('\0');
+    return material_path;
+}
+
+static bool material_parse_config(std::string_view file_name, MaterialConfig& out_config, StackAllocator& alloc) {
+    // path is freed on return, file is unmapped with the view
+    AllocatorScope temp_scope{ alloc };
+    AssetPath material_path = material_file_path(file_name, alloc);
 
-    auto maybe_file_contents = read_file(material_path.to_sv_not_null_terminated(), application_get_temp_allocator());
-    if (maybe_file_contents.is_err()) {
+    MappedFile material_file;
+    if (!MappedFile::open(material_path.to_sv_not_null_terminated(), material_file)) {
         LOG_ERROR("Material System: can't read file from path: {}", material_path.to_sv_not_null_terminated());
         return false;
     }
+    return material_parse_config_text(material_file.to_sv(), out_config);
+}
 
-    String<StackAllocator> file_contents{ maybe_file_contents.unwrap_move() };    
-
+static bool material_parse_config_text(std::string_view config_text, MaterialConfig& out_config) {
     FixedString<MaterialConfig::MAX_STR_LEN> line_buff;
-    Parser<StackAllocator> parser{ file_contents };
+    Parser parser{ config_text };
     // bitwise
     u8 parsed_state{0};
 
@@ -248,10 +316,10 @@ static bool material_parse_config(std::string_view file_name, MaterialConfig& ou
 
         switch (prop_index) {
             case 0: {
-                out_config.name = line_buff.to_span();
+                out_config.name = string_intern(line_buff.to_string_view());
             } break;
             case 1: {
-                out_config.diffuse_texture_name = line_buff.to_string_view();
+                out_config.diffuse_texture_name = string_intern(line_buff.to_string_view());
             } break;
             case 2: {
                 glm::vec4 vec;
@@ -27,6 +27,10 @@ void GeometryView::create(
     out_view.vertex_offset = vertex_offset_;
 }
 
+void GeometryView::draw(VulkanCommandBuffer& cmd_buffer) {
+    vkCmdDrawIndexed(cmd_buffer.handle, indeces_count, 1, indeces_offset, vertex_offset, 0); 
+}
+
 void GeometryView::destroy() {
     indeces_count = INVALID_ID;
     indeces_offset = INVALID_ID;
@@ -38,17 +42,16 @@ void GeometryView::destroy() {
 void GeometrySystem::create(ArenaAllocator& main_allocator, StackAllocator& temp_allocator, GeometrySystem &out_state) {
     state_ptr = &out_state;
     out_state.alloc = &main_allocator;
-    out_state.geometry_views.set_allocator(&main_allocator);
     out_state.geometry_views.reserve(INIT_GEOMETRY_COUNT);
     out_state.indices.set_allocator(&main_allocator);
     out_state.indices.reserve(INIT_GEOMETRY_COUNT * AVG_INDEX_COUNT);
     out_state.vertices.set_allocator(&main_allocator);
     out_state.vertices.reserve(INIT_GEOMETRY_COUNT * AVG_VERTEX_COUNT);
 
-    GeometrySystem::create_geometry_and_get_view(GeometrySystem::define_cube_vertices(temp_allocator), GeometrySystem::define_cube_indices(temp_allocator));
+    out_state.default_geometry_view = GeometrySystem::create_geometry_and_get_view(GeometrySystem::define_cube_vertices(temp_allocator), GeometrySystem::define_cube_indices(temp_allocator));
 }
 
-GeometryView& GeometrySystem::create_geometry_and_get_view(
+GeometryViewHandle GeometrySystem::create_geometry_and_get_view(
     DynamicArray<Vertex, StackAllocator>&& vertices_input,
     DynamicArray<u32, StackAllocator>&& indices_input
 ) { 
@@ -78,9 +81,12 @@ GeometryView& GeometrySystem::create_geometry_and_get_view(
     // NOTE: THINK maybe should be in bytes, not elements?
     // GeometryView::create(index_offset * sizeof(u32), indices_input.count(), vert_offset * sizeof(Vertex), new_view);
     GeometryView::create(index_offset, indices_input.count(), vert_offset, new_view);
-    state_ptr->geometry_views.append(new_view);
+    return state_ptr->geometry_views.insert(new_view);
+}
 
-    return state_ptr->geometry_views.last();
+GeometryView* GeometrySystem::get_geometry_view(GeometryViewHandle handle) {
+    SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
+    return state_ptr->geometry_views.get(handle);
 }
 
 std::span<Vertex> GeometrySystem::get_vertices() {
@@ -93,9 +99,9 @@ std::span<Vertex::IndexType> GeometrySystem::get_indices() {
     return state_ptr->indices.to_span();
 }
 
-GeometryView& GeometrySystem::get_default_geometry_view() { 
-    SF_ASSERT_MSG(state_ptr && state_ptr->geometry_views.count() > 0, "Should have the default geometry view");
-    return state_ptr->geometry_views.first();
+GeometryViewHandle GeometrySystem::get_default_geometry_view() { 
+    SF_ASSERT_MSG(state_ptr && state_ptr->geometry_views.contains(state_ptr->default_geometry_view), "Should have the default geometry view");
+    return state_ptr->default_geometry_view;
 }
 
 // Mesh
@@ -107,8 +113,8 @@ void Mesh::create_empty(VulkanShaderPipeline& shader, const VulkanDevice& device
 void Mesh::create_from_existing_data(
     VulkanShaderPipeline& shader,
     const VulkanDevice& device,
-    GeometryView* geometry_view,
-    Material* material,
+    GeometryViewHandle geometry_view,
+    MaterialHandle material,
     Mesh& out_mesh
 ) {
     out_mesh.descriptor_state_index = shader.acquire_resouces(device);
@@ -116,38 +122,40 @@ void Mesh::create_from_existing_data(
     out_mesh.material = material;
 }
 
-void Mesh::set_geometry_view(GeometryView* input_geometry_view) {
-    SF_ASSERT_MSG(input_geometry_view, "Should be valid ptrs");
+void Mesh::set_geometry_view(GeometryViewHandle input_geometry_view) {
+    SF_ASSERT_MSG(!input_geometry_view.is_null(), "Should be valid handles");
     geometry_view = input_geometry_view;
 }
 
-void Mesh::set_material(Material* input_material) {
-    SF_ASSERT_MSG(input_material, "Should be valid ptrs");
+void Mesh::set_material(MaterialHandle input_material) {
+    SF_ASSERT_MSG(!input_material.is_null(), "Should be valid handles");
     material = input_material;
 }
 
 void Mesh::draw(VulkanCommandBuffer& cmd_buffer) {
-    vkCmdDrawIndexed(cmd_buffer.handle, geometry_view->indeces_count, 1, geometry_view->indeces_offset, geometry_view->vertex_offset, 0); 
+    if (GeometryView* view = GeometrySystem::get_geometry_view(geometry_view)) {
+        view->draw(cmd_buffer);
+    }
 }
 
 bool Mesh::has_geometry_view() const {
-    return geometry_view != nullptr;
+    return GeometrySystem::get_geometry_view(geometry_view) != nullptr;
 }
 
 bool Mesh::has_material() const {
-    return material != nullptr;    
+    return MaterialSystem::get_material(material) != nullptr;
 }
 
 bool Mesh::valid() const {
-    return geometry_view && material && descriptor_state_index != INVALID_ID;
+    return has_geometry_view() && has_material() && descriptor_state_index != INVALID_ID;
 }
 
 void Mesh::destroy() {
-    if (geometry_view) {
-        geometry_view->destroy();
+    if (GeometryView* view = GeometrySystem::get_geometry_view(geometry_view)) {
+        view->destroy();
     }
-    if (material) {
-        material->destroy();
+    if (Material* mat = MaterialSystem::get_material(material)) {
+        mat->destroy();
     }
 }
 
@@ -11,6 +11,7 @@
 #include "sf_core/constants.hpp"
 #include "sf_core/io.hpp"
 #include "sf_core/logger.hpp"
+#include "sf_core/mapped_file.hpp"
 #include "sf_vulkan/buffer.hpp"
 #include "sf_vulkan/command_buffer.hpp"
 #include "sf_vulkan/device.hpp"
@@ -45,7 +46,7 @@ bool VulkanShaderPipeline::create(
     const FixedArray<VkVertexInputAttributeDescription, MAX_ATTRIB_COUNT>& attrib_description_config,
     VkViewport                     viewport,
     VkRect2D                       scissors,
-    std::span<Texture*>            default_textures,
+    std::span<TextureHandle>       default_textures,
     VulkanShaderPipeline&          out_pipeline,
     StackAllocator&                alloc
 ) {
@@ -54,7 +55,7 @@ bool VulkanShaderPipeline::create(
 #else
     std::string_view init_path = "build/release/engine/shaders/";
 #endif
-    String<StackAllocator> shader_path(init_path.size() + shader_file_name.size() + 1, &alloc);
+    AssetPath shader_path(init_path.size() + shader_file_name.size() + 1, &alloc);
     shader_path.append_sv(init_path);
     shader_path.append_sv(shader_file_name);
     shader_path.append('\0');
@@ -283,15 +284,16 @@ void VulkanShaderPipeline::update_material(VulkanContext& context, VulkanCommand
     for (u32 i{0}; i < TEXTURE_COUNT; ++i) {
         // update diffuse
         TextureMap texture_map = render_data.material->texture_maps[i];
+        Texture* texture = TextureSystem::get_texture(texture_map.texture);
 
-        // if texture hasn't been loaded - use the default one
-        if (!texture_map.texture || texture_map.texture->generation == INVALID_ID) {
-            texture_map.texture = default_textures[default_texture_index]; 
+        // if texture was freed or hasn't been loaded - use the default one
+        if (!texture || texture->state != TextureState::UPLOADED_TO_GPU) {
+            texture = TextureSystem::get_texture(default_textures[default_texture_index]);
         }
 
         texture_binding_infos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        texture_binding_infos[i].imageView = texture_map.texture->image.view;
-        texture_binding_infos[i].sampler = texture_map.texture->sampler; 
+        texture_binding_infos[i].imageView = texture->image.view;
+        texture_binding_infos[i].sampler = texture->sampler; 
 
         VkWriteDescriptorSet descriptor_write{
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
@@ -324,8 +326,12 @@ void VulkanShaderPipeline::bind_object_descriptor_sets(VulkanCommandBuffer& cmd_
 }
 
 u32 VulkanShaderPipeline::acquire_resouces(const VulkanDevice& device) {
-    u32 object_descriptor_state_index = descriptor_state_index_counter;
-    ++descriptor_state_index_counter;
+    const u32 object_descriptor_state_index = object_state_occupancy.find_first_unset();
+    if (object_descriptor_state_index == INVALID_ID) {
+        LOG_ERROR("Max object count {} is reached", MAX_OBJECT_COUNT);
+        return INVALID_ID;
+    }
+    object_state_occupancy.set_bit(object_descriptor_state_index);
 
     ObjectShaderState& object_state{ object_shader_states[object_descriptor_state_index] };
 
@@ -361,6 +367,7 @@ void VulkanShaderPipeline::release_resouces(const VulkanDevice& device, u32 desc
             }
         }
     }
+    object_state_occupancy.unset_bit(descriptor_state_index);
 }
 
 bool VulkanShaderPipeline::handle_swap_default_texture(u8 code, void* sender, void* listener_inst, Option<EventContext> maybe_context) {
@@ -489,19 +496,17 @@ void VulkanDescriptorSetLayout::destroy(const VulkanDevice& device) {
     }
 }
 
-Result<VkShaderModule> create_shader_module(const VulkanDevice& device, String<StackAllocator>&& shader_file_path) {
-    Result<String<StackAllocator>> shader_file_contents = read_file(shader_file_path.to_sv(), application_get_temp_allocator());
-
-    if (shader_file_contents.is_err()) {
+Result<VkShaderModule> create_shader_module(const VulkanDevice& device, AssetPath&& shader_file_path) {
+    // mapping is page aligned, SPIR-V words can be passed to the driver in place
+    MappedFile shader_file;
+    if (!MappedFile::open(shader_file_path.to_sv(), shader_file)) {
         return {ResultError::VALUE};
     }
 
-    auto shader_file_contents_unwrapped{ shader_file_contents.unwrap_move() };
-
     VkShaderModuleCreateInfo create_info{
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-        .codeSize = shader_file_contents_unwrapped.count(),
-        .pCode = reinterpret_cast<u32*>(shader_file_contents_unwrapped.data()),
+        .codeSize = shader_file.bytes().size(),
+        .pCode = reinterpret_cast<const u32*>(shader_file.bytes().data()),
     };
 
     VkShaderModule shader_handle;
@@ -50,16 +50,28 @@ static constexpr u32 MAX_MODEL_COUNT{ 16 };
 static constexpr u32 DEFAULT_MESH_COUNT{ 0 };
 static std::string_view MAIN_SHADER_FILE_NAME{"shader.spv"};
 
+struct PreloadTextureName {
+    std::string_view file_name;
+    u64              name_hash;
+};
+
+// name is hashed at compile time, interning it at preload only copies the bytes
+static consteval PreloadTextureName preload_texture_name(std::string_view file_name) {
+    return { file_name, TextureSystem::hash_default_texture_name(file_name) };
+}
+
 // TODO: move to renderer struct
-static FixedArray<std::string_view, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_texture_file_names{
-    "grass.jpg", "liquid_1.jpg", "liquid_2.jpg", "metal.jpg", "painting.jpg", "rock_wall.jpg",
-    "soil.jpg", "water.jpg", "stones.jpg", "tree.jpg", "sand.jpg"
+static FixedArray<PreloadTextureName, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_texture_file_names{
+    preload_texture_name("grass.jpg"), preload_texture_name("liquid_1.jpg"), preload_texture_name("liquid_2.jpg"),
+    preload_texture_name("metal.jpg"), preload_texture_name("painting.jpg"), preload_texture_name("rock_wall.jpg"),
+    preload_texture_name("soil.jpg"), preload_texture_name("water.jpg"), preload_texture_name("stones.jpg"),
+    preload_texture_name("tree.jpg"), preload_texture_name("sand.jpg")
 };
 static FixedArray<TextureInputConfig, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_texture_configs;
 static FixedArray<std::string_view, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_material_configs{ MaterialSystem::DEFAULT_FILE_NAME };
 static FixedArray<std::string_view, 10> model_names{ /* { "box", "gltf" }, */ { "avocado.gltf" } };
-static FixedArray<Texture*, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_textures(preload_texture_file_names.count());
-static FixedArray<Material*, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_materials(preload_material_configs.count());
+static FixedArray<TextureHandle, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_textures(preload_texture_file_names.count());
+static FixedArray<MaterialHandle, VulkanShaderPipeline::MAX_DEFAULT_TEXTURES> preload_materials(preload_material_configs.count());
 static FixedArray<Model, MAX_MODEL_COUNT> models(model_names.count());
 
 bool create_instance(ApplicationConfig& config, PlatformState& platform_state);
@@ -259,14 +271,12 @@ bool renderer_draw_frame(const RenderPacket& packet) {
     }
     transfer_cmd_buffer.reset();
 
-    auto& meshes = vk_renderer.meshes;
-    const u32 MESH_CNT = meshes.count();
     static constexpr f32 STEP{ 0.8f };
 
     // NOTE: TEMP
     // shader.update_model(graphics_cmd_buffer, identity_mat);
 
-    for (u32 i{0}; i < MESH_CNT; ++i) {
+    vk_renderer.meshes.for_each([&](GeometryViewHandle geometry_view, MaterialHandle material, u32 descriptor_state_index, u32 i) {
         // update model matrix
         f32 mult_x = ((i & 0b1) == 0b1) ? -STEP : STEP;
         f32 mult_y = ((i & 0b1) == 0b0) ? -STEP : STEP;
@@ -279,12 +289,17 @@ bool renderer_draw_frame(const RenderPacket& packet) {
 
         // update material
         MaterialUpdateData material_data{};
-        material_data.descriptor_state_index = meshes[i].descriptor_state_index;
-        material_data.material = meshes[i].material;
+        material_data.descriptor_state_index = descriptor_state_index;
+        material_data.material = MaterialSystem::get_material(material);
+        if (!material_data.material) {
+            material_data.material = MaterialSystem::get_material(MaterialSystem::get_default_material());
+        }
         shader.update_material(vk_context, graphics_cmd_buffer, material_data);
 
-        meshes[i].draw(graphics_cmd_buffer);
-    }
+        if (GeometryView* view = GeometrySystem::get_geometry_view(geometry_view)) {
+            view->draw(graphics_cmd_buffer);
+        }
+    });
 
     graphics_cmd_buffer.end_rendering(vk_context);
     graphics_cmd_buffer.end_recording();
@@ -319,6 +334,7 @@ void renderer_end_frame(f64 delta_time) {
     vk_context.transfer_fences[vk_context.curr_frame].reset(vk_context);
     ++vk_renderer.frame_count;
     vk_context.curr_frame = (vk_context.curr_frame + 1) % VulkanSwapchain::MAX_FRAMES_IN_FLIGHT;
+    application_get_frame_allocator().end_frame();
 }
 
 void sf_vk_check(VkResult vk_result) {
@@ -697,6 +713,15 @@ static void renderer_update_global_state() {
     vk_renderer.camera.dirty = false;
 }
 
+// meshes and models live in statics of this file, but their memory belongs to the application's main allocator,
+// so it's handed back here while that allocator is still alive, not from static destructors at exit
+void renderer_shutdown() {
+    vk_renderer.meshes.free();
+    for (auto& model : models) {
+        model.meshes.free();
+    }
+}
+
 const VulkanDevice& renderer_get_device() {
     return vk_context.device;
 }
@@ -744,7 +769,10 @@ static void update_global_descriptors(const VulkanDevice& device) {
 static void preload_textures_and_materials(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& temp_alloc) {
     u32 cnt = preload_texture_file_names.count();
     for (u32 i{0}; i < cnt; ++i) {
-        preload_texture_configs.append(TextureInputConfig{ TextureSystem::acquire_default_texture_path(preload_texture_file_names[i], temp_alloc) });
+        const PreloadTextureName& preload_name = preload_texture_file_names[i];
+        AssetPath texture_path = TextureSystem::acquire_default_texture_path(preload_name.file_name, temp_alloc);
+        const StringId name = string_intern_hashed(TextureSystem::texture_name_from_path(texture_path.to_sv_not_null_terminated()), preload_name.name_hash);
+        preload_texture_configs.append(TextureInputConfig{ std::move(texture_path), TextureType::DIFFUSE, false, name });
     }
     TextureSystem::get_or_load_textures_many(device, cmd_buffer, temp_alloc, preload_texture_configs.to_span(), preload_textures.to_span());
     MaterialSystem::load_and_get_material_from_file_many(device, cmd_buffer, temp_alloc, preload_material_configs.to_span(), preload_materials.to_span());
@@ -753,18 +781,26 @@ static void preload_textures_and_materials(const VulkanDevice& device, VulkanCom
 static void renderer_create_default_meshes(const VulkanDevice& device, VulkanShaderPipeline& shader, VulkanCommandBuffer& cmd_buffer, StackAllocator& temp_alloc, u32 count) {
     SF_ASSERT_MSG(count > 0, "Should create at least 1 default mesh");
     
-    GeometryView& default_geometry = GeometrySystem::get_default_geometry_view();
+    const GeometryViewHandle default_geometry = GeometrySystem::get_default_geometry_view();
     MaterialSystem::create_default_material(device, cmd_buffer, temp_alloc);
-    Material& default_material = MaterialSystem::get_default_material();
+    const MaterialHandle default_material = MaterialSystem::get_default_material();
     for (u32 i = 0; i < count; ++i) {
         Mesh new_mesh;
         new_mesh.descriptor_state_index = shader.acquire_resouces(device);
-        Mesh::create_from_existing_data(shader, device, &default_geometry, &default_material, new_mesh);
-        vk_renderer.meshes.append(new_mesh);
+        Mesh::create_from_existing_data(shader, device, default_geometry, default_material, new_mesh);
+        if (vk_renderer.meshes.append(new_mesh.geometry_view, new_mesh.material, new_mesh.descriptor_state_index) == INVALID_ID) {
+            LOG_ERROR("Failed to add default mesh {}", i);
+            return;
+        }
     }
 }
 
 static void init_meshes(VulkanShaderPipeline& shader, const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, ArenaAllocator& main_alloc, StackAllocator& temp_alloc) {
+    vk_renderer.meshes.set_allocator(&main_alloc);
+    if (!vk_renderer.meshes.reserve(VulkanRenderer::MAX_MESH_COUNT)) {
+        LOG_ERROR("Failed to reserve space for {} meshes", VulkanRenderer::MAX_MESH_COUNT);
+    }
+
     if (DEFAULT_MESH_COUNT > 0) {
         renderer_create_default_meshes(vk_context.device, shader, vk_context.texture_load_command_buffer, temp_alloc, DEFAULT_MESH_COUNT);
     }
@@ -774,7 +810,10 @@ static void init_meshes(VulkanShaderPipeline& shader, const VulkanDevice& device
             LOG_ERROR("Model with name {} fails to load", model_names[i]);
         }
         for (auto& mesh : models[i].meshes) {
-            vk_renderer.meshes.append(mesh);
+            if (vk_renderer.meshes.append(mesh.geometry_view, mesh.material, mesh.descriptor_state_index) == INVALID_ID) {
+                LOG_ERROR("Failed to add mesh of model {}", model_names[i]);
+                break;
+            }
         }
     }
 
@@ -1,18 +1,26 @@
 #include "sf_vulkan/texture.hpp"
+#include "sf_allocators/allocator_scope.hpp"
 #include "sf_allocators/arena_allocator.hpp"
 #include "sf_allocators/stack_allocator.hpp"
 #include "sf_containers/dynamic_array.hpp"
-#include "sf_containers/hashmap.hpp"
+#include "sf_containers/concurrent_hashmap.hpp"
 #include "sf_containers/result.hpp"
+#include "sf_core/async_io.hpp"
 #include "sf_core/asserts_sf.hpp"
 #include "sf_core/logger.hpp"
 #include "sf_core/io.hpp"
+#include "sf_core/mapped_file.hpp"
+#include "sf_core/memory_sf.hpp"
+#include "sf_core/parallel.hpp"
+#include "sf_core/string_id.hpp"
 #include "sf_core/constants.hpp"
+#include "sf_platform/platform.hpp"
 #include "sf_vulkan/buffer.hpp"
 #include "sf_vulkan/command_buffer.hpp"
 #include "sf_vulkan/device.hpp"
 #include "sf_vulkan/image.hpp"
 #include "sf_vulkan/renderer.hpp"
+#include <limits>
 #include <string_view>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -24,9 +32,7 @@ namespace sf {
 
 static TextureSystem* state_ptr;
 
-void Texture::create_empty(u32 id, Texture& out_texture) {
-    out_texture.id = id;
-    out_texture.generation = INVALID_ID;
+void Texture::create_empty(Texture& out_texture) {
     out_texture.state = TextureState::NOT_LOADED;
 }
     
@@ -34,12 +40,11 @@ bool Texture::load(
     const VulkanDevice& device,
     VulkanCommandBuffer& cmd_buffer,
     TextureInputConfig&& config,
-    StackAllocator& alloc,
     Texture& out_texture
 )
 {
     if (out_texture.state == TextureState::NOT_LOADED) {
-        if (!out_texture.load_from_disk(std::move(config.texture_path), alloc)) {
+        if (!out_texture.load_from_disk(std::move(config.texture_path))) {
             return false;
         }
         if (!out_texture.upload_to_gpu(device, cmd_buffer)) {
@@ -51,36 +56,45 @@ bool Texture::load(
         }
     }
 
-    if (out_texture.generation == INVALID_ID) {
-        out_texture.generation = 0;
-    } else {
-        out_texture.generation++;
-    }
-
     return true;
 }
 
-bool Texture::load_from_disk(String<StackAllocator>&& texture_path, StackAllocator& alloc) {
+bool Texture::load_from_disk(AssetPath&& texture_path) {
     texture_path.ensure_null_terminated();
 
+    // decoder reads the mapping once front to back, no copy of the file is made
+    MappedFile texture_file;
+    if (!MappedFile::open(texture_path.to_sv_not_null_terminated(), texture_file)) {
+        LOG_WARN("Failed to read texture file {}", texture_path.to_sv_not_null_terminated());
+        return false;
+    }
+
+    return load_from_memory(texture_file.bytes(), texture_path.to_sv_not_null_terminated());
+}
+
+bool Texture::load_from_memory(std::span<const u8> file_data, std::string_view texture_path) {
     // detect format
-    std::string_view extension{ extract_extension_from_file_name(texture_path.to_sv_not_null_terminated()) };
+    std::string_view extension{ extract_extension_from_file_name(texture_path) };
     ImageFormat format = Texture::map_extension_to_format(extension).unwrap_or_default(ImageFormat::PNG);
 
     constexpr u32 REQUIRED_CHANNEL_COUNT{ 4 };
 
-    pixels = stbi_load(texture_path.data(), reinterpret_cast<i32*>(&width),
-        reinterpret_cast<i32*>(&height), reinterpret_cast<i32*>(&channel_count), REQUIRED_CHANNEL_COUNT);
+    i32 image_width{0};
+    i32 image_height{0};
+    i32 image_channel_count{0};
+    pixels = stbi_load_from_memory(file_data.data(), static_cast<i32>(file_data.size()), &image_width, &image_height, &image_channel_count, REQUIRED_CHANNEL_COUNT);
 
     if (!pixels) {
         if (stbi_failure_reason()) {
-            LOG_WARN("Load warning/error for texture {},\n\tmessage: {}", texture_path.to_sv_not_null_terminated(), stbi_failure_reason());
+            LOG_WARN("Load warning/error for texture {},\n\tmessage: {}", texture_path, stbi_failure_reason());
             stbi__err(0, 0);
         }
         return false;
     }
 
-    generation = 0;
+    width = static_cast<u32>(image_width);
+    height = static_cast<u32>(image_height);
+    channel_count = static_cast<u8>(image_channel_count);
     size = width * height * REQUIRED_CHANNEL_COUNT;
 
     // check for transparency for png images
@@ -200,149 +214,266 @@ void Texture::destroy(const VulkanDevice& device) {
     }
 
     state = TextureState::NOT_LOADED;
-    id = INVALID_ID;
-    generation = INVALID_ID;
 }
 
 // Texture System State
 
-void TextureSystem::create(ArenaAllocator& allocator, const VulkanDevice& device, TextureSystem& out_system) {
+void TextureSystem::create(const VulkanDevice& device, JobSystem& job_system, TextureSystem& out_system) {
     state_ptr = &out_system;
-    out_system.textures.set_allocator(&allocator);
-    out_system.textures.resize(MAX_TEXTURE_AMOUNT);
-    out_system.texture_lookup_table.set_allocator(&allocator);
-    out_system.texture_lookup_table.reserve(MAX_TEXTURE_AMOUNT);
+    out_system.job_system = &job_system;
+    // slot chunks and lookup tables grow as textures get loaded
+    out_system.textures.set_memory_tag(MemoryTag::TEXTURE);
+    out_system.lookup_allocator.set_memory_tag(MemoryTag::TEXTURE);
+    out_system.texture_lookup_table.create(INIT_TEXTURE_AMOUNT, &out_system.lookup_allocator);
     out_system.device = &device;
 
-    auto& textures = out_system.textures;
-    u32 cap = textures.capacity();
-
-    for (u32 i{0}; i < cap; ++i) {
-        Texture::create_empty(i, textures[i]);
-    }
-    for (auto& t : out_system.texture_lookup_table) {
-        t.value.handle = INVALID_ID;
-    }
-
     stbi_set_flip_vertically_on_load(true);
 }
 
 TextureSystem::~TextureSystem()
 {
     if (device) {
-        for (auto& t : textures) {
+        textures.for_each([this](Texture& t, TextureHandle) {
             t.destroy(*device);
-        }
+        });
     }
 }
 
-String<StackAllocator> TextureSystem::acquire_default_texture_path(std::string_view texture_file_name, StackAllocator& alloc) {
-    String<StackAllocator> texture_full_path(TEXTURE_ASSETS_PATH.size() + texture_file_name.size() + 1, &alloc);
+AssetPath TextureSystem::acquire_default_texture_path(std::string_view texture_file_name, StackAllocator& alloc) {
+    AssetPath texture_full_path(TEXTURE_ASSETS_PATH.size() + texture_file_name.size() + 1, &alloc);
     texture_full_path.append_sv(TEXTURE_ASSETS_PATH);
     texture_full_path.append_sv(texture_file_name);
     texture_full_path.ensure_null_terminated();
     return std::move(texture_full_path);
 }
 
-Texture& TextureSystem::get_empty_slot() {
+TextureHandle TextureSystem::get_empty_slot() {
     SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
-    
-    auto& textures{ state_ptr->textures };
-    u32 count{ textures.count() };
 
-    for (u32 i{0}; i < count; ++i) {
-        if (textures[i].generation == INVALID_ID) {
-            textures[i].generation = 0;
-            return textures[i];
-        }
-    }
+    TextureHandle handle = state_ptr->textures.emplace();
+    SF_ASSERT_MSG(!handle.is_null(), "Texture slot map is exhausted");
 
-    // empty slot not found, do resizing
-    u32 new_id = textures.count();
-    textures.resize_exponent(textures.count() + 1);
-    Texture::create_empty(new_id, textures[new_id]);
+    Texture::create_empty(*state_ptr->textures.get(handle));
+    return handle;
+}
 
-    count = textures.count();
-    
-    for (u32 i{new_id + 1}; i < count; ++i) {
-        Texture::create_empty(i, textures[i]);
+void TextureSystem::release_slot(TextureHandle handle) {
+    SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
+    Texture* texture = state_ptr->textures.get(handle);
+    if (!texture) {
+        return;
     }
+    texture->destroy(*state_ptr->device);
+    state_ptr->textures.erase(handle);
+}
 
-    return textures[new_id];
+Texture* TextureSystem::get_texture(TextureHandle handle) {
+    SF_ASSERT_MSG(state_ptr, "Should be valid ptr");
+    return state_ptr->textures.get(handle);
 }
 
-static bool load_texture_and_put_into_table(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureInputConfig&& config, StackAllocator& alloc) {
-    Texture& new_texture = TextureSystem::get_empty_slot();
-    if (!Texture::load(device, cmd_buffer, std::move(config), alloc, new_texture)) {
+static TextureHandle load_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureInputConfig&& config) {
+    std::lock_guard lock{ state_ptr->load_mutex };
+    const TextureHandle new_texture = TextureSystem::get_empty_slot();
+    if (!Texture::load(device, cmd_buffer, std::move(config), *TextureSystem::get_texture(new_texture))) {
         LOG_ERROR("Texture with name {} fails to load", config.texture_path.to_sv_not_null_terminated());
-        return false;
+        TextureSystem::release_slot(new_texture);
+        return {};
     }
+    return new_texture;
+}
 
-    std::string_view texture_name{ strip_part_from_start_and_extension(config.texture_path.to_sv_not_null_terminated(), TextureSystem::TEXTURE_FILE_PATH_TRIM_PART) };
-    u64 hash = hashfn_default<std::string_view>(texture_name);
+// moves an image decoded off the slot map into a new slot and uploads it
+static TextureHandle upload_decoded_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, const Texture& decoded) {
+    std::lock_guard lock{ state_ptr->load_mutex };
+    const TextureHandle new_texture = TextureSystem::get_empty_slot();
+    Texture& texture = *TextureSystem::get_texture(new_texture);
+    texture = decoded;
+    if (!texture.upload_to_gpu(device, cmd_buffer)) {
+        TextureSystem::release_slot(new_texture);
+        return {};
+    }
+    return new_texture;
+}
 
-    TextureRef texture_ref{
-        .handle = new_texture.id,
-        .ref_count = 0,
-        .auto_release = config.auto_release,
-    };
-    
-    state_ptr->texture_lookup_table.put_if_empty(hash, texture_ref);
-    return true;
+// failed entry stays in the table, next call for the name tries again
+static TextureHandle finish_texture_load(TextureRef& texture_ref, TextureHandle handle) {
+    texture_ref.handle = handle;
+    texture_ref.state.finish_load(!handle.is_null());
+    return handle;
 }
 
-Texture* TextureSystem::get_or_load_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureInputConfig&& config, StackAllocator& alloc) {
-    std::string_view texture_name{ strip_part_from_start_and_extension(config.texture_path.to_sv_not_null_terminated(), TextureSystem::TEXTURE_FILE_PATH_TRIM_PART) };
-    u64 hash = hashfn_default<std::string_view>(texture_name);
-    Option<TextureRef*> maybe_texture = state_ptr->texture_lookup_table.get(hash);
+// caller owns the load of 'texture_ref', others wait on its state
+static TextureHandle load_owned_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureRef& texture_ref, TextureInputConfig&& config) {
+    texture_ref.auto_release = config.auto_release;
+    return finish_texture_load(texture_ref, load_texture(device, cmd_buffer, std::move(config)));
+}
 
-    if (maybe_texture.is_none()) {
-        if (!load_texture_and_put_into_table(device, cmd_buffer, std::move(config), alloc)) {
-            return nullptr;
-        }
-        TextureRef* newly_created_texture_ref = state_ptr->texture_lookup_table.get(hash).unwrap_copy();
-        newly_created_texture_ref->ref_count++;
-        return &state_ptr->textures[newly_created_texture_ref->handle];
+TextureHandle TextureSystem::get_or_load_texture(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, TextureInputConfig&& config) {
+    const StringId name = config.name.is_valid() ? config.name : string_intern(texture_name_from_path(config.texture_path.to_sv_not_null_terminated()));
+    ConcurrentPutResult<TextureRef> entry = state_ptr->texture_lookup_table.get_or_emplace(name);
+    if (!entry.value) {
+        return {};
     }
+    TextureRef& texture_ref{ *entry.value };
 
-    TextureRef* texture_ref{ maybe_texture.unwrap_copy() };
-    texture_ref->ref_count++;
-    return &state_ptr->textures[texture_ref->handle];
+    switch (texture_ref.state.acquire()) {
+        case ResourceAcquireResult::ACQUIRED: return texture_ref.handle;
+        case ResourceAcquireResult::SHOULD_LOAD: return load_owned_texture(device, cmd_buffer, texture_ref, std::move(config));
+        case ResourceAcquireResult::FAILED: return {};
+    }
+    return {};
 }
 
-void TextureSystem::get_or_load_textures_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc,  std::span<TextureInputConfig> configs, std::span<Texture*> out_textures) {
+// Entries this call claims are owned by it: their files are read through async I/O in one batch
+// and decoded on the job system into local textures as the reads complete,
+// slot map isn't touched by workers, so a texture freed on another thread can't move them.
+// Uploads stay on the calling thread, it owns 'cmd_buffer'. Entries loaded by other threads are waited for at the end,
+// so a name repeated within the batch doesn't wait for itself.
+void TextureSystem::get_or_load_textures_many(const VulkanDevice& device, VulkanCommandBuffer& cmd_buffer, StackAllocator& alloc,  std::span<TextureInputConfig> configs, std::span<TextureHandle> out_textures) {
 #ifdef SF_DEBUG
     if (configs.size() > out_textures.size()) {
         LOG_WARN("Texture configs array has more items than can fit into out_textures array: {} - {}", configs.size(), out_textures.size());
     }
 #endif
 
+    struct PendingTexture {
+        TextureRef* ref;
+        StringId    name;
+        Texture     texture;
+        IoRequest*  read;
+        bool        is_owned;
+        bool        is_decoded;
+    };
+
     const u32 min_len = std::min(configs.size(), out_textures.size());
-    
+    if (min_len == 0) {
+        return;
+    }
+
+    AllocatorScope scope{ alloc };
+    PendingTexture* pending = static_cast<PendingTexture*>(alloc.allocate(min_len * sizeof(PendingTexture), alignof(PendingTexture)));
+    u32* decode_indices = static_cast<u32*>(alloc.allocate(min_len * sizeof(u32), alignof(u32)));
+    IoRequest** reads = static_cast<IoRequest**>(alloc.allocate(min_len * sizeof(IoRequest*), alignof(IoRequest*)));
+    u32 decode_count{0};
+    u32 read_count{0};
+
+    for (u32 i{0}; i < min_len; ++i) {
+        TextureInputConfig& config = configs[i];
+        const StringId name = config.name.is_valid() ? config.name : string_intern(texture_name_from_path(config.texture_path.to_sv_not_null_terminated()));
+        ConcurrentPutResult<TextureRef> entry = state_ptr->texture_lookup_table.get_or_emplace(name);
+        const bool is_owned = entry.value && entry.value->state.try_claim_load();
+        PendingTexture& item = *sf_mem_place(&pending[i], PendingTexture{ entry.value, name, Texture{}, nullptr, is_owned, false });
+        if (is_owned) {
+            entry.value->auto_release = config.auto_release;
+            // may grow the path through the caller's allocator, so not on a worker
+            config.texture_path.ensure_null_terminated();
+            Texture::create_empty(item.texture);
+            decode_indices[decode_count++] = i;
+
+            const char* path = config.texture_path.to_sv_not_null_terminated().data();
+            Option<u64> file_size = io_file_size(path);
+            if (file_size.is_none()) {
+                LOG_WARN("Failed to read texture file {}", config.texture_path.to_sv_not_null_terminated());
+                continue;
+            }
+            // read size is 32-bit, bigger files would be cut short
+            if (file_size.unwrap_copy() > std::numeric_limits<u32>::max()) {
+                LOG_ERROR("Texture file {} is too big: {} bytes", config.texture_path.to_sv_not_null_terminated(), file_size.unwrap_copy());
+                continue;
+            }
+            const u32 size = static_cast<u32>(file_size.unwrap_copy());
+            void* buffer = alloc.allocate(size, alignof(u64));
+            void* request_memory = alloc.allocate(sizeof(IoRequest), alignof(IoRequest));
+            if (!buffer || !request_memory) {
+                LOG_ERROR("Failed to allocate {} bytes to read texture file {}", size, config.texture_path.to_sv_not_null_terminated());
+                continue;
+            }
+            item.read = sf_mem_place(static_cast<IoRequest*>(request_memory), path, buffer, size);
+            reads[read_count++] = item.read;
+        }
+    }
+
+    // every file is queued at once, decoding of a texture starts as soon as its own read completes
+    io_submit_batch({ reads, read_count });
+
+    const f64 decode_start_time = platform_get_abs_time();
+    parallel_for(*state_ptr->job_system, decode_count, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i) {
+            const u32 index = decode_indices[i];
+            PendingTexture& item = pending[index];
+            if (item.read && item.read->wait() && item.read->bytes_read == item.read->size) {
+                item.is_decoded = item.texture.load_from_memory({ static_cast<const u8*>(item.read->buffer), item.read->size }, configs[index].texture_path.to_sv_not_null_terminated());
+            }
+            if (!item.is_decoded) {
+                LOG_ERROR("Texture with name {} fails to load", string_id_to_sv(item.name));
+            }
+        }
+    }, 1);
+    if (decode_count > 0) {
+        LOG_INFO("TextureSystem: decoded {} textures in {} ms on {} workers", decode_count, (platform_get_abs_time() - decode_start_time) * 1000.0, state_ptr->job_system->worker_count());
+    }
+
+    for (u32 i{0}; i < decode_count; ++i) {
+        const u32 index = decode_indices[i];
+        PendingTexture& item = pending[index];
+        const TextureHandle handle = item.is_decoded ? upload_decoded_texture(device, cmd_buffer, item.texture) : TextureHandle{};
+        out_textures[index] = finish_texture_load(*item.ref, handle);
+    }
+
     for (u32 i{0}; i < min_len; ++i) {
-        out_textures[i] = TextureSystem::get_or_load_texture(device, cmd_buffer, std::move(configs[i]), alloc);
+        PendingTexture& item = pending[i];
+        if (item.is_owned) {
+            continue;
+        }
+        out_textures[i] = {};
+        if (!item.ref) {
+            continue;
+        }
+        switch (item.ref->state.acquire()) {
+            case ResourceAcquireResult::ACQUIRED: {
+                out_textures[i] = item.ref->handle;
+            } break;
+            // entry failed or was released since phase 1
+            case ResourceAcquireResult::SHOULD_LOAD: {
+                out_textures[i] = load_owned_texture(device, cmd_buffer, *item.ref, std::move(configs[i]));
+            } break;
+            case ResourceAcquireResult::FAILED: break;
+        }
     }
 }
 
-// only frees the texture if ref_count was 1
+// frees an auto released texture when its last reference is dropped
 void TextureSystem::free_texture(const VulkanDevice& device, std::string_view file_name) {
-    std::string_view texture_name{ strip_part_from_start_and_extension(file_name, TextureSystem::TEXTURE_FILE_PATH_TRIM_PART) };
-    u64 hash = hashfn_default<std::string_view>(texture_name);
-    Option<TextureRef*> maybe_texture = state_ptr->texture_lookup_table.get(hash);
+    const StringId name = string_id_find(texture_name_from_path(file_name));
+    if (!name.is_valid()) {
+        LOG_WARN("Trying to delete texture that does not exist: {}", file_name);
+        return;
+    }
+    free_texture(device, name);
+}
+
+void TextureSystem::free_texture(const VulkanDevice& device, StringId name) {
+    Option<TextureRef*> maybe_texture = state_ptr->texture_lookup_table.get(name);
 
     if (maybe_texture.is_none()) {
-        LOG_WARN("Trying to delete texture that does not exist: {}", texture_name);
+        LOG_WARN("Trying to delete texture that does not exist: {}", string_id_to_sv(name));
         return;
     }
 
     TextureRef* texture_ref{ maybe_texture.unwrap_copy() };
-    Texture& texture{ state_ptr->textures[texture_ref->handle] };
-    texture_ref->ref_count--;
-
-    if (texture_ref->ref_count == 0 && texture_ref->auto_release) {
-        texture_ref->handle = INVALID_ID;
-        texture.destroy(device); 
-        state_ptr->texture_lookup_table.remove(hash);
+    switch (texture_ref->state.release(texture_ref->auto_release)) {
+        case ResourceReleaseResult::RELEASED: break;
+        case ResourceReleaseResult::SHOULD_DESTROY: {
+            {
+                std::lock_guard lock{ state_ptr->load_mutex };
+                TextureSystem::release_slot(texture_ref->handle);
+            }
+            texture_ref->state.finish_release();
+        } break;
+        case ResourceReleaseResult::NOT_HELD: {
+            LOG_WARN("Trying to delete texture which is not held: {}", string_id_to_sv(name));
+        } break;
     }
 }
 